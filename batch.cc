@@ -0,0 +1,316 @@
+#include "batch.h"
+
+#include <QCommandLineParser>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QLockFile>
+#include <QStack>
+#include <QtConcurrent>
+
+#include "component/constvalue.h"
+#include "component/stringinitializer.h"
+#include "database/mainwindowsqlite.h"
+#include "database/sqlite/sqlitefinance.h"
+#include "database/sqlite/sqliteproduct.h"
+#include "database/sqlite/sqlitestakeholder.h"
+#include "database/sqlite/sqlitetask.h"
+#include "document.h"
+#include "global/sqlconnection.h"
+#include "mainwindowutils.h"
+#include "tree/model/treemodelfinance.h"
+#include "tree/model/treemodelproduct.h"
+#include "tree/model/treemodelstakeholder.h"
+#include "tree/model/treemodeltask.h"
+
+bool Batch::Requested(int argc, char* argv[])
+{
+    for (int i = 1; i != argc; ++i)
+        if (qstrcmp(argv[i], "--batch") == 0)
+            return true;
+
+    return false;
+}
+
+Batch::Batch(CStringList& arguments)
+    : arguments_ { arguments }
+{
+}
+
+int Batch::Run()
+{
+    if (!ParseArguments())
+        return kExitUsage;
+
+    const QFileInfo file_info(file_path_);
+    if (!MainWindowUtils::IsValidFile(file_info)) {
+        qCritical() << "Batch: invalid file" << file_path_;
+        return kExitOpenFailed;
+    }
+
+    // Same lock as the GUI, a batch never writes under an open window
+    QLockFile lock_file(file_info.dir().filePath(file_info.completeBaseName() + kSuffixLOCK));
+    if (!lock_file.tryLock(100)) {
+        qCritical() << "Batch: file is locked by another instance" << file_path_;
+        return kExitOpenFailed;
+    }
+
+    try {
+        SqlConnection::Instance().SetDatabaseName(file_path_);
+    } catch (const std::exception& e) {
+        qCritical() << "Batch:" << e.what();
+        return kExitOpenFailed;
+    }
+
+    MainwindowSqlite sql(Section::kFinance);
+    sql.CreateIndex();
+    sql.MigrateDocument();
+
+    if (migrate_lineage_) {
+        if (!sql.MigrateLineage()) {
+            qCritical() << "Batch: lineage migration failed" << file_path_;
+            return kExitJobFailed;
+        }
+
+        qInfo() << "Batch: hierarchy stored as lineage" << file_path_;
+
+        if (!recompute_ && export_path_.isEmpty())
+            return kExitOk;
+    }
+
+    SetInfo();
+    for (Section section : std::as_const(section_list_))
+        sql.QuerySettings(settings_array_[std::to_underlying(section)], section);
+
+    // Finance's connection was opened by SetDatabaseName on this thread, so finance stays here and the other sections go to the pool
+    QList<QFuture<SectionResult>> future_list {};
+    bool run_finance {};
+
+    for (Section section : std::as_const(section_list_)) {
+        if (section == Section::kFinance)
+            run_finance = true;
+        else
+            future_list.emplaceBack(QtConcurrent::run([this, section]() { return RunSection(section); }));
+    }
+
+    QList<SectionResult> result_list {};
+    if (run_finance)
+        result_list.emplaceBack(RunSection(Section::kFinance));
+
+    for (auto& future : future_list)
+        result_list.emplaceBack(future.result());
+
+    bool ok { true };
+    for (const auto& result : std::as_const(result_list)) {
+        const auto& node { info_array_[std::to_underlying(result.section)].node };
+
+        if (!result.ok) {
+            qCritical() << "Batch:" << node << "failed";
+            ok = false;
+            continue;
+        }
+
+        if (recompute_)
+            qInfo() << "Batch:" << node << result.changed << "leaf totals rewritten";
+    }
+
+    if (ok && !export_path_.isEmpty() && !WriteXlsx(result_list)) {
+        qCritical() << "Batch: failed to write" << export_path_;
+        ok = false;
+    }
+
+    return ok ? kExitOk : kExitJobFailed;
+}
+
+bool Batch::ParseArguments()
+{
+    QCommandLineParser parser {};
+    parser.setApplicationDescription(QStringLiteral("YTX headless batch mode"));
+    parser.addHelpOption();
+
+    const QCommandLineOption batch_option(QStringLiteral("batch"), QStringLiteral("Open <file> without a window."), QStringLiteral("file"));
+    const QCommandLineOption recompute_option(QStringLiteral("recompute-totals"), QStringLiteral("Rewrite finance, product and task leaf totals from their trans."));
+    const QCommandLineOption export_option(QStringLiteral("export-xlsx"), QStringLiteral("Export the section trees to <path>."), QStringLiteral("path"));
+    const QCommandLineOption migrate_lineage_option(QStringLiteral("migrate-lineage"),
+        QStringLiteral("Convert every closure table into parent and lineage columns, subtree moves become one range update."));
+    const QCommandLineOption section_option(QStringLiteral("section"),
+        QStringLiteral("Limit the jobs to finance, product, task or stakeholder, may be repeated, all four by default."), QStringLiteral("name"));
+
+    parser.addOptions({ batch_option, recompute_option, export_option, migrate_lineage_option, section_option });
+
+    if (!parser.parse(arguments_)) {
+        qCritical().noquote() << parser.errorText();
+        return false;
+    }
+
+    file_path_ = parser.value(batch_option);
+    recompute_ = parser.isSet(recompute_option);
+    export_path_ = parser.value(export_option);
+    migrate_lineage_ = parser.isSet(migrate_lineage_option);
+
+    if (file_path_.isEmpty() || (!recompute_ && export_path_.isEmpty() && !migrate_lineage_)) {
+        qCritical().noquote() << parser.helpText();
+        return false;
+    }
+
+    if (!export_path_.isEmpty() && !export_path_.endsWith(".xlsx", Qt::CaseInsensitive))
+        export_path_ += ".xlsx";
+
+    const QHash<QString, Section> section_hash { { kFinance, Section::kFinance }, { kProduct, Section::kProduct }, { kTask, Section::kTask },
+        { kStakeholder, Section::kStakeholder } };
+
+    const auto name_list { parser.values(section_option) };
+    if (name_list.isEmpty()) {
+        section_list_ = { Section::kFinance, Section::kProduct, Section::kTask, Section::kStakeholder };
+        return true;
+    }
+
+    for (const auto& name : name_list) {
+        auto it { section_hash.constFind(name.toLower()) };
+        if (it == section_hash.constEnd()) {
+            qCritical() << "Batch: unknown section" << name;
+            return false;
+        }
+
+        if (!section_list_.contains(it.value()))
+            section_list_.emplaceBack(it.value());
+    }
+
+    return true;
+}
+
+void Batch::SetInfo()
+{
+    auto& finance { info_array_[std::to_underlying(Section::kFinance)] };
+    auto& product { info_array_[std::to_underlying(Section::kProduct)] };
+    auto& task { info_array_[std::to_underlying(Section::kTask)] };
+    auto& stakeholder { info_array_[std::to_underlying(Section::kStakeholder)] };
+    auto& sales { info_array_[std::to_underlying(Section::kSales)] };
+    auto& purchase { info_array_[std::to_underlying(Section::kPurchase)] };
+
+    finance = Info { .section = Section::kFinance, .node = kFinance, .path = kFinancePath, .transaction = kFinanceTransaction };
+    product = Info { .section = Section::kProduct, .node = kProduct, .path = kProductPath, .transaction = kProductTransaction };
+    task = Info { .section = Section::kTask, .node = kTask, .path = kTaskPath, .transaction = kTaskTransaction };
+    stakeholder = Info { .section = Section::kStakeholder, .node = kStakeholder, .path = kStakeholderPath, .transaction = kStakeholderTransaction };
+    sales = Info { .section = Section::kSales, .node = kSales, .path = kSalesPath, .transaction = kSalesTransaction };
+    purchase = Info { .section = Section::kPurchase, .node = kPurchase, .path = kPurchasePath, .transaction = kPurchaseTransaction };
+
+    StringInitializer::SetHeader(finance, product, stakeholder, task, sales, purchase);
+}
+
+Batch::SectionResult Batch::RunSection(Section section) const
+{
+    SectionResult result { .section = section };
+    CInfo& info { info_array_[std::to_underlying(section)] };
+
+    // The section's connection is allocated by this thread and only used here
+    auto sql { CreateSqlite(info) };
+
+    if (recompute_ && section != Section::kStakeholder)
+        result.ok = sql->RecomputeLeafTotalFPT(result.changed);
+
+    if (result.ok && !export_path_.isEmpty()) {
+        // Built after the recompute, so branch totals roll up from the rewritten leaves
+        auto model { CreateTreeModel(sql.get(), info) };
+        ReadTree(result.row_list, model.get());
+    }
+
+    return result;
+}
+
+std::unique_ptr<Sqlite> Batch::CreateSqlite(CInfo& info) const
+{
+    switch (info.section) {
+    case Section::kFinance:
+        return std::make_unique<SqliteFinance>(info);
+    case Section::kProduct:
+        return std::make_unique<SqliteProduct>(info);
+    case Section::kTask:
+        return std::make_unique<SqliteTask>(info);
+    case Section::kStakeholder:
+        return std::make_unique<SqliteStakeholder>(info);
+    default:
+        return nullptr;
+    }
+}
+
+std::unique_ptr<TreeModel> Batch::CreateTreeModel(Sqlite* sql, CInfo& info) const
+{
+    const int default_unit { settings_array_[std::to_underlying(info.section)].default_unit };
+    const QString separator { kDash };
+
+    switch (info.section) {
+    case Section::kFinance:
+        return std::make_unique<TreeModelFinance>(sql, info, default_unit, table_hash_, separator);
+    case Section::kProduct:
+        return std::make_unique<TreeModelProduct>(sql, info, default_unit, table_hash_, separator);
+    case Section::kTask:
+        return std::make_unique<TreeModelTask>(sql, info, default_unit, table_hash_, separator);
+    case Section::kStakeholder:
+        return std::make_unique<TreeModelStakeholder>(sql, info, default_unit, table_hash_, separator);
+    default:
+        return nullptr;
+    }
+}
+
+void Batch::ReadTree(QList<QVariantList>& row_list, const TreeModel* model) const
+{
+    const int column_count { model->columnCount() };
+    const int id_column { std::to_underlying(TreeEnum::kID) };
+
+    QVariantList header {};
+    for (int column = 0; column != column_count; ++column)
+        header.emplaceBack(model->headerData(column, Qt::Horizontal));
+
+    header[0] = QObject::tr("Path");
+    row_list.emplaceBack(header);
+
+    QStack<QModelIndex> stack {};
+    stack.push(QModelIndex());
+
+    while (!stack.isEmpty()) {
+        const auto index { stack.pop() };
+
+        // Children are pushed in reverse so rows come out in tree order
+        for (int row = model->rowCount(index) - 1; row >= 0; --row)
+            stack.push(model->index(row, 0, index));
+
+        if (!index.isValid())
+            continue;
+
+        QVariantList value_list {};
+        for (int column = 0; column != column_count; ++column)
+            value_list.emplaceBack(index.siblingAtColumn(column).data());
+
+        value_list[0] = model->GetPath(index.siblingAtColumn(id_column).data().toInt());
+        row_list.emplaceBack(value_list);
+    }
+}
+
+bool Batch::WriteXlsx(const QList<SectionResult>& result_list) const
+{
+    if (QFile::exists(export_path_))
+        QFile::remove(export_path_);
+
+    yxlsx::Document document(export_path_, nullptr);
+    auto worksheet { document.GetWorkbook()->GetCurrentWorksheet() };
+
+    // One block per section, separated by a blank row
+    int row { 1 };
+    for (const auto& result : result_list) {
+        worksheet->Write(row, 1, info_array_[std::to_underlying(result.section)].node);
+        ++row;
+
+        for (const auto& value_list : result.row_list) {
+            for (int column = 0; column != value_list.size(); ++column)
+                worksheet->Write(row, column + 1, value_list.at(column));
+
+            ++row;
+        }
+
+        ++row;
+    }
+
+    document.Save();
+    return QFile::exists(export_path_);
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <QVariantList>
+#include <array>
+#include <memory>
+
+#include "component/info.h"
+#include "component/settings.h"
+#include "database/sqlite/sqlite.h"
+#include "tree/model/treemodel.h"
+
+// Headless entry point, e.g. YTX --batch <file> --recompute-totals --export-xlsx <path> [--section <name>]...
+// or YTX --batch <file> --migrate-lineage, a one-way conversion of the node hierarchy storage
+// Runs on a QCoreApplication, each section works on its own thread and connection, the outcome is the process exit code
+class Batch {
+public:
+    static constexpr int kExitOk { 0 };
+    static constexpr int kExitUsage { 1 };
+    static constexpr int kExitOpenFailed { 2 };
+    static constexpr int kExitJobFailed { 3 };
+
+    static bool Requested(int argc, char* argv[]);
+
+    explicit Batch(CStringList& arguments);
+    int Run();
+
+private:
+    struct SectionResult {
+        Section section {};
+        bool ok { true };
+        int changed {};
+        QList<QVariantList> row_list {};
+    };
+
+    bool ParseArguments();
+    void SetInfo();
+
+    // runs on the thread that owns the section's connection
+    SectionResult RunSection(Section section) const;
+    std::unique_ptr<Sqlite> CreateSqlite(CInfo& info) const;
+    std::unique_ptr<TreeModel> CreateTreeModel(Sqlite* sql, CInfo& info) const;
+    void ReadTree(QList<QVariantList>& row_list, const TreeModel* model) const;
+    bool WriteXlsx(const QList<SectionResult>& result_list) const;
+
+private:
+    QStringList arguments_ {};
+    QString file_path_ {};
+    QString export_path_ {};
+    bool recompute_ {};
+    bool migrate_lineage_ {};
+    QList<Section> section_list_ {};
+
+    std::array<Info, 6> info_array_ {};
+    std::array<Settings, 6> settings_array_ {};
+    const TableHash table_hash_ {}; // no table is opened headless, tree models only look it up
+};
+
+#endif // BATCH_H
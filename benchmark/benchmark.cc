@@ -0,0 +1,326 @@
+#include "benchmark.h"
+
+#include <QFileInfo>
+#include <QRandomGenerator>
+#include <QSettings>
+#include <QTest>
+#include <QtConcurrent>
+
+#include "component/enumclass.h"
+#include "database/sqlite/sqlite.h"
+#include "global/resourcepool.h"
+#include "global/tracer.h"
+#include "table/model/tablecolumn.h"
+#include "table/model/tablemodelutils.h"
+#include "tree/model/treemodelutils.h"
+
+void Benchmark::initTestCase()
+{
+    Tracer::Instance().StartFromEnvironment();
+    record_ = qEnvironmentVariableIsSet("YTX_BENCH_RECORD");
+
+    if (record_)
+        return;
+
+    // an unrecorded machine fails here instead of passing every kernel unchecked
+    if (!QFileInfo::exists(QStringLiteral(YTX_BENCH_BASELINE)))
+        QFAIL(qPrintable(QStringLiteral("no baseline at %1, run YTX_BENCH_RECORD=1 ytx_bench once to record it").arg(QStringLiteral(YTX_BENCH_BASELINE))));
+
+    QSettings baseline(QStringLiteral(YTX_BENCH_BASELINE), QSettings::IniFormat);
+    const auto key_list { baseline.allKeys() };
+
+    for (const auto& key : key_list)
+        baseline_.insert(key, baseline.value(key).toDouble());
+}
+
+void Benchmark::cleanupTestCase()
+{
+    Tracer::Instance().Finish();
+
+    if (!record_)
+        return;
+
+    QSettings baseline(QStringLiteral(YTX_BENCH_BASELINE), QSettings::IniFormat);
+    baseline.clear();
+
+    for (auto it = baseline_.cbegin(); it != baseline_.cend(); ++it)
+        baseline.setValue(it.key(), it.value());
+}
+
+void Benchmark::SizeData() const
+{
+    QTest::addColumn<int>("size");
+
+    QTest::newRow("1k") << 1000;
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+
+    if (qEnvironmentVariableIsSet("YTX_BENCH_LARGE"))
+        QTest::newRow("1m") << 1000000;
+}
+
+Benchmark::TreeFixture Benchmark::BuildTree(qsizetype size) const
+{
+    // fixed seed, so two runs time the same shape
+    QRandomGenerator generator { 42 };
+    TreeFixture fixture {};
+
+    TreeModelUtils::InitializeRoot(fixture.root, 0);
+    fixture.node_list.reserve(size);
+
+    for (qsizetype index = 0; index != size; ++index) {
+        auto* node { ResourcePool<Node>::Instance().Allocate() };
+        node->id = index + 1;
+        node->name = QString::number(generator.bounded(int(size) * 10));
+        node->rule = generator.bounded(2) == 1;
+        node->type = kTypeLeaf;
+
+        // breadth first, kFanOut children under each parent, the first kFanOut under root
+        auto* parent { index < kFanOut ? fixture.root : fixture.node_list.at(index / kFanOut - 1) };
+        parent->type = kTypeBranch;
+        parent->children.emplaceBack(node);
+        node->parent = parent;
+
+        fixture.node_list.emplaceBack(node);
+    }
+
+    for (auto* node : std::as_const(fixture.node_list))
+        if (node->type == kTypeLeaf)
+            fixture.leaf_list.emplaceBack(node);
+
+    return fixture;
+}
+
+void Benchmark::ReleaseTree(TreeFixture& fixture) const
+{
+    ResourcePool<Node>::Instance().Recycle(fixture.node_list);
+    ResourcePool<Node>::Instance().Recycle(fixture.root);
+    fixture.root = nullptr;
+    fixture.leaf_list.clear();
+}
+
+Benchmark::LedgerFixture Benchmark::BuildLedger(qsizetype size) const
+{
+    QRandomGenerator generator { 42 };
+    LedgerFixture fixture {};
+
+    fixture.trans_list.reserve(size);
+    fixture.trans_shadow_list.reserve(size);
+
+    for (qsizetype index = 0; index != size; ++index) {
+        auto* trans { ResourcePool<Trans>::Instance().Allocate() };
+        trans->id = index + 1;
+        trans->lhs_node = 1;
+        trans->rhs_node = 2;
+        trans->lhs_debit = generator.bounded(1000.0);
+        trans->rhs_credit = trans->lhs_debit;
+
+        auto* trans_shadow { ResourcePool<TransShadow>::Instance().Allocate() };
+        Sqlite::ConvertTrans(trans, trans_shadow, true);
+
+        fixture.trans_list.emplaceBack(trans);
+        fixture.trans_shadow_list.emplaceBack(trans_shadow);
+    }
+
+    return fixture;
+}
+
+void Benchmark::ReleaseLedger(LedgerFixture& fixture) const
+{
+    ResourcePool<TransShadow>::Instance().Recycle(fixture.trans_shadow_list);
+    ResourcePool<Trans>::Instance().Recycle(fixture.trans_list);
+}
+
+void Benchmark::SortIterative_data() { SizeData(); }
+
+void Benchmark::SortIterative()
+{
+    QFETCH(int, size);
+
+    auto fixture { BuildTree(size) };
+    bool ascending {};
+
+    // the direction flips every run, so each sort starts from the reverse order
+    auto Prepare = [&ascending]() { ascending = !ascending; };
+    auto Kernel = [&]() {
+        TreeModelUtils::SortIterative(fixture.root, [ascending](const Node* lhs, const Node* rhs) { return ascending ? lhs->name < rhs->name : lhs->name > rhs->name; });
+    };
+
+    Measure("SortIterative", size, Prepare, Kernel);
+    ReleaseTree(fixture);
+}
+
+void Benchmark::UpdatePath_data() { SizeData(); }
+
+void Benchmark::UpdatePath()
+{
+    QFETCH(int, size);
+
+    auto fixture { BuildTree(size) };
+    StringHash leaf {};
+    StringHash branch {};
+    StringHash support {};
+    const QString separator { QStringLiteral("-") };
+
+    auto Prepare = [&]() {
+        leaf.clear();
+        branch.clear();
+        support.clear();
+    };
+
+    // ConstructPathFPTS runs once per node inside UpdatePathFPTS
+    auto Kernel = [&]() {
+        for (const auto* node : std::as_const(fixture.root->children))
+            TreeModelUtils::UpdatePathFPTS(leaf, branch, support, fixture.root, node, separator);
+    };
+
+    Measure("UpdatePathFPTS", size, Prepare, Kernel);
+    ReleaseTree(fixture);
+}
+
+void Benchmark::UpdateAncestorValue_data() { SizeData(); }
+
+void Benchmark::UpdateAncestorValue()
+{
+    QFETCH(int, size);
+
+    auto fixture { BuildTree(size) };
+
+    auto Kernel = [&]() {
+        for (auto* node : std::as_const(fixture.leaf_list))
+            TreeModelUtils::UpdateAncestorValueFPT(fixture.root, node, 1.0, 1.0);
+    };
+
+    Measure("UpdateAncestorValueFPT", size, {}, Kernel);
+    ReleaseTree(fixture);
+}
+
+void Benchmark::ConvertTrans_data() { SizeData(); }
+
+void Benchmark::ConvertTrans()
+{
+    QFETCH(int, size);
+
+    auto fixture { BuildLedger(size) };
+    bool left {};
+
+    auto Prepare = [&left]() { left = !left; };
+    auto Kernel = [&]() {
+        for (qsizetype index = 0; index != size; ++index)
+            Sqlite::ConvertTrans(fixture.trans_list.at(index), fixture.trans_shadow_list.at(index), left);
+    };
+
+    Measure("ConvertTrans", size, Prepare, Kernel);
+    ReleaseLedger(fixture);
+}
+
+void Benchmark::TableSort_data() { SizeData(); }
+
+void Benchmark::TableSort()
+{
+    QFETCH(int, size);
+
+    auto fixture { BuildLedger(size) };
+    Qt::SortOrder order { Qt::DescendingOrder };
+
+    // same comparator the finance table builds for its debit column
+    auto Prepare = [&order]() { order = order == Qt::AscendingOrder ? Qt::DescendingOrder : Qt::AscendingOrder; };
+    auto Kernel = [&]() {
+        ColumnUtils::Sort(kTableFinance, std::to_underlying(TableEnumFinance::kDebit), order,
+            [&fixture](auto Compare) { std::sort(fixture.trans_shadow_list.begin(), fixture.trans_shadow_list.end(), Compare); });
+    };
+
+    Measure("TableSort", size, Prepare, Kernel);
+    ReleaseLedger(fixture);
+}
+
+void Benchmark::AccumulateSubtotal_data() { SizeData(); }
+
+void Benchmark::AccumulateSubtotal()
+{
+    QFETCH(int, size);
+
+    auto fixture { BuildLedger(size) };
+    QMutex mutex {};
+
+    // the subtotal pass runs on the pool, timing stops once it has drained
+    auto Kernel = [&]() {
+        TableModelUtils::AccumulateSubtotal(mutex, fixture.trans_shadow_list, 0, true);
+        QThreadPool::globalInstance()->waitForDone();
+    };
+
+    Measure("AccumulateSubtotal", size, {}, Kernel);
+    ReleaseLedger(fixture);
+}
+
+void Benchmark::ResourcePoolContention_data() { SizeData(); }
+
+void Benchmark::ResourcePoolContention()
+{
+    QFETCH(int, size);
+
+    constexpr qsizetype batch { 64 };
+    const int thread_count { std::max(2, QThread::idealThreadCount()) };
+    const qsizetype round { std::max(size / thread_count / batch, qsizetype(1)) };
+
+    // every thread takes a batch and hands it back, size allocations in total across thread_count threads
+    auto Worker = [round]() {
+        TransList trans_list {};
+        trans_list.reserve(batch);
+
+        for (qsizetype index = 0; index != round; ++index) {
+            for (qsizetype count = 0; count != batch; ++count)
+                trans_list.emplaceBack(ResourcePool<Trans>::Instance().Allocate());
+
+            ResourcePool<Trans>::Instance().Recycle(trans_list);
+        }
+    };
+
+    auto Kernel = [&]() {
+        QList<QFuture<void>> future_list {};
+        for (int thread = 0; thread != thread_count; ++thread)
+            future_list.emplaceBack(QtConcurrent::run(Worker));
+
+        for (auto& future : future_list)
+            future.waitForFinished();
+    };
+
+    Measure("ResourcePool", size, {}, Kernel);
+}
+
+void Benchmark::Measure(const char* name, qsizetype size, const std::function<void()>& prepare, const std::function<void()>& kernel)
+{
+    QList<qint64> elapsed_list {};
+    QElapsedTimer timer {};
+
+    // QBENCHMARK reports the whole iteration, the baseline check uses the kernel alone
+    QBENCHMARK {
+        if (prepare)
+            prepare();
+
+        timer.start();
+        {
+            const TraceSpan span { name };
+            kernel();
+        }
+        elapsed_list.emplaceBack(timer.nsecsElapsed());
+    }
+
+    std::sort(elapsed_list.begin(), elapsed_list.end());
+    const double median { elapsed_list.at(elapsed_list.size() / 2) / 1e6 };
+    const QString key { QStringLiteral("%1/%2").arg(QString::fromLatin1(name)).arg(size) };
+
+    if (record_) {
+        baseline_.insert(key, median);
+        return;
+    }
+
+    const auto it { baseline_.constFind(key) };
+    if (it == baseline_.cend())
+        QSKIP(qPrintable(QStringLiteral("%1 has no baseline, took %2 ms").arg(key).arg(median, 0, 'f', 3)));
+
+    QVERIFY2(median <= it.value() * kMargin,
+        qPrintable(QStringLiteral("%1 took %2 ms, baseline %3 ms").arg(key).arg(median, 0, 'f', 3).arg(it.value(), 0, 'f', 3)));
+}
+
+QTEST_GUILESS_MAIN(Benchmark)
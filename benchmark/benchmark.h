@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <QHash>
+#include <QObject>
+#include <functional>
+
+#include "component/using.h"
+#include "table/trans.h"
+#include "tree/node.h"
+
+// Kernel timings without a window or a file, built as ytx_bench and run by ctest
+// Fixtures are generated in memory with a fixed seed, each kernel runs at 1k, 10k and 100k under QBENCHMARK,
+// plus 1m when YTX_BENCH_LARGE is set, and fails when its median passes kMargin times the baseline recorded for that size.
+// A missing baseline file fails the run, a size missing from it is skipped.
+// YTX_BENCH_RECORD=1 ytx_bench rewrites the baseline file instead, spans land in the trace when YTX_TRACE is set
+class Benchmark final : public QObject {
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+
+    void SortIterative_data();
+    void SortIterative();
+    void UpdatePath_data();
+    void UpdatePath();
+    void UpdateAncestorValue_data();
+    void UpdateAncestorValue();
+    void ConvertTrans_data();
+    void ConvertTrans();
+    void TableSort_data();
+    void TableSort();
+    void AccumulateSubtotal_data();
+    void AccumulateSubtotal();
+    void ResourcePoolContention_data();
+    void ResourcePoolContention();
+
+private:
+    struct TreeFixture {
+        Node* root {};
+        QList<Node*> node_list {};
+        QList<Node*> leaf_list {};
+    };
+
+    struct LedgerFixture {
+        TransList trans_list {};
+        TransShadowList trans_shadow_list {};
+    };
+
+    void SizeData() const;
+
+    TreeFixture BuildTree(qsizetype size) const;
+    void ReleaseTree(TreeFixture& fixture) const;
+    LedgerFixture BuildLedger(qsizetype size) const;
+    void ReleaseLedger(LedgerFixture& fixture) const;
+
+    // prepare runs before every iteration and is left out of the median, kernel is timed
+    void Measure(const char* name, qsizetype size, const std::function<void()>& prepare, const std::function<void()>& kernel);
+
+private:
+    static constexpr int kFanOut { 8 };
+    // a kernel fails once its median is this many times its baseline
+    static constexpr double kMargin { 1.5 };
+
+    bool record_ {};
+    QHash<QString, double> baseline_ {}; // "kernel/size", median in ms
+};
+
+#endif // BENCHMARK_H
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef COLUMN_H
+#define COLUMN_H
+
+#include <QVariant>
+#include <array>
+#include <type_traits>
+#include <variant>
+
+// Field of one column, a member pointer into Row, std::monostate for columns the model computes itself
+template <typename Row, typename... T> using ColumnField = std::variant<std::monostate, T Row::*...>;
+
+// One entry per enum column, kept in constexpr tables next to the enums they follow
+template <typename Field> struct ColumnDescriptor {
+    Field field {};
+    bool blank_zero {}; // 0 and false show as an empty cell
+    bool sortable {};
+};
+
+class ColumnUtils {
+public:
+    // a pointer member is read through, so TransShadow and Node columns look the same
+    template <typename Row, typename T> static decltype(auto) Value(const Row* row, T Row::* member)
+    {
+        if constexpr (std::is_pointer_v<T>)
+            return *(row->*member);
+        else
+            return (row->*member);
+    }
+
+    template <typename Field, std::size_t N> static constexpr bool Sortable(const std::array<ColumnDescriptor<Field>, N>& table, int column)
+    {
+        return column >= 0 && column < int(N) && table[column].sortable && !std::holds_alternative<std::monostate>(table[column].field);
+    }
+
+    template <typename Row, typename Field, std::size_t N> static QVariant Data(const std::array<ColumnDescriptor<Field>, N>& table, int column, const Row* row)
+    {
+        if (column < 0 || column >= int(N))
+            return QVariant();
+
+        const auto& descriptor { table[column] };
+
+        return std::visit(
+            [&]<typename Member>(Member member) -> QVariant {
+                if constexpr (std::is_same_v<Member, std::monostate>) {
+                    return QVariant();
+                } else {
+                    const auto& value { Value(row, member) };
+                    using T = std::remove_cvref_t<decltype(value)>;
+
+                    if (descriptor.blank_zero && value == T {})
+                        return QVariant();
+
+                    return QVariant::fromValue(value);
+                }
+            },
+            descriptor.field);
+    }
+
+    // sorter receives a comparator typed on the column's field, so each comparison is one load and one compare
+    template <typename Field, std::size_t N, typename Sorter>
+    static void Sort(const std::array<ColumnDescriptor<Field>, N>& table, int column, Qt::SortOrder order, Sorter&& sorter)
+    {
+        if (!Sortable(table, column))
+            return;
+
+        std::visit(
+            [&]<typename Member>(Member member) {
+                if constexpr (!std::is_same_v<Member, std::monostate>) {
+                    using Row = typename MemberOf<Member>::Class;
+
+                    if (order == Qt::AscendingOrder)
+                        sorter([member](const Row* lhs, const Row* rhs) { return Value(lhs, member) < Value(rhs, member); });
+                    else
+                        sorter([member](const Row* lhs, const Row* rhs) { return Value(lhs, member) > Value(rhs, member); });
+                }
+            },
+            table[column].field);
+    }
+
+private:
+    template <typename Member> struct MemberOf;
+    template <typename Class_, typename T> struct MemberOf<T Class_::*> {
+        using Class = Class_;
+    };
+};
+
+#endif // COLUMN_H
@@ -0,0 +1,197 @@
+#include "columnwidth.h"
+
+ColumnWidth::ColumnWidth(QAbstractItemView* view, QHeaderView* header)
+    : QObject { view }
+    , view_ { view }
+    , header_ { header }
+    , tree_view_ { qobject_cast<QTreeView*>(view) }
+{
+    for (int column = 0; column != header_->count(); ++column) {
+        if (header_->sectionResizeMode(column) != QHeaderView::ResizeToContents)
+            continue;
+
+        header_->setSectionResizeMode(column, QHeaderView::Interactive);
+        cell_width_.insert(column, {});
+        width_bucket_.insert(column, {});
+    }
+
+    auto* model { view_->model() };
+    connect(model, &QAbstractItemModel::rowsInserted, this, &ColumnWidth::RRowsInserted);
+    connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this, &ColumnWidth::RRowsAboutToBeRemoved);
+    connect(model, &QAbstractItemModel::rowsMoved, this, &ColumnWidth::RRowsMoved);
+    connect(model, &QAbstractItemModel::dataChanged, this, &ColumnWidth::RDataChanged);
+    connect(model, &QAbstractItemModel::modelReset, this, &ColumnWidth::Rebuild);
+
+    // delegates are set after the view, measure once they are in place
+    QMetaObject::invokeMethod(this, &ColumnWidth::Rebuild, Qt::QueuedConnection);
+}
+
+void ColumnWidth::RResizeColumn(int column)
+{
+    if (!width_bucket_.contains(column))
+        return;
+
+    const auto current { view_->currentIndex() };
+    if (current.isValid())
+        MeasureCell(current.siblingAtColumn(column));
+
+    ApplyWidth(column);
+}
+
+void ColumnWidth::Rebuild()
+{
+    for (auto& cell : cell_width_)
+        cell.clear();
+
+    for (auto& bucket : width_bucket_)
+        bucket.clear();
+
+    const int row_count { view_->model()->rowCount() };
+    if (row_count != 0)
+        MeasureRows(QModelIndex(), 0, row_count - 1);
+
+    ApplyWidth();
+}
+
+void ColumnWidth::RRowsInserted(const QModelIndex& parent, int first, int last)
+{
+    MeasureRows(parent, first, last);
+    ApplyWidth();
+}
+
+void ColumnWidth::RRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last)
+{
+    RemoveRows(parent, first, last);
+    ApplyWidth();
+}
+
+void ColumnWidth::RRowsMoved(const QModelIndex& source_parent, int source_start, int source_end, const QModelIndex& destination_parent, int destination_row)
+{
+    // the depth changes, so does the indentation of the tree column
+    const int count { source_end - source_start };
+    const int first { source_parent == destination_parent && destination_row > source_start ? destination_row - count - 1 : destination_row };
+
+    MeasureRows(destination_parent, first, first + count);
+    ApplyWidth();
+}
+
+void ColumnWidth::RDataChanged(const QModelIndex& top_left, const QModelIndex& bottom_right)
+{
+    const auto parent { top_left.parent() };
+    auto* model { view_->model() };
+
+    for (int column = top_left.column(); column <= bottom_right.column(); ++column) {
+        if (!width_bucket_.contains(column))
+            continue;
+
+        for (int row = top_left.row(); row <= bottom_right.row(); ++row)
+            MeasureCell(model->index(row, column, parent));
+
+        ApplyWidth(column);
+    }
+}
+
+void ColumnWidth::MeasureRows(const QModelIndex& parent, int first, int last)
+{
+    auto* model { view_->model() };
+
+    for (int row = first; row <= last; ++row) {
+        for (auto it = width_bucket_.cbegin(); it != width_bucket_.cend(); ++it)
+            MeasureCell(model->index(row, it.key(), parent));
+
+        if (!tree_view_)
+            continue;
+
+        const auto index { model->index(row, 0, parent) };
+        const int row_count { model->rowCount(index) };
+        if (row_count != 0)
+            MeasureRows(index, 0, row_count - 1);
+    }
+}
+
+void ColumnWidth::RemoveRows(const QModelIndex& parent, int first, int last)
+{
+    auto* model { view_->model() };
+
+    for (int row = first; row <= last; ++row) {
+        const auto index { model->index(row, 0, parent) };
+        const quintptr key { index.internalId() };
+
+        for (auto it = width_bucket_.cbegin(); it != width_bucket_.cend(); ++it)
+            RemoveCell(it.key(), key);
+
+        if (!tree_view_)
+            continue;
+
+        const int row_count { model->rowCount(index) };
+        if (row_count != 0)
+            RemoveRows(index, 0, row_count - 1);
+    }
+}
+
+void ColumnWidth::MeasureCell(const QModelIndex& index)
+{
+    if (!index.isValid())
+        return;
+
+    const int column { index.column() };
+    const quintptr key { index.internalId() };
+    const int width { Width(index) };
+
+    RemoveCell(column, key);
+    cell_width_[column].insert(key, width);
+    ++width_bucket_[column][width];
+}
+
+void ColumnWidth::RemoveCell(int column, quintptr key)
+{
+    auto& cell { cell_width_[column] };
+    auto it { cell.find(key) };
+    if (it == cell.end())
+        return;
+
+    auto& bucket { width_bucket_[column] };
+    auto bucket_it { bucket.find(*it) };
+    if (bucket_it != bucket.end() && --*bucket_it == 0)
+        bucket.erase(bucket_it);
+
+    cell.erase(it);
+}
+
+void ColumnWidth::ApplyWidth()
+{
+    for (auto it = width_bucket_.cbegin(); it != width_bucket_.cend(); ++it)
+        ApplyWidth(it.key());
+}
+
+void ColumnWidth::ApplyWidth(int column)
+{
+    const auto& bucket { width_bucket_[column] };
+
+    int width { header_->sectionSizeHint(column) };
+    if (!bucket.isEmpty())
+        width = std::max(width, bucket.lastKey());
+
+    if (header_->sectionSize(column) != width)
+        header_->resizeSection(column, width);
+}
+
+int ColumnWidth::Width(const QModelIndex& index) const
+{
+    QStyleOptionViewItem option {};
+    option.initFrom(view_);
+    option.rect = QRect();
+    option.font = view_->font();
+
+    int width { view_->itemDelegateForIndex(index)->sizeHint(option, index).width() };
+
+    if (tree_view_ && index.column() == std::max(tree_view_->treePosition(), 0)) {
+        int depth { tree_view_->rootIsDecorated() ? 1 : 0 };
+        for (auto parent = index.parent(); parent.isValid(); parent = parent.parent())
+            ++depth;
+
+        width += depth * tree_view_->indentation();
+    }
+
+    return width;
+}
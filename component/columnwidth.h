@@ -0,0 +1,50 @@
+#ifndef COLUMNWIDTH_H
+#define COLUMNWIDTH_H
+
+#include <QAbstractItemView>
+#include <QHeaderView>
+#include <QMap>
+#include <QTreeView>
+
+// Tracks the widest cell of every ResizeToContents column so a resize never rescans the model
+// A row is keyed by the index's internal pointer, the node or the trans shadow, which stays the same while it is saved and sorted
+// Every cell width is counted in a width -> count bucket, the widest content is the last bucket
+// The running subtotal is measured from the dataChanged range its pass emits, not on resize
+class ColumnWidth final : public QObject {
+    Q_OBJECT
+
+public:
+    ColumnWidth(QAbstractItemView* view, QHeaderView* header);
+
+public slots:
+    // replace QTableView::resizeColumnToContents and QTreeView::resizeColumnToContents
+    void RResizeColumn(int column);
+
+public:
+    void Rebuild();
+
+private slots:
+    void RRowsInserted(const QModelIndex& parent, int first, int last);
+    void RRowsAboutToBeRemoved(const QModelIndex& parent, int first, int last);
+    void RRowsMoved(const QModelIndex& source_parent, int source_start, int source_end, const QModelIndex& destination_parent, int destination_row);
+    void RDataChanged(const QModelIndex& top_left, const QModelIndex& bottom_right);
+
+private:
+    void MeasureRows(const QModelIndex& parent, int first, int last);
+    void RemoveRows(const QModelIndex& parent, int first, int last);
+    void MeasureCell(const QModelIndex& index);
+    void RemoveCell(int column, quintptr key);
+    void ApplyWidth();
+    void ApplyWidth(int column);
+    int Width(const QModelIndex& index) const;
+
+private:
+    QAbstractItemView* view_ {};
+    QHeaderView* header_ {};
+    QTreeView* tree_view_ {};
+
+    QHash<int, QHash<quintptr, int>> cell_width_ {}; // column -> key -> width
+    QHash<int, QMap<int, int>> width_bucket_ {}; // column -> width -> count
+};
+
+#endif // COLUMNWIDTH_H
@@ -21,11 +21,18 @@
 #define CONSTVALUE_H
 
 // Constants for values
-inline constexpr long long kBatchSize = 50;
 inline constexpr int kHundred = 100;
 inline constexpr int kRowHeight = 24;
 inline constexpr int kThreeThousand = 3000;
 inline constexpr long long kMaxRecentFile = 10;
+inline constexpr int kPrefetchDelay = 300;
+inline constexpr long long kPrefetchBudget = 8;
+inline constexpr long long kDelegateCacheSize = 65536;
+inline constexpr long long kReportCacheSize = 8;
+inline constexpr int kSearchDelay = 300;
+inline constexpr long long kSearchChunk = 256;
+inline constexpr int kMemoryLogInterval = 600000;
+inline constexpr int kRestoreInterval = 200;
 
 // Constants for rule
 inline constexpr bool kRuleIS = 0;
@@ -100,6 +107,8 @@ inline constexpr char kSupportID[] = "support_id";
 inline constexpr char kAncestor[] = "ancestor";
 inline constexpr char kDescendant[] = "descendant";
 inline constexpr char kDistance[] = "distance";
+inline constexpr char kParent[] = "parent";
+inline constexpr char kLineage[] = "lineage";
 
 // Constants for app's state
 inline constexpr char kHeaderState[] = "header_state";
@@ -155,6 +155,34 @@ enum class TreeEnumSearch {
     kFinalTotal
 };
 
+// Enum class defining report groups and columns
+enum class ReportGroup { kParty, kProduct, kEmployee, kPeriod };
+
+enum class TableEnumReport { kKey, kCount, kFirst, kSecond, kAmount, kDiscount, kSettled };
+
+// Enum class defining balance history periods and columns
+enum class BalancePeriod { kDay, kWeek, kMonth };
+
+enum class TableEnumBalance { kDate, kCount, kChange, kBalance };
+
+// Enum class defining trial balance columns
+enum class TableEnumTrial { kName, kOpening, kDebit, kCredit, kClosing };
+
+// Enum class defining stock columns
+enum class TableEnumStock { kName, kQuantity, kAverage, kValue };
+
+// Enum class defining aging columns, each bucket counts days past the due date
+enum class TableEnumAging { kParty, kCurrent, kDays30, kDays60, kDays90, kOver90, kTotal };
+
+// Enum class defining integrity findings and columns
+enum class IntegrityKind { kLeafInitial, kLeafFinal, kBranchInitial, kBranchFinal, kSelfRow, kParent, kPath };
+
+enum class TableEnumIntegrity { kSection, kNode, kKind, kAncestor, kStored, kExpected };
+
+enum class TableEnumSearchAll { kSection, kKind, kName, kCode, kPath, kDateTime };
+
+enum class TableEnumMemory { kSection, kItem, kCount, kBytes, kFree, kHighWater };
+
 // Enum class defining check options
 enum class Check { kNone, kAll, kReverse };
 
@@ -1,5 +1,6 @@
 #include "mainwindowsqlite.h"
 
+#include <QSet>
 #include <QSqlError>
 #include <QSqlQuery>
 
@@ -76,7 +77,7 @@ void MainwindowSqlite::UpdateSettings(CSettings& settings, Section section)
     }
 }
 
-void MainwindowSqlite::NewFile(CString& file_path)
+void MainwindowSqlite::NewFile(CString& file_path, bool lineage)
 {
     QSqlDatabase db { QSqlDatabase::addDatabase(kQSQLITE) };
     db.setDatabaseName(file_path);
@@ -84,29 +85,25 @@ void MainwindowSqlite::NewFile(CString& file_path)
         return;
 
     QString finance = NodeFinance();
-    QString finance_path = Path(kFinancePath);
     QString finance_transaction = TransactionFinance();
 
     QString product = NodeProduct();
-    QString product_path = Path(kProductPath);
     QString product_transaction = TransactionProduct();
 
     QString task = NodeTask();
-    QString task_path = Path(kTaskPath);
     QString task_transaction = TransactionTask();
 
     QString stakeholder = NodeStakeholder();
-    QString stakeholder_path = Path(kStakeholderPath);
     QString stakeholder_transaction = TransactionStakeholder();
 
     QString purchase = NodePurchase();
-    QString purchase_path = Path(kPurchasePath);
     QString purchase_transaction = TransactionPurchase();
 
     QString sales = NodeSales();
-    QString sales_path = Path(kSalesPath);
     QString sales_transaction = TransactionSales();
 
+    QString document = Document();
+
     QString settings = QStringLiteral(R"(
     CREATE TABLE IF NOT EXISTS settings (
         id                  INTEGER PRIMARY KEY AUTOINCREMENT,
@@ -126,13 +123,30 @@ void MainwindowSqlite::NewFile(CString& file_path)
 
     QLatin1String settings_row { "INSERT INTO settings (static_node) VALUES (0);" };
 
+    QStringList table_list { finance, finance_transaction, product, product_transaction, stakeholder, stakeholder_transaction, task, task_transaction,
+        purchase, purchase_transaction, sales, sales_transaction, document, settings };
+
+    // a lineage file keeps the hierarchy on the node tables, it has no closure tables
+    if (lineage) {
+        const QStringList node_list { kFinance, kProduct, kTask, kStakeholder, kPurchase, kSales };
+        for (CString& node : node_list)
+            table_list.append(LineageColumn(node));
+    } else {
+        table_list.append({ Path(kFinancePath), Path(kProductPath), Path(kTaskPath), Path(kStakeholderPath), Path(kPurchasePath), Path(kSalesPath) });
+    }
+
     QSqlQuery query {};
     if (db.transaction()) {
         // Execute each table creation query
-        if (query.exec(finance) && query.exec(finance_path) && query.exec(finance_transaction) && query.exec(product) && query.exec(product_path)
-            && query.exec(product_transaction) && query.exec(stakeholder) && query.exec(stakeholder_path) && query.exec(stakeholder_transaction)
-            && query.exec(task) && query.exec(task_path) && query.exec(task_transaction) && query.exec(purchase) && query.exec(purchase_path)
-            && query.exec(purchase_transaction) && query.exec(sales) && query.exec(sales_path) && query.exec(sales_transaction) && query.exec(settings)) {
+        bool created { true };
+        for (const auto& string : std::as_const(table_list)) {
+            if (!query.exec(string)) {
+                created = false;
+                break;
+            }
+        }
+
+        if (created) {
             // Commit the transaction if all queries are successful
             if (db.commit()) {
                 for (int i = 0; i != 6; ++i) {
@@ -235,7 +249,7 @@ QString MainwindowSqlite::NodeTask()
         finished         BOOLEAN    DEFAULT 0,
         date_time        TEXT,
         color            TEXT,
-        document         TEXT,
+        document_count   INTEGER    DEFAULT 0,
         unit_cost        NUMERIC,
         quantity         NUMERIC,
         amount           NUMERIC,
@@ -244,6 +258,248 @@ QString MainwindowSqlite::NodeTask()
     )");
 }
 
+void MainwindowSqlite::CreateIndex()
+{
+    const QStringList index_list {
+        QStringLiteral("CREATE INDEX IF NOT EXISTS sales_report ON sales (finished, removed, date_time)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS sales_transaction_lhs_node ON sales_transaction (lhs_node)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS purchase_report ON purchase (finished, removed, date_time)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS purchase_transaction_lhs_node ON purchase_transaction (lhs_node)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS finance_transaction_lhs_node ON finance_transaction (lhs_node, date_time)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS finance_transaction_rhs_node ON finance_transaction (rhs_node, date_time)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS product_transaction_lhs_node ON product_transaction (lhs_node, date_time)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS product_transaction_rhs_node ON product_transaction (rhs_node, date_time)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS task_transaction_lhs_node ON task_transaction (lhs_node, date_time)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS task_transaction_rhs_node ON task_transaction (rhs_node, date_time)"),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS stakeholder_transaction_lhs_node ON stakeholder_transaction (lhs_node, inside_product, date_time)"),
+    };
+
+    QSqlQuery query(*db_);
+
+    for (const auto& string : index_list) {
+        if (!query.exec(string)) {
+            qWarning() << "Failed to create index: " << query.lastError().text();
+            return;
+        }
+    }
+}
+
+void MainwindowSqlite::MigrateDocument()
+{
+    QSqlQuery query(*db_);
+
+    if (!query.exec(Document()) || !query.exec(QStringLiteral("CREATE INDEX IF NOT EXISTS document_owner ON document (owner, owner_id)"))) {
+        qWarning() << "Failed to create document table: " << query.lastError().text();
+        return;
+    }
+
+    const QStringList owner_list { kTask, kFinanceTransaction, kProductTransaction, kTaskTransaction, kStakeholderTransaction };
+
+    if (!db_->transaction()) {
+        qWarning() << "Failed to start document migration: " << db_->lastError().text();
+        return;
+    }
+
+    for (const auto& owner : owner_list) {
+        query.exec(QStringLiteral("PRAGMA table_info(%1)").arg(owner));
+
+        QStringList column_list {};
+        while (query.next())
+            column_list.emplaceBack(query.value(QStringLiteral("name")).toString());
+
+        if (!column_list.contains(QStringLiteral("document_count"))
+            && !query.exec(QStringLiteral("ALTER TABLE %1 ADD COLUMN document_count INTEGER DEFAULT 0").arg(owner))) {
+            qWarning() << "Failed to add document_count: " << query.lastError().text();
+            db_->rollback();
+            return;
+        }
+
+        // files made before the document table keep the paths joined by semicolons in the owner row
+        if (!column_list.contains(kDocument))
+            continue;
+
+        QHash<int, QStringList> document_hash {};
+
+        query.exec(QStringLiteral("SELECT id, document FROM %1 WHERE document IS NOT NULL AND document != ''").arg(owner));
+        while (query.next())
+            document_hash.insert(query.value(QStringLiteral("id")).toInt(), query.value(kDocument).toString().split(kSemicolon, Qt::SkipEmptyParts));
+
+        for (auto it = document_hash.cbegin(); it != document_hash.cend(); ++it) {
+            query.prepare(QStringLiteral("INSERT INTO document (owner, owner_id, path) VALUES (:owner, :owner_id, :path)"));
+
+            for (const auto& path : it.value()) {
+                query.bindValue(QStringLiteral(":owner"), owner);
+                query.bindValue(QStringLiteral(":owner_id"), it.key());
+                query.bindValue(QStringLiteral(":path"), path);
+
+                if (!query.exec()) {
+                    qWarning() << "Failed to move document: " << query.lastError().text();
+                    db_->rollback();
+                    return;
+                }
+            }
+
+            query.prepare(QStringLiteral("UPDATE %1 SET document = NULL, document_count = :count WHERE id = :id").arg(owner));
+            query.bindValue(QStringLiteral(":count"), it->size());
+            query.bindValue(QStringLiteral(":id"), it.key());
+
+            if (!query.exec()) {
+                qWarning() << "Failed to move document: " << query.lastError().text();
+                db_->rollback();
+                return;
+            }
+        }
+    }
+
+    if (!db_->commit()) {
+        qWarning() << "Failed to commit document migration: " << db_->lastError().text();
+        db_->rollback();
+    }
+}
+
+bool MainwindowSqlite::Lineage()
+{
+    QSqlQuery query(*db_);
+
+    query.exec(QStringLiteral("PRAGMA table_info(%1)").arg(kFinance));
+    while (query.next()) {
+        if (query.value(QStringLiteral("name")).toString() == kLineage)
+            return true;
+    }
+
+    return false;
+}
+
+bool MainwindowSqlite::MigrateLineage()
+{
+    const QList<std::pair<QString, QString>> table_list { { kFinance, kFinancePath }, { kProduct, kProductPath }, { kTask, kTaskPath },
+        { kStakeholder, kStakeholderPath }, { kSales, kSalesPath }, { kPurchase, kPurchasePath } };
+
+    bool ok { true };
+
+    for (const auto& [node, path] : table_list)
+        ok = MigrateLineage(node, path) && ok;
+
+    return ok;
+}
+
+bool MainwindowSqlite::MigrateLineage(CString& node, CString& path)
+{
+    QSqlQuery query(*db_);
+
+    query.exec(QStringLiteral("PRAGMA table_info(%1)").arg(node));
+    while (query.next()) {
+        if (query.value(QStringLiteral("name")).toString() == kLineage)
+            return true;
+    }
+
+    // the first live parent row in rowid order, the same one Sqlite::ReadRelationship keeps
+    QHash<int, int> parent_hash {};
+    QList<int> id_list {};
+    QSet<int> live_set {};
+
+    query.exec(QStringLiteral("SELECT id, removed FROM %1 ORDER BY id").arg(node));
+    while (query.next()) {
+        const int id { query.value(QStringLiteral("id")).toInt() };
+        id_list.emplaceBack(id);
+
+        if (!query.value(QStringLiteral("removed")).toBool())
+            live_set.insert(id);
+    }
+
+    query.exec(QStringLiteral("SELECT ancestor, descendant FROM %1 WHERE distance = 1 ORDER BY rowid").arg(path));
+    while (query.next()) {
+        const int ancestor { query.value(kAncestor).toInt() };
+        const int descendant { query.value(kDescendant).toInt() };
+
+        if (ancestor != descendant && live_set.contains(ancestor) && live_set.contains(descendant) && !parent_hash.contains(descendant))
+            parent_hash.insert(descendant, ancestor);
+    }
+
+    // removed nodes and nodes caught in a parent loop start a lineage of their own
+    QHash<int, QString> lineage_hash {};
+
+    for (int id : std::as_const(id_list)) {
+        QList<int> chain { id };
+
+        for (auto it = parent_hash.constFind(id); it != parent_hash.constEnd() && !lineage_hash.contains(chain.last()); it = parent_hash.constFind(it.value())) {
+            if (chain.contains(it.value())) {
+                qWarning() << "Parent loop at" << node << it.key();
+                parent_hash.remove(it.key());
+                break;
+            }
+
+            chain.emplaceBack(it.value());
+        }
+
+        QString lineage { lineage_hash.value(chain.last(), QStringLiteral("/")) };
+        if (lineage_hash.contains(chain.last()))
+            chain.removeLast();
+
+        for (auto it = chain.crbegin(); it != chain.crend(); ++it) {
+            lineage += QString::number(*it) + QLatin1Char('/');
+            lineage_hash.insert(*it, lineage);
+        }
+    }
+
+    if (!db_->transaction()) {
+        qWarning() << "Failed to start lineage migration: " << db_->lastError().text();
+        return false;
+    }
+
+    const QStringList alter_list { LineageColumn(node) };
+
+    for (const auto& string : alter_list) {
+        if (!query.exec(string)) {
+            qWarning() << "Failed to add lineage columns: " << query.lastError().text();
+            db_->rollback();
+            return false;
+        }
+    }
+
+    query.prepare(QStringLiteral("UPDATE %1 SET parent = :parent, lineage = :lineage WHERE id = :id").arg(node));
+
+    for (int id : std::as_const(id_list)) {
+        auto parent { parent_hash.constFind(id) };
+
+        query.bindValue(QStringLiteral(":parent"), parent == parent_hash.constEnd() ? QVariant() : QVariant(parent.value()));
+        query.bindValue(QStringLiteral(":lineage"), lineage_hash.value(id));
+        query.bindValue(QStringLiteral(":id"), id);
+
+        if (!query.exec()) {
+            qWarning() << "Failed to write lineage: " << query.lastError().text();
+            db_->rollback();
+            return false;
+        }
+    }
+
+    if (!query.exec(QStringLiteral("DROP TABLE %1").arg(path))) {
+        qWarning() << "Failed to finish lineage migration: " << query.lastError().text();
+        db_->rollback();
+        return false;
+    }
+
+    if (!db_->commit()) {
+        qWarning() << "Failed to commit lineage migration: " << db_->lastError().text();
+        db_->rollback();
+        return false;
+    }
+
+    return true;
+}
+
+QString MainwindowSqlite::Document()
+{
+    return QStringLiteral(R"(
+    CREATE TABLE IF NOT EXISTS document (
+        id          INTEGER PRIMARY KEY AUTOINCREMENT,
+        owner       TEXT,
+        owner_id    INTEGER,
+        path        TEXT
+    );
+    )");
+}
+
 QString MainwindowSqlite::NodeSales()
 {
     return QStringLiteral(R"(
@@ -296,6 +552,15 @@ QString MainwindowSqlite::NodePurchase()
     )");
 }
 
+QStringList MainwindowSqlite::LineageColumn(CString& node)
+{
+    return {
+        QStringLiteral("ALTER TABLE %1 ADD COLUMN parent INTEGER").arg(node),
+        QStringLiteral("ALTER TABLE %1 ADD COLUMN lineage TEXT").arg(node),
+        QStringLiteral("CREATE INDEX IF NOT EXISTS %1_lineage ON %1 (lineage)").arg(node),
+    };
+}
+
 QString MainwindowSqlite::Path(CString& table_name)
 {
     return QStringLiteral(R"(
@@ -321,7 +586,7 @@ QString MainwindowSqlite::TransactionFinance()
         lhs_credit     NUMERIC                   CHECK (lhs_credit >= 0),
         description    TEXT,
         support_id     INTEGER,
-        document       TEXT,
+        document_count INTEGER    DEFAULT 0,
         state          BOOLEAN    DEFAULT 0,
         rhs_credit     NUMERIC                   CHECK (rhs_credit >= 0),
         rhs_debit      NUMERIC                   CHECK (rhs_debit  >= 0),
@@ -387,7 +652,7 @@ QString MainwindowSqlite::TransactionStakeholder()
         outside_product    INTEGER,
         description        TEXT,
         unit_price         NUMERIC,
-        document           TEXT,
+        document_count     INTEGER    DEFAULT 0,
         state              BOOLEAN    DEFAULT 0,
         inside_product     INTEGER,
         removed            BOOLEAN    DEFAULT 0
@@ -408,7 +673,7 @@ QString MainwindowSqlite::TransactionTask()
         description    TEXT,
         support_id     INTEGER,
         unit_cost      NUMERIC,
-        document       TEXT,
+        document_count INTEGER    DEFAULT 0,
         state          BOOLEAN    DEFAULT 0,
         rhs_credit     NUMERIC                  CHECK (rhs_credit >= 0),
         rhs_debit      NUMERIC                  CHECK (rhs_debit  >= 0),
@@ -431,7 +696,7 @@ QString MainwindowSqlite::TransactionProduct()
         description    TEXT,
         support_id     INTEGER,
         unit_cost      NUMERIC,
-        document       TEXT,
+        document_count INTEGER    DEFAULT 0,
         state          BOOLEAN    DEFAULT 0,
         rhs_credit     NUMERIC                  CHECK (rhs_credit >= 0),
         rhs_debit      NUMERIC                  CHECK (rhs_debit  >= 0),
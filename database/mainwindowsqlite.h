@@ -33,7 +33,17 @@ public:
 
     void QuerySettings(Settings& settings, Section section);
     void UpdateSettings(CSettings& settings, Section section);
-    void NewFile(CString& file_path);
+    // lineage creates the parent and lineage columns in place of the closure tables
+    void NewFile(CString& file_path, bool lineage = false);
+    // idempotent, also brings files created before the index existed up to date
+    void CreateIndex();
+    // idempotent, moves the semicolon-joined document column of older files into the document table
+    void MigrateDocument();
+    // converts every section's closure table into parent and lineage columns on the node table, then drops it
+    // sections already converted are skipped, false when a section failed and was rolled back
+    bool MigrateLineage();
+    // true once MigrateLineage has converted the file, all sections convert together so finance stands for them
+    bool Lineage();
 
 private:
     QString NodeFinance();
@@ -44,6 +54,9 @@ private:
     QString NodePurchase();
 
     QString Path(CString& table_name);
+    QStringList LineageColumn(CString& node);
+    QString Document();
+    bool MigrateLineage(CString& node, CString& path);
 
     QString TransactionFinance();
     QString TransactionTask();
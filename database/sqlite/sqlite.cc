@@ -1,23 +1,43 @@
 #include "sqlite.h"
 
+#include <QFutureWatcher>
 #include <QSqlError>
 #include <QSqlQuery>
+#include <QtConcurrent>
 
 #include "component/constvalue.h"
 #include "global/resourcepool.h"
 #include "global/sqlconnection.h"
+#include "global/tracer.h"
 
 Sqlite::Sqlite(CInfo& info, QObject* parent)
     : QObject(parent)
     , db_ { SqlConnection::Instance().Allocate(info.section) }
     , info_ { info }
 {
+    QSqlQuery query(*db_);
+    query.exec(QStringLiteral("PRAGMA table_info(%1)").arg(info_.node));
+
+    while (query.next()) {
+        if (query.value(QStringLiteral("name")).toString() == kLineage) {
+            lineage_ = true;
+            break;
+        }
+    }
 }
 
-Sqlite::~Sqlite() { qDeleteAll(trans_hash_); }
+Sqlite::~Sqlite()
+{
+    qDeleteAll(trans_hash_);
+
+    for (auto& prefetch : prefetch_hash_)
+        qDeleteAll(prefetch.trans_list);
+}
 
 void Sqlite::RRemoveNode(int node_id, int node_type)
 {
+    const TraceSpan span { "RemoveNode", std::to_underlying(info_.section) };
+
     // Notify MainWindow to release the table view
     emit SFreeView(node_id);
     // Notify TreeModel to remove the node
@@ -54,7 +74,7 @@ void Sqlite::RRemoveNode(int node_id, int node_type)
     const auto trans { node_trans.values() };
 
     for (int trans_id : trans)
-        ResourcePool<Trans>::Instance().Recycle(trans_hash_.take(trans_id));
+        RecycleTrans(trans_id);
 }
 
 QMultiHash<int, int> Sqlite::TransToRemove(int node_id, int target_node_type) const
@@ -115,14 +135,11 @@ QList<int> Sqlite::SupportTransToMoveFPTS(int support_id) const
     return list;
 }
 
-void Sqlite::RemoveSupportFunction(int support_id) const
+void Sqlite::RemoveSupportFunction(int support_id)
 {
-    const auto& const_trans_hash { std::as_const(trans_hash_) };
-
-    for (auto* trans : const_trans_hash) {
-        if (trans->support_id == support_id) {
-            trans->support_id = 0;
-        }
+    for (auto* trans : IndexedTrans(support_index_, support_id)) {
+        trans->support_id = 0;
+        IndexTrans(trans);
     }
 }
 
@@ -248,6 +265,8 @@ void Sqlite::RUpdateStakeholder(int old_node_id, int new_node_id)
 
 bool Sqlite::ReadNode(NodeHash& node_hash)
 {
+    const TraceSpan span { "ReadNode", std::to_underlying(info_.section) };
+
     CString& string { QSReadNode() };
     if (string.isEmpty())
         return false;
@@ -340,36 +359,450 @@ bool Sqlite::LeafTotal(Node* node) const
     return true;
 }
 
-QList<int> Sqlite::SearchNodeName(CString& text) const
+bool Sqlite::RecomputeLeafTotalFPT(int& changed)
+{
+    changed = 0;
+
+    if (QSLeafTotalFPT().isEmpty())
+        return false;
+
+    NodeHash node_hash {};
+    if (!ReadNode(node_hash))
+        return false;
+
+    QList<const Node*> drift_list {};
+    bool ok { true };
+
+    for (auto* node : std::as_const(node_hash)) {
+        if (node->type != kTypeLeaf)
+            continue;
+
+        const double initial_total { node->initial_total };
+        const double final_total { node->final_total };
+
+        if (!LeafTotal(node)) {
+            ok = false;
+            break;
+        }
+
+        if (std::abs(node->initial_total - initial_total) > kTolerance || std::abs(node->final_total - final_total) > kTolerance)
+            drift_list.emplaceBack(node);
+    }
+
+    // All reads are done first, so the transaction starts with a write and waits on the busy timeout instead of failing on a lock upgrade
+    if (ok && !drift_list.isEmpty()) {
+        ok = DBTransaction([&]() {
+            for (const auto* node : std::as_const(drift_list))
+                if (!UpdateNodeValue(node))
+                    return false;
+
+            return true;
+        });
+    }
+
+    if (ok)
+        changed = drift_list.size();
+
+    ResourcePool<Node>::Instance().Recycle(node_hash);
+    return ok;
+}
+
+QStringList Sqlite::ReadDocument(CString& owner, int owner_id) const
 {
     QSqlQuery query(*db_);
     query.setForwardOnly(true);
+    query.prepare(QStringLiteral("SELECT path FROM document WHERE owner = :owner AND owner_id = :owner_id ORDER BY id"));
+    query.bindValue(QStringLiteral(":owner"), owner);
+    query.bindValue(QStringLiteral(":owner_id"), owner_id);
 
-    QString string {};
-    if (text.isEmpty())
-        string = QStringLiteral("SELECT id FROM %1 WHERE removed = 0").arg(info_.node);
-    else
-        string = QStringLiteral("SELECT id FROM %1 WHERE removed = 0 AND name LIKE :text").arg(info_.node);
+    if (!query.exec()) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in ReadDocument" << query.lastError().text();
+        return {};
+    }
+
+    QStringList document {};
+    while (query.next())
+        document.emplaceBack(query.value(QStringLiteral("path")).toString());
+
+    return document;
+}
+
+bool Sqlite::WriteDocument(CString& owner, int owner_id, CStringList& document) const
+{
+    QSqlQuery query(*db_);
+
+    if (!DBTransaction([&]() {
+            query.prepare(QStringLiteral("DELETE FROM document WHERE owner = :owner AND owner_id = :owner_id"));
+            query.bindValue(QStringLiteral(":owner"), owner);
+            query.bindValue(QStringLiteral(":owner_id"), owner_id);
+
+            if (!query.exec()) {
+                qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in WriteDocument 1st" << query.lastError().text();
+                return false;
+            }
+
+            query.prepare(QStringLiteral("INSERT INTO document (owner, owner_id, path) VALUES (:owner, :owner_id, :path)"));
+
+            for (const auto& path : document) {
+                query.bindValue(QStringLiteral(":owner"), owner);
+                query.bindValue(QStringLiteral(":owner_id"), owner_id);
+                query.bindValue(QStringLiteral(":path"), path);
+
+                if (!query.exec()) {
+                    qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in WriteDocument 2nd" << query.lastError().text();
+                    return false;
+                }
+            }
+
+            query.prepare(QStringLiteral("UPDATE %1 SET document_count = :count WHERE id = :owner_id").arg(owner));
+            query.bindValue(QStringLiteral(":count"), document.size());
+            query.bindValue(QStringLiteral(":owner_id"), owner_id);
+
+            if (!query.exec()) {
+                qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in WriteDocument 3rd" << query.lastError().text();
+                return false;
+            }
+
+            return true;
+        })) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in WriteDocument commit";
+        return false;
+    }
+
+    return true;
+}
+
+QFuture<IntegrityResult> Sqlite::CheckIntegrity() const
+{
+    CString file_path { db_->databaseName() };
+    CString connection { QStringLiteral("integrity_%1").arg(std::to_underlying(info_.section)) };
+
+    return QtConcurrent::run([this, connection, file_path]() { return CheckIntegrityWorker(connection, file_path); });
+}
+
+IntegrityResult Sqlite::CheckIntegrityWorker(CString& connection, CString& file_path) const
+{
+    IntegrityResult result {};
+
+    {
+        auto db { QSqlDatabase::addDatabase(kQSQLITE, connection) };
+        db.setDatabaseName(file_path);
+        db.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY"));
+
+        if (!db.open()) {
+            qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed to open worker connection" << db.lastError().text();
+        } else {
+            CheckLeafTotalFPT(result, db);
+            CheckClosure(result, db);
+        }
+    }
+
+    QSqlDatabase::removeDatabase(connection);
+    return result;
+}
+
+void Sqlite::CheckLeafTotalFPT(IntegrityResult& result, QSqlDatabase& db) const
+{
+    CString& string { QSLeafTotalFPT() };
+    if (string.isEmpty())
+        return;
+
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+    query.prepare(QSReadNode());
+
+    if (!query.exec()) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in CheckLeafTotalFPT" << query.lastError().text();
+        return;
+    }
+
+    QList<Node> leaf_list {};
+    Node node {};
+
+    while (query.next()) {
+        ReadNodeQuery(&node, query);
+
+        if (node.type == kTypeLeaf)
+            leaf_list.emplaceBack(node);
+    }
 
     query.prepare(string);
 
-    if (!text.isEmpty())
-        query.bindValue(QStringLiteral(":text"), QStringLiteral("%%%1%").arg(text));
+    for (auto& leaf : leaf_list) {
+        const double initial_total { leaf.initial_total };
+        const double final_total { leaf.final_total };
 
+        query.bindValue(QStringLiteral(":node_id"), leaf.id);
+        if (!query.exec()) {
+            qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in CheckLeafTotalFPT" << query.lastError().text();
+            return;
+        }
+
+        CalculateLeafTotal(&leaf, query);
+        query.finish();
+
+        const bool initial_drift { std::abs(leaf.initial_total - initial_total) > kTolerance };
+        const bool final_drift { std::abs(leaf.final_total - final_total) > kTolerance };
+
+        if (initial_drift)
+            result.issue_list.emplaceBack(IntegrityIssue { info_.section, IntegrityKind::kLeafInitial, leaf.id, 0, initial_total, leaf.initial_total });
+
+        if (final_drift)
+            result.issue_list.emplaceBack(IntegrityIssue { info_.section, IntegrityKind::kLeafFinal, leaf.id, 0, final_total, leaf.final_total });
+
+        if (initial_drift || final_drift)
+            result.leaf_hash.insert(leaf.id, { leaf.initial_total, leaf.final_total });
+    }
+}
+
+void Sqlite::CheckClosure(IntegrityResult& result, QSqlDatabase& db) const
+{
+    QSqlQuery query(db);
+    query.setForwardOnly(true);
+
+    // removed nodes keep only their self row
+    QHash<int, bool> live_hash {};
+
+    query.prepare(QStringLiteral("SELECT id, removed FROM %1").arg(info_.node));
     if (!query.exec()) {
-        qWarning() << "Failed in SearchNodeName" << query.lastError().text();
-        return {};
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in CheckClosure 1st" << query.lastError().text();
+        return;
     }
 
-    int node_id {};
-    QList<int> node_list {};
+    while (query.next())
+        live_hash.insert(query.value(QStringLiteral("id")).toInt(), !query.value(QStringLiteral("removed")).toBool());
+
+    // rowid order, so the first parent row wins the same way ReadRelationship keeps it
+    if (lineage_)
+        query.prepare(QStringLiteral("SELECT id, parent, lineage FROM %1").arg(info_.node));
+    else
+        query.prepare(QStringLiteral("SELECT ancestor, descendant, distance FROM %1 ORDER BY rowid").arg(info_.path));
+
+    if (!query.exec()) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in CheckClosure 2nd" << query.lastError().text();
+        return;
+    }
+
+    QHash<int, QMap<int, QList<int>>> stored_hash {};
+    QHash<int, int> parent_hash {};
+    QHash<int, QList<int>> extra_parent_hash {};
+
+    // each lineage unfolds into the closure rows it stands for, the parent column is what ReadRelationship follows
+    while (lineage_ && query.next()) {
+        const int descendant { query.value(QStringLiteral("id")).toInt() };
+        const int parent { query.value(kParent).toInt() };
+        const auto segment_list { query.value(kLineage).toString().split(QLatin1Char('/'), Qt::SkipEmptyParts) };
+
+        for (qsizetype index = 0; index != segment_list.size(); ++index)
+            stored_hash[descendant][segment_list.at(index).toInt()].emplaceBack(segment_list.size() - 1 - index);
+
+        if (parent >= 1 && parent != descendant && live_hash.value(parent) && live_hash.value(descendant))
+            parent_hash.insert(descendant, parent);
+    }
+
+    while (!lineage_ && query.next()) {
+        const int ancestor { query.value(QStringLiteral("ancestor")).toInt() };
+        const int descendant { query.value(QStringLiteral("descendant")).toInt() };
+        const int distance { query.value(QStringLiteral("distance")).toInt() };
+
+        stored_hash[descendant][ancestor].emplaceBack(distance);
+
+        if (distance != 1 || ancestor == descendant || !live_hash.value(ancestor) || !live_hash.value(descendant))
+            continue;
+
+        if (parent_hash.contains(descendant))
+            extra_parent_hash[descendant].emplaceBack(ancestor);
+        else
+            parent_hash.insert(descendant, ancestor);
+    }
+
+    QSet<int> descendant_set { live_hash.keyBegin(), live_hash.keyEnd() };
+    descendant_set.unite(QSet<int> { stored_hash.keyBegin(), stored_hash.keyEnd() });
+
+    for (int descendant : std::as_const(descendant_set)) {
+        QList<std::pair<int, int>> expected_list {};
+
+        if (live_hash.contains(descendant))
+            expected_list.emplaceBack(descendant, 0);
+
+        if (live_hash.value(descendant)) {
+            int distance { 1 };
+
+            for (auto it = parent_hash.constFind(descendant); it != parent_hash.constEnd(); it = parent_hash.constFind(it.value())) {
+                // a loop in the parent rows, the chain stops where it closes
+                if (std::ranges::any_of(expected_list, [&](const auto& row) { return row.first == it.value(); })) {
+                    result.issue_list.emplaceBack(IntegrityIssue { info_.section, IntegrityKind::kParent, descendant, it.value(), QVariant(), QVariant() });
+                    break;
+                }
+
+                expected_list.emplaceBack(it.value(), distance++);
+            }
+        }
+
+        const auto stored_map { stored_hash.value(descendant) };
+        const auto extra_parent_list { extra_parent_hash.value(descendant) };
+
+        QMap<int, int> expected_map {};
+        for (const auto& [ancestor, distance] : std::as_const(expected_list))
+            expected_map.insert(ancestor, distance);
+
+        QSet<int> ancestor_set { expected_map.keyBegin(), expected_map.keyEnd() };
+        ancestor_set.unite(QSet<int> { stored_map.keyBegin(), stored_map.keyEnd() });
+
+        bool failed { false };
+
+        for (int ancestor : std::as_const(ancestor_set)) {
+            const auto stored_list { stored_map.value(ancestor) };
+            auto expected { expected_map.constFind(ancestor) };
+
+            if (expected != expected_map.constEnd() && stored_list == QList<int> { expected.value() })
+                continue;
+
+            failed = true;
+
+            const QVariant expected_value { expected == expected_map.constEnd() ? QVariant() : QVariant(expected.value()) };
+            QVariant stored_value {};
+
+            if (stored_list.size() == 1)
+                stored_value = stored_list.first();
+            else if (stored_list.size() >= 2) {
+                QStringList distance_list {};
+                for (int distance : stored_list)
+                    distance_list.emplaceBack(QString::number(distance));
+
+                stored_value = distance_list.join(QStringLiteral(", "));
+            }
+
+            IntegrityKind kind { IntegrityKind::kPath };
+
+            if (ancestor == descendant)
+                kind = IntegrityKind::kSelfRow;
+            else if (extra_parent_list.contains(ancestor))
+                kind = IntegrityKind::kParent;
+
+            result.issue_list.emplaceBack(IntegrityIssue { info_.section, kind, descendant, ancestor, stored_value, expected_value });
+        }
+
+        if (failed)
+            result.path_hash.insert(descendant, expected_list);
+    }
+}
+
+bool Sqlite::RepairIntegrity(const IntegrityResult& result) const
+{
+    if (result.leaf_hash.isEmpty() && result.path_hash.isEmpty())
+        return true;
+
+    QSqlQuery query(*db_);
+
+    CString delete_string { QStringLiteral("DELETE FROM %1 WHERE descendant = :descendant").arg(info_.path) };
+    CString insert_string { QStringLiteral("INSERT INTO %1 (ancestor, descendant, distance) VALUES (:ancestor, :descendant, :distance)").arg(info_.path) };
+    CString lineage_string { QStringLiteral("UPDATE %1 SET parent = :parent, lineage = :lineage WHERE id = :descendant").arg(info_.node) };
+
+    if (!DBTransaction([&]() {
+            Node node {};
+            node.type = kTypeLeaf;
+
+            for (auto it = result.leaf_hash.cbegin(); it != result.leaf_hash.cend(); ++it) {
+                node.id = it.key();
+                node.initial_total = it->first;
+                node.final_total = it->second;
+
+                if (!UpdateNodeValue(&node))
+                    return false;
+            }
+
+            for (auto it = result.path_hash.cbegin(); it != result.path_hash.cend() && lineage_; ++it) {
+                // the expected rows run from the node itself up to its top ancestor
+                QStringList segment_list {};
+                QVariant parent {};
+
+                for (const auto& [ancestor, distance] : it.value()) {
+                    segment_list.prepend(QString::number(ancestor));
+
+                    if (distance == 1)
+                        parent = ancestor;
+                }
+
+                if (segment_list.isEmpty())
+                    continue;
+
+                query.prepare(lineage_string);
+                query.bindValue(QStringLiteral(":parent"), parent);
+                query.bindValue(QStringLiteral(":lineage"), QLatin1Char('/') + segment_list.join(QLatin1Char('/')) + QLatin1Char('/'));
+                query.bindValue(QStringLiteral(":descendant"), it.key());
+
+                if (!query.exec()) {
+                    qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in RepairIntegrity 3rd" << query.lastError().text();
+                    return false;
+                }
+            }
+
+            for (auto it = result.path_hash.cbegin(); it != result.path_hash.cend() && !lineage_; ++it) {
+                query.prepare(delete_string);
+                query.bindValue(QStringLiteral(":descendant"), it.key());
+
+                if (!query.exec()) {
+                    qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in RepairIntegrity 1st" << query.lastError().text();
+                    return false;
+                }
+
+                query.prepare(insert_string);
+
+                for (const auto& [ancestor, distance] : it.value()) {
+                    query.bindValue(QStringLiteral(":ancestor"), ancestor);
+                    query.bindValue(QStringLiteral(":descendant"), it.key());
+                    query.bindValue(QStringLiteral(":distance"), distance);
+
+                    if (!query.exec()) {
+                        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in RepairIntegrity 2nd" << query.lastError().text();
+                        return false;
+                    }
+                }
+            }
+
+            return true;
+        })) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in RepairIntegrity commit";
+        return false;
+    }
+
+    return true;
+}
+
+bool Sqlite::BalanceHistoryFPT(QList<BalancePoint>& point_list, int node_id, bool rule, BalancePeriod period, const QDate& start_date, const QDate& end_date) const
+{
+    QSqlQuery query(*db_);
+    query.setForwardOnly(true);
+
+    CString string { QSBalanceHistoryFPT(period) };
+    query.prepare(string);
+    query.bindValue(QStringLiteral(":node_id"), node_id);
+    query.bindValue(QStringLiteral(":start_date"), start_date.toString(kDateFST));
+    query.bindValue(QStringLiteral(":end_date"), end_date.toString(kDateFST));
+    query.bindValue(QStringLiteral(":next_date"), end_date.addDays(1).toString(kDateFST));
+
+    if (!query.exec()) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in BalanceHistoryFPT" << query.lastError().text();
+        return false;
+    }
+
+    // same sign as TableModelUtils::Balance
+    const int coefficient { rule ? 1 : -1 };
+    BalancePoint point {};
+
+    point_list.clear();
 
     while (query.next()) {
-        node_id = query.value(QStringLiteral("id")).toInt();
-        node_list.emplaceBack(node_id);
+        point.date = query.value(QStringLiteral("period")).toString();
+        point.count = query.value(QStringLiteral("count")).toInt();
+        point.change = coefficient * query.value(QStringLiteral("change")).toDouble();
+        point.balance = coefficient * query.value(QStringLiteral("balance")).toDouble();
+
+        point_list.emplaceBack(point);
     }
 
-    return node_list;
+    return true;
 }
 
 bool Sqlite::RemoveNode(int node_id, int node_type) const
@@ -431,12 +864,9 @@ bool Sqlite::RemoveNode(int node_id, int node_type) const
 
 void Sqlite::ReplaceSupportFunction(int old_support_id, int new_support_id)
 {
-    const auto& const_trans_hash { std::as_const(trans_hash_) };
-
-    for (auto* trans : const_trans_hash) {
-        if (trans->support_id == old_support_id) {
-            trans->support_id = new_support_id;
-        }
+    for (auto* trans : IndexedTrans(support_index_, old_support_id)) {
+        trans->support_id = new_support_id;
+        IndexTrans(trans);
     }
 }
 
@@ -452,6 +882,24 @@ QString Sqlite::QSRemoveNodeFirst() const
 
 QString Sqlite::QSRemoveBranch() const
 {
+    // the branch's descendants move up one level, one range update on the lineage index
+    if (lineage_)
+        return QStringLiteral(R"(
+            WITH removed_node AS (
+                SELECT n.parent, n.lineage AS old_prefix, COALESCE(p.lineage, '/') AS new_prefix
+                FROM %1 AS n
+                LEFT JOIN %1 AS p ON p.id = n.parent
+                WHERE n.id = :node_id
+            )
+            UPDATE %1
+            SET
+                lineage = (SELECT new_prefix FROM removed_node) || substr(lineage, length((SELECT old_prefix FROM removed_node)) + 1),
+                parent = CASE WHEN parent = :node_id THEN (SELECT parent FROM removed_node) ELSE parent END
+            WHERE lineage > (SELECT old_prefix FROM removed_node)
+            AND lineage < (SELECT substr(old_prefix, 1, length(old_prefix) - 1) || '0' FROM removed_node)
+            )")
+            .arg(info_.node);
+
     return QStringLiteral(R"(
             WITH related_nodes AS (
                 SELECT DISTINCT fp1.ancestor, fp2.descendant
@@ -469,6 +917,10 @@ QString Sqlite::QSRemoveBranch() const
 
 QString Sqlite::QSRemoveNodeThird() const
 {
+    // like the self row a closure table keeps, a removed node's lineage is itself alone
+    if (lineage_)
+        return QStringLiteral("UPDATE %1 SET parent = NULL, lineage = '/' || id || '/' WHERE id = :node_id").arg(info_.node);
+
     return QStringLiteral("DELETE FROM %1 WHERE (descendant = :node_id OR ancestor = :node_id) AND distance !=0").arg(info_.path);
 }
 
@@ -500,8 +952,81 @@ QString Sqlite::QSDragNodeSecond() const
         .arg(info_.path);
 }
 
+QString Sqlite::QSDragLineage() const
+{
+    return QStringLiteral(R"(
+            UPDATE %1
+            SET
+                lineage = :new_prefix || substr(lineage, length(:old_prefix) + 1),
+                parent = CASE WHEN id = :node_id THEN :parent ELSE parent END
+            WHERE lineage >= :old_prefix AND lineage < :old_upper
+            )")
+        .arg(info_.node);
+}
+
+QString Sqlite::QSBalanceHistoryFPT(BalancePeriod period) const
+{
+    // period end date, the last period is cut at :end_date
+    QString key {};
+
+    switch (period) {
+    case BalancePeriod::kDay:
+        key = QStringLiteral("date(date_time)");
+        break;
+    case BalancePeriod::kWeek:
+        key = QStringLiteral("date(date_time, 'weekday 0')");
+        break;
+    case BalancePeriod::kMonth:
+        key = QStringLiteral("date(date_time, 'start of month', '+1 month', '-1 day')");
+        break;
+    }
+
+    // both node sides run on index (node, date_time), the running total is summed over periods rather than rows
+    return QStringLiteral(R"(
+    WITH node_trans AS (
+        SELECT date_time, lhs_debit AS debit, lhs_credit AS credit
+        FROM %1
+        WHERE lhs_node = :node_id AND date_time < :next_date AND removed = 0
+
+        UNION ALL
+
+        SELECT date_time, rhs_debit, rhs_credit
+        FROM %1
+        WHERE rhs_node = :node_id AND date_time < :next_date AND removed = 0
+    ),
+    period_change AS (
+        SELECT MIN(%2, :end_date) AS period, COUNT(*) AS count, SUM(credit) - SUM(debit) AS change
+        FROM node_trans
+        GROUP BY period
+    ),
+    period_balance AS (
+        SELECT period, count, change, SUM(change) OVER (ORDER BY period ROWS UNBOUNDED PRECEDING) AS balance
+        FROM period_change
+    )
+    SELECT period, count, change, balance
+    FROM period_balance
+    WHERE period >= :start_date
+    ORDER BY period
+    )")
+        .arg(info_.transaction, key);
+}
+
+QString Sqlite::QSOpeningBalanceFPT() const
+{
+    return QStringLiteral(R"(
+    SELECT
+        (SELECT COALESCE(SUM(lhs_credit) - SUM(lhs_debit), 0) FROM %1 WHERE lhs_node = :node_id AND date_time < :start_date AND removed = 0)
+      + (SELECT COALESCE(SUM(rhs_credit) - SUM(rhs_debit), 0) FROM %1 WHERE rhs_node = :node_id AND date_time < :start_date AND removed = 0)
+        AS balance
+    )")
+        .arg(info_.transaction);
+}
+
 bool Sqlite::DragNode(int destination_node_id, int node_id) const
 {
+    if (lineage_)
+        return DragLineage(destination_node_id, node_id);
+
     QSqlQuery query(*db_);
 
     CString& string_first { QSDragNodeFirst() };
@@ -537,6 +1062,59 @@ bool Sqlite::DragNode(int destination_node_id, int node_id) const
     return true;
 }
 
+bool Sqlite::DragLineage(int destination_node_id, int node_id) const
+{
+    QSqlQuery query(*db_);
+
+    query.prepare(QStringLiteral("SELECT id, lineage FROM %1 WHERE id IN (:node_id, :destination_node_id)").arg(info_.node));
+    query.bindValue(QStringLiteral(":node_id"), node_id);
+    query.bindValue(QStringLiteral(":destination_node_id"), destination_node_id);
+
+    if (!query.exec()) {
+        qWarning() << "Failed in DragLineage 1st" << query.lastError().text();
+        return false;
+    }
+
+    QString old_prefix {};
+    QString parent_prefix { QStringLiteral("/") };
+
+    while (query.next()) {
+        if (query.value(QStringLiteral("id")).toInt() == node_id)
+            old_prefix = query.value(kLineage).toString();
+        else
+            parent_prefix = query.value(kLineage).toString();
+    }
+
+    // a node never moves below itself
+    if (old_prefix.isEmpty() || parent_prefix.startsWith(old_prefix))
+        return false;
+
+    // '0' sorts right after '/', so the range holds the node and every lineage below it
+    const QString old_upper { old_prefix.chopped(1) + QLatin1Char('0') };
+    const QString new_prefix { parent_prefix + QString::number(node_id) + QLatin1Char('/') };
+
+    if (!DBTransaction([&]() {
+            query.prepare(QSDragLineage());
+            query.bindValue(QStringLiteral(":new_prefix"), new_prefix);
+            query.bindValue(QStringLiteral(":old_prefix"), old_prefix);
+            query.bindValue(QStringLiteral(":old_upper"), old_upper);
+            query.bindValue(QStringLiteral(":node_id"), node_id);
+            query.bindValue(QStringLiteral(":parent"), destination_node_id >= 1 ? QVariant(destination_node_id) : QVariant());
+
+            if (!query.exec()) {
+                qWarning() << "Failed in DragLineage 2nd" << query.lastError().text();
+                return false;
+            }
+
+            return true;
+        })) {
+        qWarning() << "Failed in DragLineage";
+        return false;
+    }
+
+    return true;
+}
+
 bool Sqlite::InternalReference(int node_id) const
 {
     CString& string { QSInternalReference() };
@@ -602,6 +1180,11 @@ bool Sqlite::SupportReferenceFPTS(int support_id) const
 
 bool Sqlite::ReadNodeTrans(TransShadowList& trans_shadow_list, int node_id)
 {
+    const TraceSpan span { "ReadNodeTrans", std::to_underlying(info_.section) };
+
+    if (ReadPrefetchTrans(trans_shadow_list, node_id))
+        return true;
+
     QSqlQuery query(*db_);
     query.setForwardOnly(true);
 
@@ -618,7 +1201,445 @@ bool Sqlite::ReadNodeTrans(TransShadowList& trans_shadow_list, int node_id)
     return true;
 }
 
-void Sqlite::ConvertTrans(Trans* trans, TransShadow* trans_shadow, bool left) const
+bool Sqlite::ReadNodeTransWindowFPT(TransShadowList& trans_shadow_list, int node_id, const QDate& start_date, const QDate& end_date)
+{
+    const TraceSpan span { "ReadNodeTransWindow", std::to_underlying(info_.section) };
+
+    const QString start { start_date.toString(kDateFST) };
+    const QString next { end_date.addDays(1).toString(kDateFST) };
+
+    // a ledger prefetched in full is cut down to the window instead of read again
+    if (ReadPrefetchTrans(trans_shadow_list, node_id, [&start, &next](const Trans* trans) { return trans->date_time >= start && trans->date_time < next; }))
+        return true;
+
+    QSqlQuery query(*db_);
+    query.setForwardOnly(true);
+
+    CString string { QSReadNodeTransWindowFPT() };
+    if (string.isEmpty())
+        return false;
+
+    query.prepare(string);
+    query.bindValue(QStringLiteral(":node_id"), node_id);
+    query.bindValue(QStringLiteral(":start_date"), start);
+    query.bindValue(QStringLiteral(":next_date"), next);
+
+    if (!query.exec()) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in ReadNodeTransWindowFPT" << query.lastError().text();
+        return false;
+    }
+
+    ReadTransFunction(trans_shadow_list, node_id, query);
+    return true;
+}
+
+bool Sqlite::OpeningBalanceFPT(double& balance, int node_id, bool rule, const QDate& start_date) const
+{
+    QSqlQuery query(*db_);
+    query.setForwardOnly(true);
+
+    CString string { QSOpeningBalanceFPT() };
+    query.prepare(string);
+    query.bindValue(QStringLiteral(":node_id"), node_id);
+    query.bindValue(QStringLiteral(":start_date"), start_date.toString(kDateFST));
+
+    if (!query.exec()) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in OpeningBalanceFPT" << query.lastError().text();
+        return false;
+    }
+
+    balance = query.next() ? (rule ? 1 : -1) * query.value(QStringLiteral("balance")).toDouble() : 0.0;
+    return true;
+}
+
+void Sqlite::PrefetchNodeTrans(int node_id)
+{
+    // At most one read in flight per section, so the worker never queues up behind foreground queries
+    if (node_id <= 0 || prefetch_node_id_ != 0 || prefetch_hash_.contains(node_id))
+        return;
+
+    const long long total_changes { TotalChanges() };
+    if (total_changes < 0)
+        return;
+
+    prefetch_node_id_ = node_id;
+
+    CString string { QSReadNodeTrans() };
+    CString file_path { db_->databaseName() };
+    CString connection { QStringLiteral("prefetch_%1").arg(std::to_underlying(info_.section)) };
+
+    auto future { QtConcurrent::run([this, string, file_path, connection, node_id]() { return ReadTransWorker(connection, file_path, string, node_id); }) };
+
+    auto* watcher { new QFutureWatcher<QList<Trans*>>(this) };
+    connect(watcher, &QFutureWatcher<QList<Trans*>>::finished, this, [this, watcher, node_id, total_changes]() {
+        auto trans_list { watcher->result() };
+        watcher->deleteLater();
+
+        prefetch_node_id_ = 0;
+        InsertPrefetchTrans(node_id, total_changes, trans_list);
+    });
+
+    watcher->setFuture(future);
+}
+
+QList<Trans*> Sqlite::ReadTransWorker(CString& connection, CString& file_path, CString& string, int node_id) const
+{
+    QList<Trans*> trans_list {};
+
+    {
+        auto db { QSqlDatabase::addDatabase(kQSQLITE, connection) };
+        db.setDatabaseName(file_path);
+        db.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY"));
+
+        if (!db.open()) {
+            qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed to open worker connection" << db.lastError().text();
+        } else {
+            QSqlQuery query(db);
+            query.setForwardOnly(true);
+            query.prepare(string);
+            query.bindValue(QStringLiteral(":node_id"), node_id);
+
+            if (!query.exec()) {
+                qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in ReadTransWorker" << query.lastError().text();
+            } else {
+                while (query.next()) {
+                    auto* trans { ResourcePool<Trans>::Instance().Allocate() };
+                    trans->id = query.value(QStringLiteral("id")).toInt();
+
+                    ReadTransQuery(trans, query);
+                    trans_list.emplaceBack(trans);
+                }
+            }
+        }
+    }
+
+    QSqlDatabase::removeDatabase(connection);
+    return trans_list;
+}
+
+void Sqlite::InsertPrefetchTrans(int node_id, long long total_changes, QList<Trans*>& trans_list)
+{
+    if (trans_list.isEmpty())
+        return;
+
+    prefetch_hash_.insert(node_id, TransPrefetch { total_changes, trans_list });
+    prefetch_queue_.emplaceBack(node_id);
+
+    // Only prefetched lists are dropped over budget, trans_hash_ which backs opened tables is never touched
+    while (prefetch_queue_.size() > kPrefetchBudget) {
+        auto prefetch { prefetch_hash_.take(prefetch_queue_.takeFirst()) };
+        ResourcePool<Trans>::Instance().Recycle(prefetch.trans_list);
+    }
+}
+
+bool Sqlite::ReadPrefetchTrans(TransShadowList& trans_shadow_list, int node_id, const std::function<bool(const Trans*)>& keep)
+{
+    if (!prefetch_hash_.contains(node_id))
+        return false;
+
+    auto prefetch { prefetch_hash_.take(node_id) };
+    prefetch_queue_.removeOne(node_id);
+
+    // Any write since the read started may have moved trans into or out of this node
+    if (prefetch.total_changes != TotalChanges()) {
+        ResourcePool<Trans>::Instance().Recycle(prefetch.trans_list);
+        return false;
+    }
+
+    for (auto* trans : std::as_const(prefetch.trans_list)) {
+        if (keep && !keep(trans)) {
+            ResourcePool<Trans>::Instance().Recycle(trans);
+            continue;
+        }
+
+        auto* shared_trans { trans };
+
+        if (auto it = trans_hash_.constFind(trans->id); it != trans_hash_.constEnd()) {
+            shared_trans = it.value();
+            ResourcePool<Trans>::Instance().Recycle(trans);
+        } else {
+            InsertTrans(trans);
+        }
+
+        auto* trans_shadow { ResourcePool<TransShadow>::Instance().Allocate() };
+        ConvertTrans(shared_trans, trans_shadow, node_id == shared_trans->lhs_node);
+        trans_shadow_list.emplaceBack(trans_shadow);
+    }
+
+    return true;
+}
+
+void Sqlite::AppendMemoryStat(QList<MemoryStat>& stat_list) const
+{
+    constexpr qsizetype entry { sizeof(int) + sizeof(Trans*) };
+
+    qsizetype bytes { trans_hash_.size() * entry };
+    for (const auto* trans : trans_hash_)
+        bytes += trans->Bytes();
+
+    stat_list.emplaceBack(MemoryStat { tr("Trans"), trans_hash_.size(), bytes });
+
+    qsizetype count {};
+    bytes = prefetch_hash_.size() * qsizetype(sizeof(int) + sizeof(TransPrefetch));
+
+    for (const auto& prefetch : prefetch_hash_) {
+        count += prefetch.trans_list.size();
+        bytes += prefetch.trans_list.capacity() * qsizetype(sizeof(Trans*));
+
+        for (const auto* trans : prefetch.trans_list)
+            bytes += trans->Bytes();
+    }
+
+    stat_list.emplaceBack(MemoryStat { tr("Prefetched Trans"), count, bytes });
+
+    count = 0;
+    bytes = (node_index_.size() + support_index_.size()) * qsizetype(sizeof(int) + sizeof(QSet<int>));
+
+    for (const auto& set : node_index_)
+        count += set.size();
+
+    for (const auto& set : support_index_)
+        count += set.size();
+
+    bytes += count * qsizetype(2 * sizeof(int)) + indexed_key_.size() * qsizetype(sizeof(int) + sizeof(IndexedKey));
+    stat_list.emplaceBack(MemoryStat { tr("Trans Index"), count, bytes });
+}
+
+void Sqlite::TrimCache()
+{
+    // a read still running inserts its list when it lands, that is one node within kPrefetchBudget
+    for (auto& prefetch : prefetch_hash_)
+        ResourcePool<Trans>::Instance().Recycle(prefetch.trans_list);
+
+    prefetch_hash_.clear();
+    prefetch_queue_.clear();
+}
+
+QFuture<void> Sqlite::SearchAllAsync(CString& text, const QList<int>& party_id_list, SearchCancel cancel, std::function<void(const QList<SearchHit>&, bool)> function)
+{
+    CString file_path { db_->databaseName() };
+    CString connection { QStringLiteral("search_all_%1_%2").arg(std::to_underlying(info_.section)).arg(++search_serial_) };
+
+    return QtConcurrent::run(
+        [this, connection, file_path, text, party_id_list, cancel, function]() { SearchAllWorker(connection, file_path, text, party_id_list, cancel, function); });
+}
+
+void Sqlite::SearchAllWorker(
+    CString& connection, CString& file_path, CString& text, const QList<int>& party_id_list, SearchCancel cancel, std::function<void(const QList<SearchHit>&, bool)> function)
+{
+    const TraceSpan span { "SearchAll", std::to_underlying(info_.section) };
+
+    auto Deliver = [this, cancel, function](const QList<SearchHit>& chunk, bool finished) {
+        QMetaObject::invokeMethod(
+            this,
+            [cancel, function, chunk, finished]() {
+                if (!cancel->load())
+                    function(chunk, finished);
+            },
+            Qt::QueuedConnection);
+    };
+
+    QList<SearchHit> chunk {};
+
+    auto Append = [&](SearchHit&& hit) {
+        chunk.emplaceBack(std::move(hit));
+
+        if (chunk.size() == kSearchChunk) {
+            Deliver(chunk, false);
+            chunk.clear();
+        }
+    };
+
+    {
+        auto db { QSqlDatabase::addDatabase(kQSQLITE, connection) };
+        db.setDatabaseName(file_path);
+        db.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY"));
+
+        if (!db.open()) {
+            qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed to open worker connection" << db.lastError().text();
+        } else {
+            QSqlQuery query(db);
+            query.setForwardOnly(true);
+
+            QString string { QStringLiteral("SELECT id, name, code FROM %1 WHERE removed = 0 AND (name LIKE :text OR code LIKE :text OR description LIKE :text").arg(info_.node) };
+            if (!party_id_list.isEmpty())
+                string.append(QStringLiteral(" OR party IN (SELECT value FROM json_each(:id_list))"));
+            string.append(u')');
+
+            query.prepare(string);
+            query.bindValue(QStringLiteral(":text"), QStringLiteral("%%%1%").arg(text));
+            if (!party_id_list.isEmpty())
+                query.bindValue(QStringLiteral(":id_list"), JsonIdList(party_id_list));
+
+            if (!query.exec()) {
+                qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in SearchAllWorker node" << query.lastError().text();
+            } else {
+                while (!cancel->load() && query.next()) {
+                    SearchHit hit { .section = info_.section, .node = true };
+                    hit.id = query.value(QStringLiteral("id")).toInt();
+                    hit.name = query.value(QStringLiteral("name")).toString();
+                    hit.code = query.value(QStringLiteral("code")).toString();
+                    hit.rank = SearchRank(text, hit.name, hit.code);
+
+                    Append(std::move(hit));
+                }
+            }
+
+            // superseded while reading nodes, the trans scan is skipped
+            if (!cancel->load()) {
+                query.prepare(QSSearchTrans());
+                query.bindValue(QStringLiteral(":text"), text);
+                query.bindValue(QStringLiteral(":description"), QStringLiteral("%%%1%").arg(text));
+
+                if (!query.exec()) {
+                    qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in SearchAllWorker trans" << query.lastError().text();
+                } else {
+                    // one scratch Trans lets ReadTransQuery handle each section's columns
+                    auto* trans { ResourcePool<Trans>::Instance().Allocate() };
+
+                    while (!cancel->load() && query.next()) {
+                        ReadTransQuery(trans, query);
+
+                        SearchHit hit { .section = info_.section, .node = false };
+                        hit.id = query.value(QStringLiteral("id")).toInt();
+                        hit.lhs_node = trans->lhs_node;
+                        hit.rhs_node = trans->rhs_node;
+                        hit.name = trans->description;
+                        hit.code = trans->code;
+                        hit.date_time = trans->date_time;
+                        hit.rank = SearchRank(text, hit.name, hit.code);
+
+                        Append(std::move(hit));
+                    }
+
+                    ResourcePool<Trans>::Instance().Recycle(trans);
+                }
+            }
+        }
+    }
+
+    QSqlDatabase::removeDatabase(connection);
+    Deliver(chunk, true);
+}
+
+int Sqlite::SearchRank(CString& text, CString& name, CString& code) const
+{
+    if (name.compare(text, Qt::CaseInsensitive) == 0 || code.compare(text, Qt::CaseInsensitive) == 0)
+        return 0;
+
+    if (name.startsWith(text, Qt::CaseInsensitive) || code.startsWith(text, Qt::CaseInsensitive))
+        return 1;
+
+    if (name.contains(text, Qt::CaseInsensitive))
+        return 2;
+
+    return 3;
+}
+
+QString Sqlite::JsonIdList(const QList<int>& id_list) const
+{
+    QString string {};
+    string.reserve(id_list.size() * 8 + 2);
+    string.append(u'[');
+
+    for (int id : id_list) {
+        string.append(QString::number(id));
+        string.append(u',');
+    }
+
+    if (!id_list.isEmpty())
+        string.chop(1);
+
+    string.append(u']');
+    return string;
+}
+
+void Sqlite::InsertTrans(Trans* trans)
+{
+    trans_hash_.insert(trans->id, trans);
+    IndexTrans(trans);
+}
+
+void Sqlite::RecycleTrans(int trans_id)
+{
+    auto* trans { trans_hash_.take(trans_id) };
+
+    if (trans)
+        UnindexTrans(trans_id);
+
+    ResourcePool<Trans>::Instance().Recycle(trans);
+}
+
+void Sqlite::IndexTrans(const Trans* trans)
+{
+    if (!trans)
+        return;
+
+    const IndexedKey key { trans->lhs_node, trans->rhs_node, trans->support_id };
+
+    auto it { indexed_key_.constFind(trans->id) };
+    if (it != indexed_key_.constEnd() && *it == key)
+        return;
+
+    UnindexTrans(trans->id);
+
+    if (key.lhs_node != 0)
+        node_index_[key.lhs_node].insert(trans->id);
+
+    if (key.rhs_node != 0)
+        node_index_[key.rhs_node].insert(trans->id);
+
+    if (key.support_id != 0)
+        support_index_[key.support_id].insert(trans->id);
+
+    indexed_key_.insert(trans->id, key);
+}
+
+void Sqlite::UnindexTrans(int trans_id)
+{
+    const IndexedKey key { indexed_key_.take(trans_id) };
+
+    auto Unindex = [trans_id](QHash<int, QSet<int>>& index, int key) {
+        if (auto it = index.find(key); it != index.end() && it->remove(trans_id) && it->isEmpty())
+            index.erase(it);
+    };
+
+    Unindex(node_index_, key.lhs_node);
+    Unindex(node_index_, key.rhs_node);
+    Unindex(support_index_, key.support_id);
+}
+
+TransList Sqlite::IndexedTrans(const QHash<int, QSet<int>>& index, int key) const
+{
+    TransList trans_list {};
+
+    auto it { index.constFind(key) };
+    if (it == index.constEnd())
+        return trans_list;
+
+    trans_list.reserve(it->size());
+
+    for (int trans_id : *it) {
+        if (auto* trans { trans_hash_.value(trans_id) })
+            trans_list.emplaceBack(trans);
+    }
+
+    return trans_list;
+}
+
+long long Sqlite::TotalChanges() const
+{
+    QSqlQuery query(*db_);
+
+    if (!query.exec(QStringLiteral("SELECT total_changes()")) || !query.next()) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in TotalChanges" << query.lastError().text();
+        return -1;
+    }
+
+    return query.value(0).toLongLong();
+}
+
+void Sqlite::ConvertTrans(Trans* trans, TransShadow* trans_shadow, bool left)
 {
     trans_shadow->id = &trans->id;
     trans_shadow->state = &trans->state;
@@ -656,7 +1677,8 @@ bool Sqlite::WriteTrans(TransShadow* trans_shadow)
     }
 
     *trans_shadow->id = query.lastInsertId().toInt();
-    trans_hash_.insert(*trans_shadow->id, last_trans_);
+    InsertTrans(last_trans_);
+    TransChanged(last_trans_);
     return true;
 }
 
@@ -781,7 +1803,8 @@ bool Sqlite::RemoveTrans(int trans_id)
         return false;
     }
 
-    ResourcePool<Trans>::Instance().Recycle(trans_hash_.take(trans_id));
+    TransChanged(trans_hash_.value(trans_id));
+    RecycleTrans(trans_id);
     return true;
 }
 
@@ -807,8 +1830,11 @@ bool Sqlite::UpdateNodeValue(const Node* node) const
     return true;
 }
 
-bool Sqlite::UpdateTransValue(const TransShadow* trans_shadow) const
+bool Sqlite::UpdateTransValue(const TransShadow* trans_shadow)
 {
+    // the table may have moved the trans to another rhs_node before writing it, IndexTrans still has the old one
+    IndexTrans(trans_hash_.value(*trans_shadow->id));
+
     CString& string { QSUpdateTransValueFPTO() };
     if (string.isEmpty())
         return false;
@@ -826,8 +1852,12 @@ bool Sqlite::UpdateTransValue(const TransShadow* trans_shadow) const
     return true;
 }
 
-bool Sqlite::UpdateField(CString& table, CVariant& value, CString& field, int id) const
+bool Sqlite::UpdateField(CString& table, CVariant& value, CString& field, int id)
 {
+    // node, support and product columns are edited in place through the shadow, IndexTrans swaps the recorded old key for the new one
+    if (table == info_.transaction)
+        IndexTrans(trans_hash_.value(id));
+
     QSqlQuery query(*db_);
 
     auto part = QStringLiteral(R"(
@@ -846,6 +1876,9 @@ bool Sqlite::UpdateField(CString& table, CVariant& value, CString& field, int id
         return false;
     }
 
+    if (table == info_.transaction)
+        TransChanged(trans_hash_.value(id));
+
     return true;
 }
 
@@ -876,45 +1909,71 @@ bool Sqlite::UpdateState(Check state) const
     return true;
 }
 
-bool Sqlite::SearchTrans(TransList& trans_list, CString& text) const
+QFuture<void> Sqlite::SearchTransAsync(CString& text, SearchCancel cancel, std::function<void(TransList&, bool)> function)
 {
-    if (text.isEmpty())
-        return false;
-
-    QSqlQuery query(*db_);
-    query.setForwardOnly(true);
-
-    auto string { QSSearchTrans() };
-    query.prepare(string);
-
-    query.bindValue(QStringLiteral(":text"), text);
-    query.bindValue(QStringLiteral(":description"), QStringLiteral("%%%1%").arg(text));
-
-    if (!query.exec()) {
-        qWarning() << "Failed in Search Trans" << query.lastError().text();
-        return false;
-    }
+    CString file_path { db_->databaseName() };
+    CString connection { QStringLiteral("search_trans_%1_%2").arg(std::to_underlying(info_.section)).arg(++search_serial_) };
 
-    Trans* trans {};
-    int id {};
+    return QtConcurrent::run([this, connection, file_path, text, cancel, function]() { SearchTransWorker(connection, file_path, text, cancel, function); });
+}
 
-    while (query.next()) {
-        id = query.value(QStringLiteral("id")).toInt();
+void Sqlite::SearchTransWorker(CString& connection, CString& file_path, CString& text, SearchCancel cancel, std::function<void(TransList&, bool)> function)
+{
+    const TraceSpan span { "SearchTrans", std::to_underlying(info_.section) };
+
+    // A chunk that arrives after cancel goes straight back to the pool, otherwise function takes it over
+    auto Deliver = [this, cancel, function](const TransList& chunk, bool finished) {
+        QMetaObject::invokeMethod(
+            this,
+            [cancel, function, chunk, finished]() mutable {
+                if (cancel->load()) {
+                    ResourcePool<Trans>::Instance().Recycle(chunk);
+                    return;
+                }
+
+                function(chunk, finished);
+            },
+            Qt::QueuedConnection);
+    };
+
+    TransList chunk {};
+
+    {
+        auto db { QSqlDatabase::addDatabase(kQSQLITE, connection) };
+        db.setDatabaseName(file_path);
+        db.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY"));
+
+        if (!db.open()) {
+            qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed to open worker connection" << db.lastError().text();
+        } else if (!text.isEmpty()) {
+            QSqlQuery query(db);
+            query.setForwardOnly(true);
+            query.prepare(QSSearchTrans());
+
+            query.bindValue(QStringLiteral(":text"), text);
+            query.bindValue(QStringLiteral(":description"), QStringLiteral("%%%1%").arg(text));
 
-        if (auto it = trans_hash_.constFind(id); it != trans_hash_.constEnd()) {
-            trans = it.value();
-            trans_list.emplaceBack(trans);
-            continue;
+            if (!query.exec()) {
+                qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in SearchTransWorker" << query.lastError().text();
+            } else {
+                while (!cancel->load() && query.next()) {
+                    auto* trans { ResourcePool<Trans>::Instance().Allocate() };
+                    trans->id = query.value(QStringLiteral("id")).toInt();
+
+                    ReadTransQuery(trans, query);
+                    chunk.emplaceBack(trans);
+
+                    if (chunk.size() == kSearchChunk) {
+                        Deliver(chunk, false);
+                        chunk.clear();
+                    }
+                }
+            }
         }
-
-        trans = ResourcePool<Trans>::Instance().Allocate();
-        trans->id = id;
-
-        ReadTransQuery(trans, query);
-        trans_list.emplaceBack(trans);
     }
 
-    return true;
+    QSqlDatabase::removeDatabase(connection);
+    Deliver(chunk, true);
 }
 
 bool Sqlite::ReadTransRange(TransShadowList& trans_shadow_list, int node_id, const QList<int>& trans_id_list)
@@ -922,35 +1981,22 @@ bool Sqlite::ReadTransRange(TransShadowList& trans_shadow_list, int node_id, con
     if (trans_id_list.empty() || node_id <= 0)
         return false;
 
+    CString& string { QSReadTransRangeFPTS() };
+    if (string.isEmpty())
+        return false;
+
     QSqlQuery query(*db_);
     query.setForwardOnly(true);
 
-    const qsizetype batch_size { kBatchSize };
-    const auto total_batches { (trans_id_list.size() + batch_size - 1) / batch_size };
-
-    for (int batch_index = 0; batch_index != total_batches; ++batch_index) {
-        int start = batch_index * batch_size;
-        int end = std::min(start + batch_size, trans_id_list.size());
-
-        QList<int> current_batch { trans_id_list.mid(start, end - start) };
-
-        QStringList placeholder { current_batch.size(), QStringLiteral("?") };
-        QString string { QSReadTransRangeFPTS(placeholder.join(QStringLiteral(","))) };
-
-        query.prepare(string);
-
-        for (int i = 0; i != current_batch.size(); ++i)
-            query.bindValue(i, current_batch.at(i));
-
-        if (!query.exec()) {
-            qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in ReadTransRange, batch" << batch_index << ": "
-                       << query.lastError().text();
-            continue;
-        }
+    query.prepare(string);
+    query.bindValue(QStringLiteral(":id_list"), JsonIdList(trans_id_list));
 
-        ReadTransFunction(trans_shadow_list, node_id, query);
+    if (!query.exec()) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in ReadTransRange" << query.lastError().text();
+        return false;
     }
 
+    ReadTransFunction(trans_shadow_list, node_id, query);
     return true;
 }
 
@@ -997,15 +2043,24 @@ bool Sqlite::DBTransaction(std::function<bool()> function) const
 
 bool Sqlite::ReadRelationship(const NodeHash& node_hash, QSqlQuery& query) const
 {
+    const TraceSpan span { "ReadRelationship", std::to_underlying(info_.section) };
+
     if (node_hash.isEmpty())
         return false;
 
-    auto part = QStringLiteral(R"(
+    // with lineage_ the parent column is read instead, one row per live node
+    auto part = lineage_ ? QStringLiteral(R"(
+    SELECT parent AS ancestor, id AS descendant
+    FROM %1
+    WHERE parent IS NOT NULL AND removed = 0
+)")
+                               .arg(info_.node)
+                         : QStringLiteral(R"(
     SELECT ancestor, descendant
     FROM %1
     WHERE distance = 1
 )")
-                    .arg(info_.path);
+                               .arg(info_.path);
 
     query.prepare(part);
     if (!query.exec()) {
@@ -1037,6 +2092,24 @@ bool Sqlite::ReadRelationship(const NodeHash& node_hash, QSqlQuery& query) const
 
 bool Sqlite::WriteRelationship(int node_id, int parent_id, QSqlQuery& query) const
 {
+    if (lineage_) {
+        query.prepare(QStringLiteral(R"(
+    UPDATE %1
+    SET parent = :parent, lineage = COALESCE((SELECT lineage FROM %1 WHERE id = :parent), '/') || :node_id || '/'
+    WHERE id = :node_id
+)")
+                          .arg(info_.node));
+        query.bindValue(QStringLiteral(":node_id"), node_id);
+        query.bindValue(QStringLiteral(":parent"), parent_id >= 1 ? QVariant(parent_id) : QVariant());
+
+        if (!query.exec()) {
+            qWarning() << "Failed in WriteRelationship" << query.lastError().text();
+            return false;
+        }
+
+        return true;
+    }
+
     auto part = QStringLiteral(R"(
     INSERT INTO %1 (ancestor, descendant, distance)
     SELECT ancestor, :node_id, distance + 1 FROM %1
@@ -1076,7 +2149,7 @@ void Sqlite::ReadTransFunction(TransShadowList& trans_shadow_list, int node_id,
             trans->id = id;
 
             ReadTransQuery(trans, query);
-            trans_hash_.insert(id, trans);
+            InsertTrans(trans);
         }
 
         ConvertTrans(trans, trans_shadow, node_id == trans->lhs_node);
@@ -1084,13 +2157,12 @@ void Sqlite::ReadTransFunction(TransShadowList& trans_shadow_list, int node_id,
     }
 }
 
-QMultiHash<int, int> Sqlite::ReplaceNodeFunction(int old_node_id, int new_node_id) const
+QMultiHash<int, int> Sqlite::ReplaceNodeFunction(int old_node_id, int new_node_id)
 {
     // finance, product, task
-    const auto& const_trans_hash { std::as_const(trans_hash_) };
     QMultiHash<int, int> hash {};
 
-    for (auto* trans : const_trans_hash) {
+    for (auto* trans : IndexedTrans(node_index_, old_node_id)) {
         if (trans->lhs_node == old_node_id && trans->rhs_node != new_node_id) {
             hash.emplace(trans->rhs_node, trans->id);
             trans->lhs_node = new_node_id;
@@ -1100,6 +2172,8 @@ QMultiHash<int, int> Sqlite::ReplaceNodeFunction(int old_node_id, int new_node_i
             hash.emplace(trans->lhs_node, trans->id);
             trans->rhs_node = new_node_id;
         }
+
+        IndexTrans(trans);
     }
 
     return hash;
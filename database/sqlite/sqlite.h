@@ -20,8 +20,13 @@
 #ifndef SQLITE_H
 #define SQLITE_H
 
+#include <QDate>
+#include <QFuture>
 #include <QObject>
+#include <QSet>
 #include <QSqlDatabase>
+#include <atomic>
+#include <memory>
 
 #include "component/enumclass.h"
 #include "component/info.h"
@@ -29,6 +34,69 @@
 #include "table/trans.h"
 #include "tree/node.h"
 
+// Trans read ahead on a worker connection, total_changes is the main connection's counter when the read started
+struct TransPrefetch {
+    long long total_changes {};
+    QList<Trans*> trans_list {};
+};
+
+// The node and support keys one cached trans is filed under in node_index_ and support_index_
+struct IndexedKey {
+    int lhs_node {};
+    int rhs_node {};
+    int support_id {};
+
+    bool operator==(const IndexedKey&) const = default;
+};
+
+// Set once a search is superseded, the worker stops before its next row and chunks still queued are recycled
+using SearchCancel = std::shared_ptr<std::atomic_bool>;
+
+// One match of the all sections search, rank 0 is an exact name or code, 1 a prefix, 2 inside the name, 3 anywhere else
+struct SearchHit {
+    Section section {};
+    bool node {};
+    int rank {};
+    int id {};
+    int lhs_node {};
+    int rhs_node {};
+    QString name {};
+    QString code {};
+    QString date_time {};
+};
+
+// Balance at the end of one day, week or month, change is the net movement inside it
+struct BalancePoint {
+    QString date {};
+    int count {};
+    double change {};
+    double balance {};
+};
+
+// One finding of the integrity check, stored or expected is null when that side has no row
+struct IntegrityIssue {
+    Section section {};
+    IntegrityKind kind {};
+    int node_id {};
+    int ancestor_id {};
+    QVariant stored {};
+    QVariant expected {};
+};
+
+// What a repair writes: recomputed leaf totals, and the full closure rows of every descendant that failed a check
+struct IntegrityResult {
+    QList<IntegrityIssue> issue_list {};
+    QHash<int, std::pair<double, double>> leaf_hash {};
+    QHash<int, QList<std::pair<int, int>>> path_hash {};
+};
+
+// One line of the memory diagnostics, bytes is an estimate of the objects and the strings they own
+struct MemoryStat {
+    QString item {};
+    qsizetype count {};
+    qsizetype bytes {};
+};
+
 class Sqlite : public QObject {
     Q_OBJECT
 
@@ -73,23 +141,46 @@ public:
     bool SupportReferenceFPTS(int support_id) const;
     bool LeafTotal(Node* node) const;
     bool UpdateNodeValue(const Node* node) const;
-    QList<int> SearchNodeName(CString& text) const;
+    // Finance Product Task, period end balances of one leaf, trans before start_date only feed the first balance
+    bool BalanceHistoryFPT(QList<BalancePoint>& point_list, int node_id, bool rule, BalancePeriod period, const QDate& start_date, const QDate& end_date) const;
+    // Finance Product Task, rewrites every leaf whose stored total drifted from its trans, changed is the count of leaves written
+    bool RecomputeLeafTotalFPT(int& changed);
+    // checks stored leaf totals and the closure table on a worker thread with its own read-only connection
+    QFuture<IntegrityResult> CheckIntegrity() const;
+    bool RepairIntegrity(const IntegrityResult& result) const;
 
     // table
     bool ReadNodeTrans(TransShadowList& trans_shadow_list, int node_id);
+    // Finance Product Task, only the rows dated inside [start_date, end_date], each node side runs on index (node, date_time)
+    bool ReadNodeTransWindowFPT(TransShadowList& trans_shadow_list, int node_id, const QDate& start_date, const QDate& end_date);
+    // Finance Product Task, balance carried into start_date, same sign as TableModelUtils::Balance
+    bool OpeningBalanceFPT(double& balance, int node_id, bool rule, const QDate& start_date) const;
+    void PrefetchNodeTrans(int node_id);
     bool ReadSupportTransFPTS(TransShadowList& trans_shadow_list, int support_id);
     bool ReadTransRange(TransShadowList& trans_shadow_list, int node_id, const QList<int>& trans_id_list);
     bool WriteTrans(TransShadow* trans_shadow);
     bool WriteTransRangeO(const QList<TransShadow*>& list) const;
-    bool UpdateTransValue(const TransShadow* trans_shadow) const;
+    bool UpdateTransValue(const TransShadow* trans_shadow);
     TransShadow* AllocateTransShadow();
+    // points trans_shadow at trans, left when the shadow's node is the trans' lhs_node
+    static void ConvertTrans(Trans* trans, TransShadow* trans_shadow, bool left);
 
     bool RemoveTrans(int trans_id);
     bool UpdateState(Check state) const;
-    bool SearchTrans(TransList& trans_list, CString& text) const;
+    // QSSearchTrans on a worker connection, the chunks handed to function are owned by the receiver
+    QFuture<void> SearchTransAsync(CString& text, SearchCancel cancel, std::function<void(TransList&, bool)> function);
+    // nodes by name code or description then QSSearchTrans, one worker connection per section, orders also match party_id_list
+    QFuture<void> SearchAllAsync(CString& text, const QList<int>& party_id_list, SearchCancel cancel, std::function<void(const QList<SearchHit>&, bool)> function);
 
     // common
-    bool UpdateField(CString& table, CVariant& value, CString& field, int id) const;
+    bool UpdateField(CString& table, CVariant& value, CString& field, int id);
+    // memory diagnostics, TrimCache drops only what is rebuilt on demand, never the trans behind an open table
+    virtual void AppendMemoryStat(QList<MemoryStat>& stat_list) const;
+    virtual void TrimCache();
+
+    // document, owner is the owner row's table, info.node or info.transaction
+    QStringList ReadDocument(CString& owner, int owner_id) const;
+    bool WriteDocument(CString& owner, int owner_id, CStringList& document) const;
 
 protected:
     // QS means QueryString
@@ -122,12 +213,16 @@ protected:
     QString QSRemoveNodeThird() const;
     QString QSDragNodeFirst() const;
     QString QSDragNodeSecond() const;
+    QString QSDragLineage() const;
+    QString QSBalanceHistoryFPT(BalancePeriod period) const;
+    QString QSOpeningBalanceFPT() const;
 
     //
     void CalculateLeafTotal(Node* node, QSqlQuery& query) const;
     bool DBTransaction(std::function<bool()> function) const;
     bool ReadRelationship(const NodeHash& node_hash, QSqlQuery& query) const;
     bool WriteRelationship(int node_id, int parent_id, QSqlQuery& query) const;
+    bool DragLineage(int destination_node_id, int node_id) const;
 
     // table
     virtual QString QSReadNodeTrans() const = 0;
@@ -138,11 +233,8 @@ protected:
     virtual QString QSSupportTransToRemoveFPTS() const { return {}; }
     virtual QString QSReplaceNodeTransFPTS() const { return {}; }
     virtual QString QSReplaceSupportTransFPTS() const { return {}; }
-    virtual QString QSReadTransRangeFPTS(CString& in_list) const
-    {
-        Q_UNUSED(in_list);
-        return {};
-    }
+    virtual QString QSReadTransRangeFPTS() const { return {}; }
+    virtual QString QSReadNodeTransWindowFPT() const { return {}; }
 
     virtual QString QSUpdateTransValueFPTO() const { return {}; }
     virtual QString QSFreeViewFPT() const { return {}; }
@@ -156,27 +248,52 @@ protected:
         Q_UNUSED(trans_shadow);
         Q_UNUSED(query);
     }
-    virtual void UpdateProductReferenceSO(int old_node_id, int new_node_id) const
+    virtual void UpdateProductReferenceSO(int old_node_id, int new_node_id)
     {
         Q_UNUSED(old_node_id);
         Q_UNUSED(new_node_id);
     }
-    virtual void UpdateStakeholderReferenceO(int old_node_id, int new_node_id) const
+    virtual void UpdateStakeholderReferenceO(int old_node_id, int new_node_id)
     {
         Q_UNUSED(old_node_id);
         Q_UNUSED(new_node_id);
     }
+    // a table wrote, edited or is about to remove trans, it is still in trans_hash_
+    virtual void TransChanged(const Trans* trans) { Q_UNUSED(trans); }
 
     //
 
     virtual void ReadTransFunction(TransShadowList& trans_shadow_list, int node_id, QSqlQuery& query);
-    virtual QMultiHash<int, int> ReplaceNodeFunction(int old_node_id, int new_node_id) const;
+    virtual QMultiHash<int, int> ReplaceNodeFunction(int old_node_id, int new_node_id);
 
     //
-    void ConvertTrans(Trans* trans, TransShadow* trans_shadow, bool left) const;
+    // bound to :id_list and expanded by json_each, one statement for any list size
+    QString JsonIdList(const QList<int>& id_list) const;
+    // trans enter and leave trans_hash_ only through these two, so node_index_ and support_index_ follow
+    void InsertTrans(Trans* trans);
+    void RecycleTrans(int trans_id);
+    // files trans under its current nodes and support and takes it out of the keys it was filed under before,
+    // called again after any edit that may have moved it
+    void IndexTrans(const Trans* trans);
+    // cached trans filed under key, lhs_node and rhs_node share node_index_ so the caller still checks which side matches
+    TransList IndexedTrans(const QHash<int, QSet<int>>& index, int key) const;
+    void UnindexTrans(int trans_id);
+    // keep, when set, drops the prefetched trans it rejects, a date window reads only its part of the ledger
+    bool ReadPrefetchTrans(TransShadowList& trans_shadow_list, int node_id, const std::function<bool(const Trans*)>& keep = {});
+    void InsertPrefetchTrans(int node_id, long long total_changes, QList<Trans*>& trans_list);
+    // runs on a worker thread, reads QSReadNodeTrans of node_id through its own read-only connection
+    QList<Trans*> ReadTransWorker(CString& connection, CString& file_path, CString& string, int node_id) const;
+    void SearchTransWorker(CString& connection, CString& file_path, CString& text, SearchCancel cancel, std::function<void(TransList&, bool)> function);
+    void SearchAllWorker(
+        CString& connection, CString& file_path, CString& text, const QList<int>& party_id_list, SearchCancel cancel, std::function<void(const QList<SearchHit>&, bool)> function);
+    int SearchRank(CString& text, CString& name, CString& code) const;
+    IntegrityResult CheckIntegrityWorker(CString& connection, CString& file_path) const;
+    void CheckLeafTotalFPT(IntegrityResult& result, QSqlDatabase& db) const;
+    void CheckClosure(IntegrityResult& result, QSqlDatabase& db) const;
+    long long TotalChanges() const;
     QMultiHash<int, int> TransToRemove(int node_id, int target_node_type) const;
     QList<int> SupportTransToMoveFPTS(int support_id) const;
-    void RemoveSupportFunction(int support_id) const;
+    void RemoveSupportFunction(int support_id);
     void ReplaceSupportFunction(int old_support_id, int new_support_id);
     bool FreeView(int old_node_id, int new_node_id) const;
 
@@ -184,8 +301,25 @@ protected:
     QHash<int, Trans*> trans_hash_ {};
     Trans* last_trans_ {};
 
+    // secondary indexes over trans_hash_, trans id sets by lhs_node and rhs_node (inside product in stakeholder and orders)
+    // and by support_id (outside product), so a replace touches only the trans of the node it replaces
+    QHash<int, QSet<int>> node_index_ {};
+    QHash<int, QSet<int>> support_index_ {};
+    // the keys each trans is filed under, an in-place edit has overwritten the fields by the time IndexTrans runs
+    QHash<int, IndexedKey> indexed_key_ {};
+
+    QHash<int, TransPrefetch> prefetch_hash_ {};
+    QList<int> prefetch_queue_ {};
+    int prefetch_node_id_ {};
+    // keeps worker connection names unique while a cancelled search is still unwinding
+    int search_serial_ {};
+
     QSqlDatabase* db_ {};
     CInfo& info_;
+
+    // set when the node table carries parent and lineage columns (MainwindowSqlite::MigrateLineage), the path table is then gone
+    // lineage is the materialized path /1/5/12/, a subtree is the index range [lineage, lineage with its last '/' as '0')
+    bool lineage_ {};
 };
 
 #endif // SQLITE_H
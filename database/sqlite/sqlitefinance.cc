@@ -1,5 +1,6 @@
 #include "sqlitefinance.h"
 
+#include <QSqlError>
 #include <QSqlQuery>
 
 #include "component/constvalue.h"
@@ -48,7 +49,7 @@ void SqliteFinance::ReadTransQuery(Trans* trans, const QSqlQuery& query) const
 
     trans->code = query.value(QStringLiteral("code")).toString();
     trans->description = query.value(QStringLiteral("description")).toString();
-    trans->document = query.value(QStringLiteral("document")).toString().split(kSemicolon, Qt::SkipEmptyParts);
+    trans->document = query.value(QStringLiteral("document_count")).toInt();
     trans->date_time = query.value(QStringLiteral("date_time")).toString();
     trans->state = query.value(QStringLiteral("state")).toBool();
     trans->support_id = query.value(QStringLiteral("support_id")).toInt();
@@ -68,7 +69,6 @@ void SqliteFinance::WriteTransBind(TransShadow* trans_shadow, QSqlQuery& query)
     query.bindValue(QStringLiteral(":state"), *trans_shadow->state);
     query.bindValue(QStringLiteral(":description"), *trans_shadow->description);
     query.bindValue(QStringLiteral(":code"), *trans_shadow->code);
-    query.bindValue(QStringLiteral(":document"), trans_shadow->document->join(kSemicolon));
     query.bindValue(QStringLiteral(":support_id"), *trans_shadow->support_id);
 }
 
@@ -153,6 +153,189 @@ QString SqliteFinance::QSFreeViewFPT() const
     )");
 }
 
+bool SqliteFinance::TrialBalance(TrialHash& leaf_hash, const QDate& start_date, const QDate& end_date) const
+{
+    QSqlQuery query(*db_);
+    query.setForwardOnly(true);
+
+    CString string { QSTrialBalance() };
+    query.prepare(string);
+    query.bindValue(QStringLiteral(":start_date"), start_date.toString(kDateFST));
+    query.bindValue(QStringLiteral(":next_date"), end_date.addDays(1).toString(kDateFST));
+
+    if (!query.exec()) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in TrialBalance" << query.lastError().text();
+        return false;
+    }
+
+    TrialRow row {};
+
+    leaf_hash.clear();
+
+    while (query.next()) {
+        row.node_id = query.value(QStringLiteral("node")).toInt();
+        row.opening = query.value(QStringLiteral("opening")).toDouble();
+        row.debit = query.value(QStringLiteral("debit")).toDouble();
+        row.credit = query.value(QStringLiteral("credit")).toDouble();
+
+        leaf_hash.insert(row.node_id, row);
+    }
+
+    return true;
+}
+
+bool SqliteFinance::Revalue(QHash<int, std::pair<double, double>>& diff_hash, int unit, double rate, int gain_loss_node, CString& date_time)
+{
+    if (gain_loss_node <= 0)
+        return false;
+
+    struct Leaf {
+        int id {};
+        bool rule {};
+        double initial_total {};
+        double final_total {};
+    };
+
+    QList<Leaf> leaf_list {};
+    bool gain_loss_rule {};
+
+    QSqlQuery query(*db_);
+    query.setForwardOnly(true);
+
+    query.prepare(QStringLiteral("SELECT id, rule, initial_total, final_total FROM finance WHERE (unit = :unit OR id = :gain_loss_node) AND type = 0 AND removed = 0"));
+    query.bindValue(QStringLiteral(":unit"), unit);
+    query.bindValue(QStringLiteral(":gain_loss_node"), gain_loss_node);
+
+    if (!query.exec()) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in Revalue" << query.lastError().text();
+        return false;
+    }
+
+    while (query.next()) {
+        Leaf leaf { query.value(QStringLiteral("id")).toInt(), query.value(QStringLiteral("rule")).toBool(),
+            query.value(QStringLiteral("initial_total")).toDouble(), query.value(QStringLiteral("final_total")).toDouble() };
+
+        if (leaf.id == gain_loss_node)
+            gain_loss_rule = leaf.rule;
+        else
+            leaf_list.emplaceBack(leaf);
+    }
+
+    diff_hash.clear();
+    QMultiHash<int, int> node_trans {};
+
+    // Historical ratios stay as booked. Each leaf gets an adjusting entry of rate * foreign balance - base balance against gain_loss_node.
+    // A side's base amount is ratio * foreign amount, so the entry is a pair of trans:
+    // one closes the foreign balance at its carrying rate, the other reopens it at rate.
+    auto WriteSide = [&](int node_id, double ratio, double foreign) {
+        // foreign and ratio * foreign are net debits, the gain/loss side takes the opposite base amount at ratio 1
+        const double base { ratio * foreign };
+
+        query.prepare(QSWriteNodeTrans());
+        query.bindValue(QStringLiteral(":date_time"), date_time);
+        query.bindValue(QStringLiteral(":lhs_node"), node_id);
+        query.bindValue(QStringLiteral(":lhs_ratio"), ratio);
+        query.bindValue(QStringLiteral(":lhs_debit"), std::max(foreign, 0.0));
+        query.bindValue(QStringLiteral(":lhs_credit"), std::max(-foreign, 0.0));
+        query.bindValue(QStringLiteral(":rhs_node"), gain_loss_node);
+        query.bindValue(QStringLiteral(":rhs_ratio"), 1.0);
+        query.bindValue(QStringLiteral(":rhs_debit"), std::max(-base, 0.0));
+        query.bindValue(QStringLiteral(":rhs_credit"), std::max(base, 0.0));
+        query.bindValue(QStringLiteral(":state"), false);
+        query.bindValue(QStringLiteral(":description"), tr("Revaluation"));
+        query.bindValue(QStringLiteral(":support_id"), 0);
+        query.bindValue(QStringLiteral(":code"), QString());
+
+        if (!query.exec()) {
+            qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in Revalue" << query.lastError().text();
+            return false;
+        }
+
+        node_trans.insert(node_id, query.lastInsertId().toInt());
+        return true;
+    };
+
+    auto UpdateTotal = [&](int node_id, double initial_diff, double final_diff) {
+        query.prepare(QStringLiteral("UPDATE finance SET initial_total = initial_total + :initial_diff, final_total = final_total + :final_diff WHERE id = :node_id"));
+        query.bindValue(QStringLiteral(":initial_diff"), initial_diff);
+        query.bindValue(QStringLiteral(":final_diff"), final_diff);
+        query.bindValue(QStringLiteral(":node_id"), node_id);
+
+        if (!query.exec()) {
+            qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in Revalue" << query.lastError().text();
+            return false;
+        }
+
+        diff_hash.insert(node_id, { initial_diff, final_diff });
+        return true;
+    };
+
+    auto Post = [&]() {
+        double gain_loss_debit {};
+
+        for (const auto& leaf : std::as_const(leaf_list)) {
+            // totals are sign * (credit - debit), turn them into net debits
+            const double sign { leaf.rule ? 1.0 : -1.0 };
+            const double foreign { -sign * leaf.initial_total };
+            const double base { -sign * leaf.final_total };
+            const double diff { rate * foreign - base };
+
+            // without a foreign balance no side can carry a base amount
+            if (std::abs(foreign) < kTolerance || std::abs(diff) < kTolerance)
+                continue;
+
+            if (!WriteSide(leaf.id, base / foreign, -foreign) || !WriteSide(leaf.id, rate, foreign) || !UpdateTotal(leaf.id, 0.0, -sign * diff))
+                return false;
+
+            gain_loss_debit -= diff;
+        }
+
+        if (std::abs(gain_loss_debit) < kTolerance)
+            return true;
+
+        const double gain_loss_diff { (gain_loss_rule ? -1.0 : 1.0) * gain_loss_debit };
+        return UpdateTotal(gain_loss_node, gain_loss_diff, gain_loss_diff);
+    };
+
+    if (!DBTransaction(Post)) {
+        diff_hash.clear();
+        return false;
+    }
+
+    // open ledgers of the revalued leaves and of gain_loss_node append the new rows
+    for (int node_id : node_trans.uniqueKeys()) {
+        const auto trans_id_list { node_trans.values(node_id) };
+        emit SMoveMultiTrans(0, node_id, trans_id_list);
+        emit SMoveMultiTrans(0, gain_loss_node, trans_id_list);
+    }
+
+    return true;
+}
+
+QString SqliteFinance::QSTrialBalance() const
+{
+    return QStringLiteral(R"(
+    WITH node_side AS (
+        SELECT lhs_node AS node, date_time, lhs_ratio * lhs_debit AS debit, lhs_ratio * lhs_credit AS credit
+        FROM finance_transaction
+        WHERE date_time < :next_date AND removed = 0
+
+        UNION ALL
+
+        SELECT rhs_node, date_time, rhs_ratio * rhs_debit, rhs_ratio * rhs_credit
+        FROM finance_transaction
+        WHERE date_time < :next_date AND removed = 0
+    )
+    SELECT
+        node,
+        SUM(CASE WHEN date_time < :start_date THEN credit - debit ELSE 0 END) AS opening,
+        SUM(CASE WHEN date_time >= :start_date THEN debit ELSE 0 END) AS debit,
+        SUM(CASE WHEN date_time >= :start_date THEN credit ELSE 0 END) AS credit
+    FROM node_side
+    GROUP BY node
+    )");
+}
+
 QString SqliteFinance::QSLeafTotalFPT() const
 {
     return QStringLiteral(R"(
@@ -212,16 +395,31 @@ QString SqliteFinance::QSSupportTransToRemoveFPTS() const
 QString SqliteFinance::QSReadNodeTrans() const
 {
     return QStringLiteral(R"(
-    SELECT id, lhs_node, lhs_ratio, lhs_debit, lhs_credit, rhs_node, rhs_ratio, rhs_debit, rhs_credit, state, description, support_id, code, document, date_time
+    SELECT id, lhs_node, lhs_ratio, lhs_debit, lhs_credit, rhs_node, rhs_ratio, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
     FROM finance_transaction
     WHERE (lhs_node = :node_id OR rhs_node = :node_id) AND removed = 0
     )");
 }
 
+QString SqliteFinance::QSReadNodeTransWindowFPT() const
+{
+    return QStringLiteral(R"(
+    SELECT id, lhs_node, lhs_ratio, lhs_debit, lhs_credit, rhs_node, rhs_ratio, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
+    FROM finance_transaction
+    WHERE lhs_node = :node_id AND date_time >= :start_date AND date_time < :next_date AND removed = 0
+
+    UNION ALL
+
+    SELECT id, lhs_node, lhs_ratio, lhs_debit, lhs_credit, rhs_node, rhs_ratio, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
+    FROM finance_transaction
+    WHERE rhs_node = :node_id AND date_time >= :start_date AND date_time < :next_date AND removed = 0
+    )");
+}
+
 QString SqliteFinance::QSReadSupportTransFPTS() const
 {
     return QStringLiteral(R"(
-    SELECT id, lhs_node, lhs_ratio, lhs_debit, lhs_credit, rhs_node, rhs_ratio, rhs_debit, rhs_credit, state, description, support_id, code, document, date_time
+    SELECT id, lhs_node, lhs_ratio, lhs_debit, lhs_credit, rhs_node, rhs_ratio, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
     FROM finance_transaction
     WHERE support_id = :node_id AND removed = 0
     )");
@@ -231,20 +429,19 @@ QString SqliteFinance::QSWriteNodeTrans() const
 {
     return QStringLiteral(R"(
     INSERT INTO finance_transaction
-    (date_time, lhs_node, lhs_ratio, lhs_debit, lhs_credit, rhs_node, rhs_ratio, rhs_debit, rhs_credit, state, description, support_id, code, document)
+    (date_time, lhs_node, lhs_ratio, lhs_debit, lhs_credit, rhs_node, rhs_ratio, rhs_debit, rhs_credit, state, description, support_id, code)
     VALUES
-    (:date_time, :lhs_node, :lhs_ratio, :lhs_debit, :lhs_credit, :rhs_node, :rhs_ratio, :rhs_debit, :rhs_credit, :state, :description, :support_id, :code, :document)
+    (:date_time, :lhs_node, :lhs_ratio, :lhs_debit, :lhs_credit, :rhs_node, :rhs_ratio, :rhs_debit, :rhs_credit, :state, :description, :support_id, :code)
     )");
 }
 
-QString SqliteFinance::QSReadTransRangeFPTS(CString& in_list) const
+QString SqliteFinance::QSReadTransRangeFPTS() const
 {
     return QStringLiteral(R"(
-    SELECT id, lhs_node, lhs_ratio, lhs_debit, lhs_credit, rhs_node, rhs_ratio, rhs_debit, rhs_credit, state, description, support_id, code, document, date_time
+    SELECT id, lhs_node, lhs_ratio, lhs_debit, lhs_credit, rhs_node, rhs_ratio, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
     FROM finance_transaction
-    WHERE id IN (%1) AND removed = 0
-    )")
-        .arg(in_list);
+    WHERE id IN (SELECT value FROM json_each(:id_list)) AND removed = 0
+    )");
 }
 
 QString SqliteFinance::QSReplaceNodeTransFPTS() const
@@ -286,7 +483,7 @@ void SqliteFinance::UpdateNodeValueBindFPTO(const Node* node, QSqlQuery& query)
 QString SqliteFinance::QSSearchTrans() const
 {
     return QStringLiteral(R"(
-    SELECT id, lhs_node, lhs_ratio, lhs_debit, lhs_credit, rhs_node, rhs_ratio, rhs_debit, rhs_credit, state, description, support_id, code, document, date_time
+    SELECT id, lhs_node, lhs_ratio, lhs_debit, lhs_credit, rhs_node, rhs_ratio, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
     FROM finance_transaction
     WHERE (lhs_debit = :text OR lhs_credit = :text OR rhs_debit = :text OR rhs_credit = :text OR description LIKE :description) AND removed = 0
     ORDER BY date_time
@@ -22,10 +22,28 @@
 
 #include "sqlite.h"
 
+// Base currency amounts of one finance node over a date range
+// read as raw credit - debit opening, opening and closing follow the node's rule once rolled up, like final_total
+struct TrialRow {
+    int node_id {};
+    double opening {};
+    double debit {};
+    double credit {};
+    double closing {};
+};
+
+using TrialHash = QHash<int, TrialRow>;
+
 class SqliteFinance final : public Sqlite {
 public:
     SqliteFinance(CInfo& info, QObject* parent = nullptr);
 
+    // every leaf with transactions before end_date, one grouped statement
+    bool TrialBalance(TrialHash& leaf_hash, const QDate& start_date, const QDate& end_date) const;
+    // posts one adjusting entry per leaf of unit so its base balance becomes rate * foreign balance, booked against gain_loss_node
+    // in one transaction, historical ratios are left untouched, diff_hash is node_id -> (initial_total, final_total) change
+    bool Revalue(QHash<int, std::pair<double, double>>& diff_hash, int unit, double rate, int gain_loss_node, CString& date_time);
+
 protected:
     void WriteNodeBind(Node* node, QSqlQuery& query) const override;
     void ReadNodeQuery(Node* node, const QSqlQuery& query) const override;
@@ -51,12 +69,16 @@ protected:
     void UpdateNodeValueBindFPTO(const Node* node, QSqlQuery& query) const override;
 
     QString QSReadNodeTrans() const override;
+    QString QSReadNodeTransWindowFPT() const override;
     QString QSReadSupportTransFPTS() const override;
     QString QSWriteNodeTrans() const override;
-    QString QSReadTransRangeFPTS(CString& in_list) const override;
+    QString QSReadTransRangeFPTS() const override;
     QString QSReplaceNodeTransFPTS() const override;
     QString QSUpdateTransValueFPTO() const override;
     QString QSSearchTrans() const override;
+
+private:
+    QString QSTrialBalance() const;
 };
 
 #endif // SQLITEFINANCE_H
@@ -1,11 +1,12 @@
 #include "sqliteorder.h"
 
-#include <QDate>
+#include <QDateTime>
 #include <QSqlError>
 #include <QSqlQuery>
 
 #include "component/constvalue.h"
 #include "global/resourcepool.h"
+#include "global/tracer.h"
 
 SqliteOrder::SqliteOrder(CInfo& info, QObject* parent)
     : Sqlite(info, parent)
@@ -18,6 +19,8 @@ SqliteOrder::~SqliteOrder() { qDeleteAll(node_hash_buffer_); }
 
 bool SqliteOrder::ReadNode(NodeHash& node_hash, const QDate& start_date, const QDate& end_date)
 {
+    const TraceSpan span { "ReadNode", std::to_underlying(info_.section) };
+
     CString& string { QSReadNode() };
     if (string.isEmpty())
         return false;
@@ -64,50 +67,38 @@ bool SqliteOrder::ReadNode(NodeHash& node_hash, const QDate& start_date, const Q
 
 bool SqliteOrder::SearchNode(QList<const Node*>& node_list, const QList<int>& party_id_list)
 {
+    const TraceSpan span { "SearchNode", std::to_underlying(info_.section) };
+
     if (party_id_list.empty())
         return false;
 
     QSqlQuery query(*db_);
     query.setForwardOnly(true);
 
-    const qsizetype batch_size { kBatchSize };
-    const auto total_batches { (party_id_list.size() + batch_size - 1) / batch_size };
+    CString& string { SearchNodeQS() };
+    query.prepare(string);
+    query.bindValue(QStringLiteral(":id_list"), JsonIdList(party_id_list));
+
+    if (!query.exec()) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in SearchNode" << query.lastError().text();
+        return false;
+    }
 
     Node* node {};
     int id {};
 
-    for (int batch_index = 0; batch_index != total_batches; ++batch_index) {
-        int start = batch_index * batch_size;
-        int end = std::min(start + batch_size, party_id_list.size());
-
-        QList<int> current_batch { party_id_list.mid(start, end - start) };
-
-        QStringList placeholder { current_batch.size(), QStringLiteral("?") };
-        QString string { SearchNodeQS(placeholder.join(QStringLiteral(","))) };
-
-        query.prepare(string);
-
-        for (int i = 0; i != current_batch.size(); ++i)
-            query.bindValue(i, current_batch.at(i));
+    while (query.next()) {
+        id = query.value(QStringLiteral("id")).toInt();
 
-        if (!query.exec()) {
-            qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in SearchNode, batch" << batch_index << ": " << query.lastError().text();
+        if (auto it = node_hash_buffer_.constFind(id); it != node_hash_buffer_.constEnd()) {
+            node_list.emplaceBack(it.value());
             continue;
         }
 
-        while (query.next()) {
-            id = query.value(QStringLiteral("id")).toInt();
-
-            if (auto it = node_hash_buffer_.constFind(id); it != node_hash_buffer_.constEnd()) {
-                node_list.emplaceBack(it.value());
-                continue;
-            }
-
-            node = ResourcePool<Node>::Instance().Allocate();
-            ReadNodeQuery(node, query);
-            node_list.emplaceBack(node);
-            node_hash_buffer_.insert(id, node);
-        }
+        node = ResourcePool<Node>::Instance().Allocate();
+        ReadNodeQuery(node, query);
+        node_list.emplaceBack(node);
+        node_hash_buffer_.insert(id, node);
     }
 
     return true;
@@ -124,6 +115,8 @@ bool SqliteOrder::RetriveNode(NodeHash& node_hash, int node_id)
 
 void SqliteOrder::RRemoveNode(int node_id, int /*node_type*/)
 {
+    const TraceSpan span { "RemoveNode", std::to_underlying(info_.section) };
+
     // Notify MainWindow to release the table view
     emit SFreeView(node_id);
     // Notify TreeModel to remove the node
@@ -139,7 +132,249 @@ void SqliteOrder::RRemoveNode(int node_id, int /*node_type*/)
 
     // Recycle trans resources
     for (int trans_id : trans)
-        ResourcePool<Trans>::Instance().Recycle(trans_hash_.take(trans_id));
+        RecycleTrans(trans_id);
+}
+
+bool SqliteOrder::ReadReport(ReportHash& report_hash, ReportGroup group, const QDate& start_date, const QDate& end_date)
+{
+    for (const auto& cache : std::as_const(report_cache_)) {
+        if (cache.group == group && cache.start_date == start_date && cache.end_date == end_date) {
+            report_hash = cache.report_hash;
+            return true;
+        }
+    }
+
+    QSqlQuery query(*db_);
+    query.setForwardOnly(true);
+
+    CString string { QSReport(group, false) };
+    query.prepare(string);
+    query.bindValue(QStringLiteral(":start_date"), start_date.toString(kDateFST));
+    query.bindValue(QStringLiteral(":end_date"), end_date.addDays(1).toString(kDateFST));
+
+    if (!query.exec()) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in ReadReport" << query.lastError().text();
+        return false;
+    }
+
+    report_hash.clear();
+    ReadReportQuery(report_hash, query);
+
+    report_cache_.emplaceBack(ReportCache { group, start_date, end_date, report_hash });
+    while (report_cache_.size() > kReportCacheSize)
+        report_cache_.removeFirst();
+
+    return true;
+}
+
+void SqliteOrder::UpdateReport(const Node* node, bool finished)
+{
+    if (report_cache_.isEmpty() || !node || node->type != kTypeLeaf)
+        return;
+
+    const QDate date { QDateTime::fromString(node->date_time, kDateTimeFST).date() };
+    const int coefficient { finished ? 1 : -1 };
+
+    // one small query per group, shared by every cached range of that group
+    QHash<int, ReportHash> delta_hash {};
+    QSqlQuery query(*db_);
+    query.setForwardOnly(true);
+
+    for (auto& cache : report_cache_) {
+        if (date < cache.start_date || date > cache.end_date)
+            continue;
+
+        const int group { std::to_underlying(cache.group) };
+
+        if (!delta_hash.contains(group)) {
+            CString string { QSReport(cache.group, true) };
+            query.prepare(string);
+            query.bindValue(QStringLiteral(":node_id"), node->id);
+
+            if (!query.exec()) {
+                qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in UpdateReport" << query.lastError().text();
+                report_cache_.clear();
+                return;
+            }
+
+            ReadReportQuery(delta_hash[group], query);
+        }
+
+        for (const auto& delta : std::as_const(delta_hash[group])) {
+            auto& row { cache.report_hash[delta.key] };
+
+            row.key = delta.key;
+            row.count += coefficient * delta.count;
+            row.first += coefficient * delta.first;
+            row.second += coefficient * delta.second;
+            row.amount += coefficient * delta.amount;
+            row.discount += coefficient * delta.discount;
+            row.settled += coefficient * delta.settled;
+
+            if (row.count <= 0)
+                cache.report_hash.remove(delta.key);
+        }
+    }
+
+    if (!delta_hash.isEmpty())
+        emit SUpdateReport();
+}
+
+const AgingHash* SqliteOrder::ReadAging()
+{
+    if (aging_ready_)
+        return &aging_hash_;
+
+    QSqlQuery query(*db_);
+    query.setForwardOnly(true);
+
+    CString string { QStringLiteral(R"(
+    SELECT party, date(date_time) AS date, SUM(amount - discount - settled) AS outstanding
+    FROM %1
+    WHERE finished = 1 AND removed = 0 AND type = 0
+    GROUP BY party, date
+    )")
+            .arg(node_) };
+
+    if (!query.exec(string)) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in ReadAging" << query.lastError().text();
+        return nullptr;
+    }
+
+    aging_hash_.clear();
+    double outstanding {};
+
+    while (query.next()) {
+        outstanding = query.value(QStringLiteral("outstanding")).toDouble();
+        if (std::abs(outstanding) < kTolerance)
+            continue;
+
+        aging_hash_[query.value(QStringLiteral("party")).toInt()].insert(query.value(QStringLiteral("date")).toString(), outstanding);
+    }
+
+    aging_ready_ = true;
+    return &aging_hash_;
+}
+
+void SqliteOrder::UpdateAging(const Node* node, double outstanding_diff)
+{
+    if (!aging_ready_ || !node || node->type != kTypeLeaf || std::abs(outstanding_diff) < kTolerance)
+        return;
+
+    auto& date_map { aging_hash_[node->party] };
+    const QString date { node->date_time.left(10) };
+
+    double& outstanding { date_map[date] };
+    outstanding += outstanding_diff;
+
+    if (std::abs(outstanding) < kTolerance) {
+        date_map.remove(date);
+
+        if (date_map.isEmpty())
+            aging_hash_.remove(node->party);
+    }
+
+    emit SUpdateAging();
+}
+
+void SqliteOrder::AppendMemoryStat(QList<MemoryStat>& stat_list) const
+{
+    Sqlite::AppendMemoryStat(stat_list);
+
+    qsizetype bytes { node_hash_buffer_.size() * qsizetype(sizeof(int) + sizeof(Node*)) };
+    for (const auto* node : node_hash_buffer_)
+        bytes += node->Bytes();
+
+    stat_list.emplaceBack(MemoryStat { tr("Retrieved Nodes"), node_hash_buffer_.size(), bytes });
+
+    qsizetype count {};
+    bytes = report_cache_.capacity() * qsizetype(sizeof(ReportCache));
+
+    for (const auto& cache : report_cache_) {
+        count += cache.report_hash.size();
+
+        for (const auto& row : cache.report_hash)
+            bytes += qsizetype(sizeof(QString) + sizeof(ReportRow)) + 2 * row.key.capacity() * qsizetype(sizeof(QChar));
+    }
+
+    stat_list.emplaceBack(MemoryStat { tr("Report Cache"), count, bytes });
+
+    // a date key is yyyy-MM-dd
+    constexpr qsizetype entry { sizeof(QString) + 10 * sizeof(QChar) + sizeof(double) };
+
+    count = 0;
+    bytes = aging_hash_.size() * qsizetype(sizeof(int) + sizeof(QMap<QString, double>));
+
+    for (const auto& date_map : aging_hash_)
+        count += date_map.size();
+
+    bytes += count * entry;
+    stat_list.emplaceBack(MemoryStat { tr("Aging Cache"), count, bytes });
+}
+
+void SqliteOrder::TrimCache()
+{
+    Sqlite::TrimCache();
+
+    // both are rebuilt by one grouped statement on next use, open dialogs keep their rows until they query again
+    report_cache_.clear();
+    aging_hash_.clear();
+    aging_ready_ = false;
+}
+
+void SqliteOrder::ReadReportQuery(ReportHash& report_hash, QSqlQuery& query) const
+{
+    ReportRow row {};
+
+    while (query.next()) {
+        row.key = query.value(QStringLiteral("report_key")).toString();
+        row.count = query.value(QStringLiteral("count")).toInt();
+        row.first = query.value(QStringLiteral("first")).toDouble();
+        row.second = query.value(QStringLiteral("second")).toDouble();
+        row.amount = query.value(QStringLiteral("amount")).toDouble();
+        row.discount = query.value(QStringLiteral("discount")).toDouble();
+        row.settled = query.value(QStringLiteral("settled")).toDouble();
+
+        report_hash.insert(row.key, row);
+    }
+}
+
+QString SqliteOrder::QSReport(ReportGroup group, bool one_node) const
+{
+    QString key {};
+
+    switch (group) {
+    case ReportGroup::kParty:
+        key = QStringLiteral("n.party");
+        break;
+    case ReportGroup::kProduct:
+        key = QStringLiteral("t.inside_product");
+        break;
+    case ReportGroup::kEmployee:
+        key = QStringLiteral("n.employee");
+        break;
+    case ReportGroup::kPeriod:
+        key = QStringLiteral("strftime('%Y-%m', n.date_time)");
+        break;
+    }
+
+    // refund orders (rule = 1) count negative, the range runs on index (finished, removed, date_time)
+    CString where { one_node ? QStringLiteral("n.id = :node_id")
+                             : QStringLiteral("n.finished = 1 AND n.removed = 0 AND n.date_time >= :start_date AND n.date_time < :end_date") };
+
+    return QStringLiteral(R"(
+    SELECT %3 AS report_key, COUNT(DISTINCT n.id) AS count,
+        SUM(CASE n.rule WHEN 1 THEN -t.first ELSE t.first END) AS first,
+        SUM(CASE n.rule WHEN 1 THEN -t.second ELSE t.second END) AS second,
+        SUM(CASE n.rule WHEN 1 THEN -t.amount ELSE t.amount END) AS amount,
+        SUM(CASE n.rule WHEN 1 THEN -t.discount ELSE t.discount END) AS discount,
+        SUM(CASE n.rule WHEN 1 THEN -t.settled ELSE t.settled END) AS settled
+    FROM %1 n
+    JOIN %2 t ON t.lhs_node = n.id AND t.removed = 0
+    WHERE n.type = 0 AND %4
+    GROUP BY report_key
+    )")
+        .arg(node_, transaction_, key, where);
 }
 
 QString SqliteOrder::QSReadNode() const
@@ -259,14 +494,14 @@ QString SqliteOrder::QSNodeTransToRemove() const
         .arg(transaction_);
 }
 
-QString SqliteOrder::SearchNodeQS(CString& in_list) const
+QString SqliteOrder::SearchNodeQS() const
 {
     return QStringLiteral(R"(
     SELECT name, id, code, description, note, rule, type, unit, party, employee, date_time, first, second, discount, finished, amount, settled
     FROM %1
-    WHERE party IN (%2) AND removed = 0
+    WHERE party IN (SELECT value FROM json_each(:id_list)) AND removed = 0
     )")
-        .arg(node_, in_list);
+        .arg(node_);
 }
 
 void SqliteOrder::WriteTransBind(TransShadow* trans_shadow, QSqlQuery& query) const
@@ -316,31 +551,34 @@ void SqliteOrder::ReadTransFunction(TransShadowList& trans_shadow_list, int /*no
         trans->id = id;
 
         ReadTransQuery(trans, query);
-        trans_hash_.insert(id, trans);
+        InsertTrans(trans);
 
         ConvertTrans(trans, trans_shadow, true);
         trans_shadow_list.emplaceBack(trans_shadow);
     }
 }
 
-void SqliteOrder::UpdateProductReferenceSO(int old_node_id, int new_node_id) const
+void SqliteOrder::UpdateProductReferenceSO(int old_node_id, int new_node_id)
 {
-    const auto& const_trans_hash { std::as_const(trans_hash_) };
+    report_cache_.clear();
 
-    for (auto* trans : const_trans_hash) {
-        if (trans->rhs_node == old_node_id)
+    for (auto* trans : IndexedTrans(node_index_, old_node_id)) {
+        if (trans->rhs_node == old_node_id) {
             trans->rhs_node = new_node_id;
+            IndexTrans(trans);
+        }
     }
 }
 
-void SqliteOrder::UpdateStakeholderReferenceO(int old_node_id, int new_node_id) const
+void SqliteOrder::UpdateStakeholderReferenceO(int old_node_id, int new_node_id)
 {
     // for party's product reference
-    const auto& const_trans_hash { std::as_const(trans_hash_) };
+    report_cache_.clear();
+    aging_ready_ = false;
 
-    for (auto* trans : const_trans_hash) {
-        if (trans->support_id == old_node_id)
-            trans->support_id = new_node_id;
+    for (auto* trans : IndexedTrans(support_index_, old_node_id)) {
+        trans->support_id = new_node_id;
+        IndexTrans(trans);
     }
 }
 
@@ -20,8 +20,34 @@
 #ifndef SQLITEORDER_H
 #define SQLITEORDER_H
 
+#include <QDate>
+
 #include "sqlite.h"
 
+// Totals of finished orders in one group, key is the party, inside product or employee id, or the yyyy-MM period
+struct ReportRow {
+    QString key {};
+    int count {};
+    double first {};
+    double second {};
+    double amount {};
+    double discount {};
+    double settled {};
+};
+
+using ReportHash = QHash<QString, ReportRow>;
+
+struct ReportCache {
+    ReportGroup group {};
+    QDate start_date {};
+    QDate end_date {};
+    ReportHash report_hash {};
+};
+
+// Outstanding amount - discount - settled of finished orders, party -> order date (yyyy-MM-dd) -> sum
+// the due date is left to the reader, so a changed payment term needs no rebuild
+using AgingHash = QHash<int, QMap<QString, double>>;
+
 class SqliteOrder final : public Sqlite {
     Q_OBJECT
 
@@ -29,10 +55,27 @@ public:
     SqliteOrder(CInfo& info, QObject* parent = nullptr);
     ~SqliteOrder();
 
+signals:
+    // send to Report
+    void SUpdateReport();
+    // send to Aging
+    void SUpdateAging();
+
+public:
     bool ReadNode(NodeHash& node_hash, const QDate& start_date, const QDate& end_date);
     bool SearchNode(QList<const Node*>& node_list, const QList<int>& party_id_list);
     bool RetriveNode(NodeHash& node_hash, int node_id);
 
+    bool ReadReport(ReportHash& report_hash, ReportGroup group, const QDate& start_date, const QDate& end_date);
+    // an order is finished, unfinished or removed, its lines are added to or subtracted from every cached report covering its date
+    void UpdateReport(const Node* node, bool finished);
+
+    // built by one grouped statement on first use, then kept by UpdateAging
+    const AgingHash* ReadAging();
+    void UpdateAging(const Node* node, double outstanding_diff);
+
+    void AppendMemoryStat(QList<MemoryStat>& stat_list) const override;
+    void TrimCache() override;
 public slots:
     void RRemoveNode(int node_id, int node_type) override;
 
@@ -50,8 +93,8 @@ protected:
     void WriteTransBind(TransShadow* trans_shadow, QSqlQuery& query) const override;
     void ReadTransFunction(TransShadowList& trans_shadow_list, int node_id, QSqlQuery& query) override;
     void ReadTransQuery(Trans* trans, const QSqlQuery& query) const override;
-    void UpdateProductReferenceSO(int old_node_id, int new_node_id) const override;
-    void UpdateStakeholderReferenceO(int old_node_id, int new_node_id) const override;
+    void UpdateProductReferenceSO(int old_node_id, int new_node_id) override;
+    void UpdateStakeholderReferenceO(int old_node_id, int new_node_id) override;
     void UpdateTransValueBindFPTO(const TransShadow* trans_shadow, QSqlQuery& query) const override;
 
     QString QSUpdateNodeValueFPTO() const override;
@@ -66,12 +109,19 @@ protected:
     QString QSNodeTransToRemove() const override;
 
 private:
-    QString SearchNodeQS(CString& in_list) const;
+    QString SearchNodeQS() const;
+    QString QSReport(ReportGroup group, bool one_node) const;
+    void ReadReportQuery(ReportHash& report_hash, QSqlQuery& query) const;
 
 private:
     CString& node_;
     CString& transaction_;
     NodeHash node_hash_buffer_ {};
+
+    // a replaced product or stakeholder regroups every report, UpdateProductReferenceSO and UpdateStakeholderReferenceO drop the cache
+    QList<ReportCache> report_cache_ {};
+    AgingHash aging_hash_ {};
+    bool aging_ready_ {};
 };
 
 #endif // SQLITEORDER_H
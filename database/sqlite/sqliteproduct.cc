@@ -1,12 +1,212 @@
 #include "sqliteproduct.h"
 
+#include <QSqlError>
 #include <QSqlQuery>
 
 #include "component/constvalue.h"
 
+namespace {
+// same timestamp: purchases first so a sale never runs ahead of the goods it ships
+bool StockLess(const StockMove& lhs, const StockMove& rhs)
+{
+    if (lhs.date_time != rhs.date_time)
+        return lhs.date_time < rhs.date_time;
+
+    if (lhs.purchase != rhs.purchase)
+        return lhs.purchase;
+
+    return lhs.trans_id < rhs.trans_id;
+}
+}
+
 SqliteProduct::SqliteProduct(CInfo& info, QObject* parent)
     : Sqlite(info, parent)
 {
+    // a replaced product regroups every line
+    connect(this, &Sqlite::SUpdateProduct, this, [this]() {
+        stock_hash_.clear();
+        stock_ready_ = false;
+    });
+}
+
+bool SqliteProduct::Stock(double& quantity, double& value, int product_id, const QDate& date)
+{
+    quantity = 0.0;
+    value = 0.0;
+
+    if (!stock_ready_ && !BuildStock())
+        return false;
+
+    auto it { stock_hash_.constFind(product_id) };
+    if (it == stock_hash_.constEnd())
+        return true;
+
+    const auto& move_list { it.value() };
+    CString next_date { date.addDays(1).toString(kDateFST) };
+
+    auto last { std::lower_bound(
+        move_list.cbegin(), move_list.cend(), next_date, [](const StockMove& move, CString& date_time) { return move.date_time < date_time; }) };
+
+    if (last == move_list.cbegin())
+        return true;
+
+    --last;
+    quantity = last->on_hand;
+    value = last->value;
+    return true;
+}
+
+QList<int> SqliteProduct::StockProduct()
+{
+    if (!stock_ready_ && !BuildStock())
+        return {};
+
+    return stock_hash_.keys();
+}
+
+void SqliteProduct::RUpdateStock(Section section, int node_id, bool finished)
+{
+    if (!stock_ready_)
+        return;
+
+    QList<std::pair<int, StockMove>> move_list {};
+    if (!ReadStockMove(move_list, section, node_id)) {
+        stock_hash_.clear();
+        stock_ready_ = false;
+        return;
+    }
+
+    // only the touched products replay, and each from the first changed move on
+    QHash<int, qsizetype> replay_hash {};
+
+    for (const auto& [product_id, move] : std::as_const(move_list)) {
+        auto& product_list { stock_hash_[product_id] };
+        qsizetype index {};
+
+        if (finished) {
+            auto it { std::upper_bound(product_list.begin(), product_list.end(), move, StockLess) };
+            index = std::distance(product_list.begin(), it);
+            product_list.insert(index, move);
+        } else {
+            auto it { std::find_if(product_list.cbegin(), product_list.cend(),
+                [&move](const StockMove& current) { return current.purchase == move.purchase && current.trans_id == move.trans_id; }) };
+            if (it == product_list.cend())
+                continue;
+
+            index = std::distance(product_list.cbegin(), it);
+            product_list.removeAt(index);
+        }
+
+        auto replay { replay_hash.find(product_id) };
+        if (replay == replay_hash.end())
+            replay_hash.insert(product_id, index);
+        else
+            replay.value() = std::min(replay.value(), index);
+    }
+
+    for (auto it = replay_hash.cbegin(); it != replay_hash.cend(); ++it) {
+        auto& product_list { stock_hash_[it.key()] };
+
+        if (product_list.isEmpty())
+            stock_hash_.remove(it.key());
+        else
+            ReplayStock(product_list, it.value());
+    }
+}
+
+bool SqliteProduct::BuildStock()
+{
+    QList<std::pair<int, StockMove>> move_list {};
+    if (!ReadStockMove(move_list, Section::kPurchase, 0) || !ReadStockMove(move_list, Section::kSales, 0))
+        return false;
+
+    stock_hash_.clear();
+
+    for (auto& [product_id, move] : move_list)
+        stock_hash_[product_id].emplaceBack(std::move(move));
+
+    for (auto& product_list : stock_hash_) {
+        std::sort(product_list.begin(), product_list.end(), StockLess);
+        ReplayStock(product_list, 0);
+    }
+
+    stock_ready_ = true;
+    return true;
+}
+
+bool SqliteProduct::ReadStockMove(QList<std::pair<int, StockMove>>& move_list, Section section, int node_id) const
+{
+    QSqlQuery query(*db_);
+    query.setForwardOnly(true);
+
+    CString string { QSStockMove(section, node_id != 0) };
+    query.prepare(string);
+
+    if (node_id != 0)
+        query.bindValue(QStringLiteral(":node_id"), node_id);
+
+    if (!query.exec()) {
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in ReadStockMove" << query.lastError().text();
+        return false;
+    }
+
+    const bool purchase { section == Section::kPurchase };
+    StockMove move {};
+    move.purchase = purchase;
+
+    while (query.next()) {
+        // purchase in and sales out, a refund runs the other way
+        const int coefficient { (purchase ? 1 : -1) * (query.value(QStringLiteral("rule")).toBool() ? -1 : 1) };
+
+        move.date_time = query.value(QStringLiteral("date_time")).toString();
+        move.trans_id = query.value(QStringLiteral("id")).toInt();
+        move.quantity = coefficient * query.value(QStringLiteral("second")).toDouble();
+        move.cost = purchase ? coefficient * query.value(QStringLiteral("settled")).toDouble() : 0.0;
+
+        move_list.emplaceBack(query.value(QStringLiteral("inside_product")).toInt(), move);
+    }
+
+    return true;
+}
+
+QString SqliteProduct::QSStockMove(Section section, bool one_node) const
+{
+    const bool purchase { section == Section::kPurchase };
+
+    CString node { purchase ? kPurchase : kSales };
+    CString transaction { purchase ? kPurchaseTransaction : kSalesTransaction };
+    CString where { one_node ? QStringLiteral("n.id = :node_id") : QStringLiteral("n.finished = 1 AND n.removed = 0") };
+
+    return QStringLiteral(R"(
+    SELECT t.id, t.inside_product, t.second, t.settled, n.date_time, n.rule
+    FROM %1 n
+    JOIN %2 t ON t.lhs_node = n.id AND t.removed = 0
+    WHERE n.type = 0 AND t.inside_product > 0 AND %3
+    )")
+        .arg(node, transaction, where);
+}
+
+void SqliteProduct::ReplayStock(QList<StockMove>& move_list, qsizetype start) const
+{
+    double on_hand { start >= 1 ? move_list.at(start - 1).on_hand : 0.0 };
+    double value { start >= 1 ? move_list.at(start - 1).value : 0.0 };
+
+    for (auto i { start }; i != move_list.size(); ++i) {
+        auto& move { move_list[i] };
+
+        // purchase lines carry their own cost, sales lines move at the running average
+        if (move.purchase)
+            value += move.cost;
+        else
+            value += (std::abs(on_hand) < kTolerance ? 0.0 : value / on_hand) * move.quantity;
+
+        on_hand += move.quantity;
+        if (std::abs(on_hand) < kTolerance)
+            value = 0.0;
+
+        move.on_hand = on_hand;
+        move.value = value;
+    }
 }
 
 QString SqliteProduct::QSReadNode() const
@@ -188,7 +388,7 @@ void SqliteProduct::ReadTransQuery(Trans* trans, const QSqlQuery& query) const
     trans->unit_price = query.value(QStringLiteral("unit_cost")).toDouble();
     trans->code = query.value(QStringLiteral("code")).toString();
     trans->description = query.value(QStringLiteral("description")).toString();
-    trans->document = query.value(QStringLiteral("document")).toString().split(kSemicolon, Qt::SkipEmptyParts);
+    trans->document = query.value(QStringLiteral("document_count")).toInt();
     trans->date_time = query.value(QStringLiteral("date_time")).toString();
     trans->state = query.value(QStringLiteral("state")).toBool();
     trans->support_id = query.value(QStringLiteral("support_id")).toInt();
@@ -202,7 +402,6 @@ void SqliteProduct::WriteTransBind(TransShadow* trans_shadow, QSqlQuery& query)
     query.bindValue(QStringLiteral(":description"), *trans_shadow->description);
     query.bindValue(QStringLiteral(":support_id"), *trans_shadow->support_id);
     query.bindValue(QStringLiteral(":code"), *trans_shadow->code);
-    query.bindValue(QStringLiteral(":document"), trans_shadow->document->join(kSemicolon));
 
     query.bindValue(QStringLiteral(":lhs_node"), *trans_shadow->lhs_node);
     query.bindValue(QStringLiteral(":lhs_debit"), *trans_shadow->lhs_debit);
@@ -227,12 +426,27 @@ void SqliteProduct::UpdateTransValueBindFPTO(const TransShadow* trans_shadow, QS
 QString SqliteProduct::QSReadNodeTrans() const
 {
     return QStringLiteral(R"(
-    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document, date_time
+    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
     FROM product_transaction
     WHERE (lhs_node = :node_id OR rhs_node = :node_id) AND removed = 0
     )");
 }
 
+QString SqliteProduct::QSReadNodeTransWindowFPT() const
+{
+    return QStringLiteral(R"(
+    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
+    FROM product_transaction
+    WHERE lhs_node = :node_id AND date_time >= :start_date AND date_time < :next_date AND removed = 0
+
+    UNION ALL
+
+    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
+    FROM product_transaction
+    WHERE rhs_node = :node_id AND date_time >= :start_date AND date_time < :next_date AND removed = 0
+    )");
+}
+
 QString SqliteProduct::QSUpdateNodeValueFPTO() const
 {
     return QStringLiteral(R"(
@@ -253,26 +467,25 @@ QString SqliteProduct::QSWriteNodeTrans() const
 {
     return QStringLiteral(R"(
     INSERT INTO product_transaction
-    (date_time, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document)
+    (date_time, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code)
     VALUES
-    (:date_time, :lhs_node, :unit_cost, :lhs_debit, :lhs_credit, :rhs_node, :rhs_debit, :rhs_credit, :state, :description, :support_id, :code, :document)
+    (:date_time, :lhs_node, :unit_cost, :lhs_debit, :lhs_credit, :rhs_node, :rhs_debit, :rhs_credit, :state, :description, :support_id, :code)
     )");
 }
 
-QString SqliteProduct::QSReadTransRangeFPTS(CString& in_list) const
+QString SqliteProduct::QSReadTransRangeFPTS() const
 {
     return QStringLiteral(R"(
-    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document, date_time
+    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
     FROM product_transaction
-    WHERE id IN (%1) AND removed = 0
-    )")
-        .arg(in_list);
+    WHERE id IN (SELECT value FROM json_each(:id_list)) AND removed = 0
+    )");
 }
 
 QString SqliteProduct::QSReadSupportTransFPTS() const
 {
     return QStringLiteral(R"(
-    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document, date_time
+    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
     FROM product_transaction
     WHERE support_id = :node_id AND removed = 0
     )");
@@ -301,7 +514,7 @@ QString SqliteProduct::QSUpdateTransValueFPTO() const
 QString SqliteProduct::QSSearchTrans() const
 {
     return QStringLiteral(R"(
-    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document, date_time
+    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
     FROM product_transaction
     WHERE (lhs_debit = :text OR lhs_credit = :text OR rhs_debit = :text OR rhs_credit = :text OR description LIKE :description) AND removed = 0
     ORDER BY date_time
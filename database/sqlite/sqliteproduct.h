@@ -22,10 +22,31 @@
 
 #include "sqlite.h"
 
+// One finished order line as seen by the stock of its inside product, on_hand and value are the state after it
+struct StockMove {
+    QString date_time {};
+    int trans_id {};
+    bool purchase {};
+    double quantity {};
+    double cost {};
+    double on_hand {};
+    double value {};
+};
+
+using StockHash = QHash<int, QList<StockMove>>;
+
 class SqliteProduct final : public Sqlite {
 public:
     SqliteProduct(CInfo& info, QObject* parent = nullptr);
 
+public:
+    // moving average valuation, the ledger is built from finished orders on first use and kept up to date by RUpdateStock
+    bool Stock(double& quantity, double& value, int product_id, const QDate& date);
+    QList<int> StockProduct();
+
+    // receive from TreeModelOrder, an order is finished, unfinished or removed
+    void RUpdateStock(Section section, int node_id, bool finished);
+
 protected:
     // tree
     QString QSReadNode() const override;
@@ -55,12 +76,23 @@ protected:
     void UpdateNodeValueBindFPTO(const Node* node, QSqlQuery& query) const override;
 
     QString QSReadNodeTrans() const override;
+    QString QSReadNodeTransWindowFPT() const override;
     QString QSWriteNodeTrans() const override;
-    QString QSReadTransRangeFPTS(CString& in_list) const override;
+    QString QSReadTransRangeFPTS() const override;
     QString QSReadSupportTransFPTS() const override;
     QString QSReplaceNodeTransFPTS() const override;
     QString QSUpdateTransValueFPTO() const override;
     QString QSSearchTrans() const override;
+
+private:
+    bool BuildStock();
+    bool ReadStockMove(QList<std::pair<int, StockMove>>& move_list, Section section, int node_id) const;
+    QString QSStockMove(Section section, bool one_node) const;
+    void ReplayStock(QList<StockMove>& move_list, qsizetype start) const;
+
+private:
+    StockHash stock_hash_ {};
+    bool stock_ready_ {};
 };
 
 #endif // SQLITEPRODUCT_H
@@ -1,10 +1,13 @@
 #include "sqlitestakeholder.h"
 
+#include <QFutureWatcher>
 #include <QSqlError>
 #include <QSqlQuery>
+#include <QtConcurrent>
 
 #include "component/constvalue.h"
 #include "global/resourcepool.h"
+#include "global/tracer.h"
 
 SqliteStakeholder::SqliteStakeholder(CInfo& info, QObject* parent)
     : Sqlite(info, parent)
@@ -23,6 +26,7 @@ void SqliteStakeholder::RReplaceNode(int old_node_id, int new_node_id, int node_
 
     if (node_type == kTypeLeaf) {
         RemoveNode(old_node_id, kTypeLeaf);
+        DropPriceBook({ old_node_id });
         return;
     }
 
@@ -39,6 +43,7 @@ void SqliteStakeholder::RReplaceNode(int old_node_id, int new_node_id, int node_
     }
     // end deal with database
 
+    DropPriceBook(PriceBookParty(old_node_id, false));
     ReplaceSupportFunction(old_node_id, new_node_id);
     RemoveNode(old_node_id, kTypeSupport);
     emit SMoveMultiSupportTransFPTS(info_.section, new_node_id, support_trans);
@@ -46,6 +51,8 @@ void SqliteStakeholder::RReplaceNode(int old_node_id, int new_node_id, int node_
 
 void SqliteStakeholder::RRemoveNode(int node_id, int node_type)
 {
+    const TraceSpan span { "RemoveNode", std::to_underlying(info_.section) };
+
     emit SFreeView(node_id);
     emit SRemoveNode(node_id);
     emit SUpdateStakeholder(node_id, 0);
@@ -59,6 +66,7 @@ void SqliteStakeholder::RRemoveNode(int node_id, int node_type)
     }
 
     RemoveNode(node_id, node_type);
+    DropPriceBook(node_type == kTypeSupport ? PriceBookParty(node_id, false) : QSet<int> { node_id });
 
     if (node_type == kTypeSupport) {
         RemoveSupportFunction(node_id);
@@ -72,60 +80,61 @@ void SqliteStakeholder::RRemoveNode(int node_id, int node_type)
     const auto trans { node_trans.values() };
 
     for (int trans_id : trans)
-        ResourcePool<Trans>::Instance().Recycle(trans_hash_.take(trans_id));
+        RecycleTrans(trans_id);
 }
 
-bool SqliteStakeholder::CrossSearch(TransShadow* order_trans_shadow, int party_id, int product_id, bool is_inside) const
+bool SqliteStakeholder::CrossSearch(TransShadow* order_trans_shadow, int party_id, int product_id, bool is_inside)
 {
-    const Trans* latest_trans { nullptr };
+    if (party_id <= 0)
+        return false;
 
-    for (const auto* trans : trans_hash_) {
-        if (is_inside && trans->lhs_node == party_id && trans->rhs_node == product_id) {
-            if (!latest_trans || trans->date_time > latest_trans->date_time) {
-                latest_trans = trans;
-            }
-        }
+    const Trans* latest_trans {};
 
-        if (!is_inside && trans->lhs_node == party_id && trans->support_id == product_id) {
-            if (!latest_trans || trans->date_time > latest_trans->date_time) {
-                latest_trans = trans;
-            }
-        }
+    if (auto it = price_book_.constFind(party_id); it != price_book_.constEnd()) {
+        const auto& hash { is_inside ? it->inside_product : it->outside_product };
+        latest_trans = trans_hash_.value(hash.value(product_id));
+    } else {
+        // the book is not read yet or was dropped by an edit, it is read on a worker thread while this lookup asks for one row
+        ReadPriceBook(party_id);
+        latest_trans = LatestTrans(party_id, product_id, is_inside);
     }
 
-    if (latest_trans) {
-        *order_trans_shadow->unit_price = latest_trans->unit_price;
+    if (!latest_trans)
+        return false;
+
+    *order_trans_shadow->unit_price = latest_trans->unit_price;
 
-        if (is_inside) {
-            *order_trans_shadow->support_id = latest_trans->support_id;
-        } else {
-            *order_trans_shadow->rhs_node = latest_trans->rhs_node;
-        }
-        return true;
+    if (is_inside) {
+        *order_trans_shadow->support_id = latest_trans->support_id;
+    } else {
+        *order_trans_shadow->rhs_node = latest_trans->rhs_node;
     }
 
-    return false;
+    return true;
 }
 
 bool SqliteStakeholder::UpdatePrice(int party_id, int inside_product_id, CString& date_time, double value)
 {
-    // update unit_price
-    const auto& const_trans_hash { std::as_const(trans_hash_) };
-    Trans* latest_trans { nullptr };
+    if (party_id <= 0)
+        return false;
 
-    for (auto* trans : const_trans_hash) {
-        if (trans->lhs_node == party_id && trans->rhs_node == inside_product_id) {
-            if (!latest_trans || trans->date_time > latest_trans->date_time) {
-                latest_trans = trans;
-            }
-        }
-    }
+    auto it { price_book_.find(party_id) };
+    auto* book { it == price_book_.end() ? nullptr : &it.value() };
+
+    // a read still running would miss this write
+    if (!book)
+        DropPriceBook({ party_id });
 
-    if (latest_trans) {
+    // update unit_price
+    if (auto* latest_trans { book ? trans_hash_.value(book->inside_product.value(inside_product_id)) : LatestTrans(party_id, inside_product_id, true) }) {
         latest_trans->unit_price = value;
         latest_trans->date_time = date_time;
-        UpdateDateTimePrice(date_time, value, latest_trans->id);
-        return true;
+
+        const bool updated { UpdateDateTimePrice(date_time, value, latest_trans->id) };
+        if (book)
+            IndexPrice(*book, latest_trans);
+
+        return updated;
     }
 
     // append unit_price in TableModelStakeholder
@@ -138,6 +147,9 @@ bool SqliteStakeholder::UpdatePrice(int party_id, int inside_product_id, CString
     trans->date_time = date_time;
 
     if (WriteTrans(trans)) {
+        if (book)
+            IndexPrice(*book, trans);
+
         ConvertTrans(trans, trans_shadow, true);
         emit SAppendPrice(info_.section, trans_shadow);
         return true;
@@ -148,22 +160,166 @@ bool SqliteStakeholder::UpdatePrice(int party_id, int inside_product_id, CString
     return false;
 }
 
-bool SqliteStakeholder::ReadTrans(int node_id)
+void SqliteStakeholder::ReadPriceBook(int party_id)
+{
+    if (party_id <= 0 || price_book_.contains(party_id) || price_book_loading_.contains(party_id))
+        return;
+
+    price_book_loading_.insert(party_id, 0);
+
+    CString string { QSReadNodeTrans() };
+    CString file_path { db_->databaseName() };
+    CString connection { QStringLiteral("price_book_%1").arg(party_id) };
+
+    auto future { QtConcurrent::run([this, string, file_path, connection, party_id]() { return ReadTransWorker(connection, file_path, string, party_id); }) };
+
+    auto* watcher { new QFutureWatcher<TransList>(this) };
+    connect(watcher, &QFutureWatcher<TransList>::finished, this, [this, watcher, party_id]() {
+        auto trans_list { watcher->result() };
+        watcher->deleteLater();
+
+        // the party's trans were edited while the worker read them, read again
+        if (price_book_loading_.take(party_id) != 0) {
+            ResourcePool<Trans>::Instance().Recycle(trans_list);
+            ReadPriceBook(party_id);
+            return;
+        }
+
+        for (auto& trans : trans_list) {
+            if (auto it = trans_hash_.constFind(trans->id); it != trans_hash_.constEnd()) {
+                ResourcePool<Trans>::Instance().Recycle(trans);
+                trans = it.value();
+            } else {
+                InsertTrans(trans);
+            }
+        }
+
+        BuildPriceBook(party_id, trans_list);
+    });
+
+    watcher->setFuture(future);
+}
+
+void SqliteStakeholder::TransChanged(const Trans* trans)
+{
+    if (trans)
+        DropPriceBook({ trans->lhs_node });
+}
+
+void SqliteStakeholder::AppendMemoryStat(QList<MemoryStat>& stat_list) const
 {
+    Sqlite::AppendMemoryStat(stat_list);
+
+    qsizetype count {};
+    qsizetype bytes { price_book_.size() * qsizetype(sizeof(int) + sizeof(PriceBook)) };
+
+    for (const auto& book : price_book_)
+        count += book.inside_product.size() + book.outside_product.size();
+
+    bytes += count * qsizetype(2 * sizeof(int));
+    stat_list.emplaceBack(MemoryStat { tr("Price Books"), count, bytes });
+}
+
+void SqliteStakeholder::TrimCache()
+{
+    Sqlite::TrimCache();
+
+    // books only hold ids into trans_hash_, CrossSearch reads one again on its next lookup
+    price_book_.clear();
+}
+
+Trans* SqliteStakeholder::LatestTrans(int party_id, int product_id, bool is_inside)
+{
+    if (product_id <= 0)
+        return nullptr;
+
     QSqlQuery query(*db_);
     query.setForwardOnly(true);
 
-    CString& string { QSReadNodeTrans() };
+    CString string { QStringLiteral(R"(
+    SELECT id, date_time, code, outside_product, lhs_node, unit_price, description, document_count, state, inside_product
+    FROM stakeholder_transaction
+    WHERE lhs_node = :party_id AND %1 = :product_id AND removed = 0
+    ORDER BY date_time DESC
+    LIMIT 1
+    )")
+            .arg(is_inside ? QStringLiteral("inside_product") : QStringLiteral("outside_product")) };
+
     query.prepare(string);
-    query.bindValue(QStringLiteral(":node_id"), node_id);
+    query.bindValue(QStringLiteral(":party_id"), party_id);
+    query.bindValue(QStringLiteral(":product_id"), product_id);
 
     if (!query.exec()) {
-        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in ReadTrans" << query.lastError().text();
-        return false;
+        qWarning() << "Section: " << std::to_underlying(info_.section) << "Failed in LatestTrans" << query.lastError().text();
+        return nullptr;
     }
 
-    ReadTransFunction(query);
-    return true;
+    if (!query.next())
+        return nullptr;
+
+    const int id { query.value(QStringLiteral("id")).toInt() };
+    auto* trans { trans_hash_.value(id) };
+
+    if (!trans) {
+        trans = ResourcePool<Trans>::Instance().Allocate();
+        trans->id = id;
+
+        ReadTransQuery(trans, query);
+        InsertTrans(trans);
+    }
+
+    return trans;
+}
+
+void SqliteStakeholder::BuildPriceBook(int party_id, const TransList& trans_list)
+{
+    PriceBook book {};
+
+    for (const auto* trans : trans_list)
+        if (trans->lhs_node == party_id)
+            IndexPrice(book, trans);
+
+    price_book_.insert(party_id, book);
+}
+
+void SqliteStakeholder::IndexPrice(PriceBook& book, const Trans* trans) const
+{
+    auto index = [this, trans](QHash<int, int>& hash, int product_id) {
+        if (product_id <= 0)
+            return;
+
+        const auto* latest_trans { trans_hash_.value(hash.value(product_id)) };
+        if (!latest_trans || trans->date_time > latest_trans->date_time)
+            hash.insert(product_id, trans->id);
+    };
+
+    index(book.inside_product, trans->rhs_node);
+    index(book.outside_product, trans->support_id);
+}
+
+void SqliteStakeholder::DropPriceBook(const QSet<int>& party_set)
+{
+    for (int party_id : party_set) {
+        const bool in_use { price_book_.remove(party_id) };
+
+        // a read already running has missed the edit, its result is thrown away and read again
+        if (auto it = price_book_loading_.find(party_id); it != price_book_loading_.end())
+            ++it.value();
+        else if (in_use)
+            ReadPriceBook(party_id);
+    }
+}
+
+QSet<int> SqliteStakeholder::PriceBookParty(int product_id, bool is_inside) const
+{
+    QSet<int> party_set {};
+
+    for (auto it = price_book_.cbegin(); it != price_book_.cend(); ++it) {
+        if ((is_inside ? it->inside_product : it->outside_product).contains(product_id))
+            party_set.insert(it.key());
+    }
+
+    return party_set;
 }
 
 QString SqliteStakeholder::QSReadNode() const
@@ -274,7 +430,7 @@ QString SqliteStakeholder::QSSupportTransToRemoveFPTS() const
 QString SqliteStakeholder::QSReadNodeTrans() const
 {
     return QStringLiteral(R"(
-    SELECT id, date_time, code, outside_product, lhs_node, unit_price, description, document, state, inside_product
+    SELECT id, date_time, code, outside_product, lhs_node, unit_price, description, document_count, state, inside_product
     FROM stakeholder_transaction
     WHERE lhs_node = :node_id AND removed = 0
     )");
@@ -283,7 +439,7 @@ QString SqliteStakeholder::QSReadNodeTrans() const
 QString SqliteStakeholder::QSReadSupportTransFPTS() const
 {
     return QStringLiteral(R"(
-    SELECT id, date_time, code, outside_product, lhs_node, unit_price, description, document, state, inside_product
+    SELECT id, date_time, code, outside_product, lhs_node, unit_price, description, document_count, state, inside_product
     FROM stakeholder_transaction
     WHERE outside_product = :node_id AND removed = 0
     )");
@@ -293,9 +449,9 @@ QString SqliteStakeholder::QSWriteNodeTrans() const
 {
     return QStringLiteral(R"(
     INSERT INTO stakeholder_transaction
-    (date_time, code, outside_product, lhs_node, unit_price, description, document, state, inside_product)
+    (date_time, code, outside_product, lhs_node, unit_price, description, state, inside_product)
     VALUES
-    (:date_time, :code, :outside_product, :lhs_node, :unit_price, :description, :document, :state, :inside_product)
+    (:date_time, :code, :outside_product, :lhs_node, :unit_price, :description, :state, :inside_product)
     )");
 }
 
@@ -320,7 +476,7 @@ QString SqliteStakeholder::QSUpdateProductReferenceSO() const
 QString SqliteStakeholder::QSSearchTrans() const
 {
     return QStringLiteral(R"(
-    SELECT  id, date_time, code, outside_product, lhs_node, unit_price, description, document, state, inside_product
+    SELECT  id, date_time, code, outside_product, lhs_node, unit_price, description, document_count, state, inside_product
     FROM stakeholder_transaction
     WHERE (unit_price = :text OR description LIKE :description) AND removed = 0
     ORDER BY date_time
@@ -346,25 +502,6 @@ QString SqliteStakeholder::QSNodeTransToRemove() const
     )");
 }
 
-void SqliteStakeholder::ReadTransFunction(QSqlQuery& query)
-{
-    Trans* trans {};
-    int id {};
-
-    while (query.next()) {
-        id = query.value(QStringLiteral("id")).toInt();
-
-        if (trans_hash_.contains(id))
-            continue;
-
-        trans = ResourcePool<Trans>::Instance().Allocate();
-        trans->id = id;
-
-        ReadTransQuery(trans, query);
-        trans_hash_.insert(id, trans);
-    }
-}
-
 bool SqliteStakeholder::WriteTrans(Trans* trans)
 {
     QSqlQuery query(*db_);
@@ -379,7 +516,7 @@ bool SqliteStakeholder::WriteTrans(Trans* trans)
     }
 
     trans->id = query.lastInsertId().toInt();
-    trans_hash_.insert(trans->id, trans);
+    InsertTrans(trans);
     return true;
 }
 
@@ -414,25 +551,25 @@ void SqliteStakeholder::WriteTransBind(Trans* trans, QSqlQuery& query) const
     query.bindValue(QStringLiteral(":unit_price"), trans->unit_price);
     query.bindValue(QStringLiteral(":description"), trans->description);
     query.bindValue(QStringLiteral(":state"), trans->state);
-    query.bindValue(QStringLiteral(":document"), trans->document.join(kSemicolon));
     query.bindValue(QStringLiteral(":inside_product"), trans->rhs_node);
     query.bindValue(QStringLiteral(":outside_product"), trans->support_id);
 }
 
-QMultiHash<int, int> SqliteStakeholder::ReplaceNodeFunction(int old_node_id, int new_node_id) const
+QMultiHash<int, int> SqliteStakeholder::ReplaceNodeFunction(int old_node_id, int new_node_id)
 {
-    const auto& const_trans_hash { std::as_const(trans_hash_) };
     QMultiHash<int, int> hash {};
 
-    for (auto* trans : const_trans_hash) {
+    for (auto* trans : IndexedTrans(node_index_, old_node_id)) {
         if (trans->lhs_node == old_node_id) {
             hash.emplace(old_node_id, trans->id);
             trans->lhs_node = new_node_id;
+            IndexTrans(trans);
         }
+    }
 
-        if (trans->support_id == old_node_id) {
-            trans->support_id = new_node_id;
-        }
+    for (auto* trans : IndexedTrans(support_index_, old_node_id)) {
+        trans->support_id = new_node_id;
+        IndexTrans(trans);
     }
 
     return hash;
@@ -446,18 +583,20 @@ void SqliteStakeholder::WriteTransBind(TransShadow* trans_shadow, QSqlQuery& que
     query.bindValue(QStringLiteral(":unit_price"), *trans_shadow->unit_price);
     query.bindValue(QStringLiteral(":description"), *trans_shadow->description);
     query.bindValue(QStringLiteral(":state"), *trans_shadow->state);
-    query.bindValue(QStringLiteral(":document"), trans_shadow->document->join(kSemicolon));
     query.bindValue(QStringLiteral(":inside_product"), *trans_shadow->rhs_node);
     query.bindValue(QStringLiteral(":outside_product"), *trans_shadow->support_id);
 }
 
-void SqliteStakeholder::UpdateProductReferenceSO(int old_node_id, int new_node_id) const
+void SqliteStakeholder::UpdateProductReferenceSO(int old_node_id, int new_node_id)
 {
-    const auto& const_trans_hash { std::as_const(trans_hash_) };
+    DropPriceBook(PriceBookParty(old_node_id, true));
 
-    for (auto* trans : const_trans_hash)
-        if (trans->lhs_node == old_node_id)
+    for (auto* trans : IndexedTrans(node_index_, old_node_id)) {
+        if (trans->lhs_node == old_node_id) {
             trans->lhs_node = new_node_id;
+            IndexTrans(trans);
+        }
+    }
 }
 
 void SqliteStakeholder::ReadTransFunction(TransShadowList& trans_shadow_list, int /*node_id*/, QSqlQuery& query)
@@ -475,21 +614,20 @@ void SqliteStakeholder::ReadTransFunction(TransShadowList& trans_shadow_list, in
         trans->id = id;
 
         ReadTransQuery(trans, query);
-        trans_hash_.insert(id, trans);
+        InsertTrans(trans);
 
         ConvertTrans(trans, trans_shadow, true);
         trans_shadow_list.emplaceBack(trans_shadow);
     }
 }
 
-QString SqliteStakeholder::QSReadTransRangeFPTS(CString& in_list) const
+QString SqliteStakeholder::QSReadTransRangeFPTS() const
 {
     return QStringLiteral(R"(
-    SELECT id, date_time, code, outside_product, lhs_node, unit_price, description, document, state, inside_product
+    SELECT id, date_time, code, outside_product, lhs_node, unit_price, description, document_count, state, inside_product
     FROM stakeholder_transaction
-    WHERE id IN (%1) AND removed = 0
-    )")
-        .arg(in_list);
+    WHERE id IN (SELECT value FROM json_each(:id_list)) AND removed = 0
+    )");
 }
 
 void SqliteStakeholder::ReadNodeQuery(Node* node, const QSqlQuery& query) const
@@ -517,6 +655,6 @@ void SqliteStakeholder::ReadTransQuery(Trans* trans, const QSqlQuery& query) con
     trans->code = query.value(QStringLiteral("code")).toString();
     trans->description = query.value(QStringLiteral("description")).toString();
     trans->state = query.value(QStringLiteral("state")).toBool();
-    trans->document = query.value(QStringLiteral("document")).toString().split(kSemicolon, Qt::SkipEmptyParts);
+    trans->document = query.value(QStringLiteral("document_count")).toInt();
     trans->date_time = query.value(QStringLiteral("date_time")).toString();
 }
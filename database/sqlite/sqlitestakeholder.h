@@ -20,8 +20,17 @@
 #ifndef SQLITESTAKEHOLDER_H
 #define SQLITESTAKEHOLDER_H
 
+#include <QSet>
+
 #include "sqlite.h"
 
+// Latest price of one party by product, the ids resolve through trans_hash_
+// an edit of the party's trans, or a replace of a product it lists, drops only this book, it is read again on a worker thread
+struct PriceBook {
+    QHash<int, int> inside_product {}; // inside_product, trans_id
+    QHash<int, int> outside_product {}; // outside_product, trans_id
+};
+
 class SqliteStakeholder final : public Sqlite {
     Q_OBJECT
 
@@ -37,9 +46,12 @@ public slots:
     void RRemoveNode(int node_id, int node_type) override;
 
 public:
-    bool CrossSearch(TransShadow* order_trans_shadow, int party_id, int product_id, bool is_inside) const;
+    bool CrossSearch(TransShadow* order_trans_shadow, int party_id, int product_id, bool is_inside);
     bool UpdatePrice(int party_id, int inside_product_id, CString& date_time, double value);
-    bool ReadTrans(int node_id);
+    void ReadPriceBook(int party_id);
+
+    void AppendMemoryStat(QList<MemoryStat>& stat_list) const override;
+    void TrimCache() override;
 
 protected:
     // tree
@@ -60,11 +72,12 @@ protected:
     // table
     void ReadTransQuery(Trans* trans, const QSqlQuery& query) const override;
     void WriteTransBind(TransShadow* trans_shadow, QSqlQuery& query) const override;
-    void UpdateProductReferenceSO(int old_node_id, int new_node_id) const override;
+    void UpdateProductReferenceSO(int old_node_id, int new_node_id) override;
+    void TransChanged(const Trans* trans) override;
     void ReadTransFunction(TransShadowList& trans_shadow_list, int node_id, QSqlQuery& query) override;
-    QMultiHash<int, int> ReplaceNodeFunction(int old_node_id, int new_node_id) const override;
+    QMultiHash<int, int> ReplaceNodeFunction(int old_node_id, int new_node_id) override;
 
-    QString QSReadTransRangeFPTS(CString& in_list) const override;
+    QString QSReadTransRangeFPTS() const override;
     QString QSReadNodeTrans() const override;
     QString QSReadSupportTransFPTS() const override;
     QString QSWriteNodeTrans() const override;
@@ -75,13 +88,22 @@ protected:
     QString QSNodeTransToRemove() const override;
 
 private:
-    void ReadTransFunction(QSqlQuery& query);
     void WriteTransBind(Trans* trans, QSqlQuery& query) const;
 
     bool WriteTrans(Trans* trans);
     bool UpdateDateTimePrice(CString& date_time, double unit_price, int trans_id);
 
+    // one indexed lookup while the party's book is not read yet
+    Trans* LatestTrans(int party_id, int product_id, bool is_inside);
+    void BuildPriceBook(int party_id, const TransList& trans_list);
+    void IndexPrice(PriceBook& book, const Trans* trans) const;
+    // drops the books of the parties listed, and reads them again
+    void DropPriceBook(const QSet<int>& party_set);
+    QSet<int> PriceBookParty(int product_id, bool is_inside) const;
+
 private:
+    QHash<int, PriceBook> price_book_ {}; // party_id, price book shared by all order tabs
+    QHash<int, int> price_book_loading_ {}; // party_id, drops since the read started
 };
 
 #endif // SQLITESTAKEHOLDER_H
@@ -12,7 +12,7 @@ SqliteTask::SqliteTask(CInfo& info, QObject* parent)
 QString SqliteTask::QSReadNode() const
 {
     return QStringLiteral(R"(
-    SELECT name, id, code, description, note, rule, type, unit, color, document, date_time, finished, unit_cost, quantity, amount
+    SELECT name, id, code, description, note, rule, type, unit, color, document_count, date_time, finished, unit_cost, quantity, amount
     FROM task
     WHERE removed = 0
     )");
@@ -21,8 +21,8 @@ QString SqliteTask::QSReadNode() const
 QString SqliteTask::QSWriteNode() const
 {
     return QStringLiteral(R"(
-    INSERT INTO task (name, code, description, note, rule, type, unit, color, document, date_time, finished, unit_cost)
-    VALUES (:name, :code, :description, :note, :rule, :type, :unit, :color, :document, :date_time, :finished, :unit_cost)
+    INSERT INTO task (name, code, description, note, rule, type, unit, color, date_time, finished, unit_cost)
+    VALUES (:name, :code, :description, :note, :rule, :type, :unit, :color, :date_time, :finished, :unit_cost)
     )");
 }
 
@@ -136,16 +136,31 @@ QString SqliteTask::QSSupportTransToRemoveFPTS() const
 QString SqliteTask::QSReadNodeTrans() const
 {
     return QStringLiteral(R"(
-    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document, date_time
+    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
     FROM task_transaction
     WHERE (lhs_node = :node_id OR rhs_node = :node_id) AND removed = 0
     )");
 }
 
+QString SqliteTask::QSReadNodeTransWindowFPT() const
+{
+    return QStringLiteral(R"(
+    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
+    FROM task_transaction
+    WHERE lhs_node = :node_id AND date_time >= :start_date AND date_time < :next_date AND removed = 0
+
+    UNION ALL
+
+    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
+    FROM task_transaction
+    WHERE rhs_node = :node_id AND date_time >= :start_date AND date_time < :next_date AND removed = 0
+    )");
+}
+
 QString SqliteTask::QSReadSupportTransFPTS() const
 {
     return QStringLiteral(R"(
-    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document, date_time
+    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
     FROM task_transaction
     WHERE support_id = :node_id AND removed = 0
     )");
@@ -164,7 +179,7 @@ void SqliteTask::ReadTransQuery(Trans* trans, const QSqlQuery& query) const
     trans->unit_price = query.value(QStringLiteral("unit_cost")).toDouble();
     trans->code = query.value(QStringLiteral("code")).toString();
     trans->description = query.value(QStringLiteral("description")).toString();
-    trans->document = query.value(QStringLiteral("document")).toString().split(kSemicolon, Qt::SkipEmptyParts);
+    trans->document = query.value(QStringLiteral("document_count")).toInt();
     trans->date_time = query.value(QStringLiteral("date_time")).toString();
     trans->state = query.value(QStringLiteral("state")).toBool();
     trans->support_id = query.value(QStringLiteral("support_id")).toInt();
@@ -174,20 +189,19 @@ QString SqliteTask::QSWriteNodeTrans() const
 {
     return QStringLiteral(R"(
     INSERT INTO task_transaction
-    (date_time, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document)
+    (date_time, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code)
     VALUES
-    (:date_time, :lhs_node, :unit_cost, :lhs_debit, :lhs_credit, :rhs_node, :rhs_debit, :rhs_credit, :state, :description, :support_id, :code, :document)
+    (:date_time, :lhs_node, :unit_cost, :lhs_debit, :lhs_credit, :rhs_node, :rhs_debit, :rhs_credit, :state, :description, :support_id, :code)
     )");
 }
 
-QString SqliteTask::QSReadTransRangeFPTS(CString& in_list) const
+QString SqliteTask::QSReadTransRangeFPTS() const
 {
     return QString(R"(
-    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document, date_time
+    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
     FROM task_transaction
-    WHERE id IN (%1) AND removed = 0
-    )")
-        .arg(in_list);
+    WHERE id IN (SELECT value FROM json_each(:id_list)) AND removed = 0
+    )");
 }
 
 QString SqliteTask::QSReplaceNodeTransFPTS() const
@@ -217,7 +231,6 @@ void SqliteTask::WriteTransBind(TransShadow* trans_shadow, QSqlQuery& query) con
     query.bindValue(QStringLiteral(":state"), *trans_shadow->state);
     query.bindValue(QStringLiteral(":description"), *trans_shadow->description);
     query.bindValue(QStringLiteral(":code"), *trans_shadow->code);
-    query.bindValue(QStringLiteral(":document"), trans_shadow->document->join(kSemicolon));
     query.bindValue(QStringLiteral(":support_id"), *trans_shadow->support_id);
 
     query.bindValue(QStringLiteral(":lhs_node"), *trans_shadow->lhs_node);
@@ -253,7 +266,6 @@ void SqliteTask::WriteNodeBind(Node* node, QSqlQuery& query) const
     query.bindValue(QStringLiteral(":date_time"), node->date_time);
     query.bindValue(QStringLiteral(":unit_cost"), node->first);
     query.bindValue(QStringLiteral(":finished"), node->finished);
-    query.bindValue(QStringLiteral(":document"), node->document.join(kSemicolon));
 }
 
 void SqliteTask::ReadNodeQuery(Node* node, const QSqlQuery& query) const
@@ -272,7 +284,7 @@ void SqliteTask::ReadNodeQuery(Node* node, const QSqlQuery& query) const
     node->first = query.value(QStringLiteral("unit_cost")).toDouble();
     node->date_time = query.value(QStringLiteral("date_time")).toString();
     node->finished = query.value(QStringLiteral("finished")).toBool();
-    node->document = query.value(QStringLiteral("document")).toString().split(kSemicolon, Qt::SkipEmptyParts);
+    node->document = query.value(QStringLiteral("document_count")).toInt();
 }
 
 QString SqliteTask::QSUpdateNodeValueFPTO() const
@@ -294,7 +306,7 @@ void SqliteTask::UpdateNodeValueBindFPTO(const Node* node, QSqlQuery& query) con
 QString SqliteTask::QSSearchTrans() const
 {
     return QStringLiteral(R"(
-    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document, date_time
+    SELECT id, lhs_node, unit_cost, lhs_debit, lhs_credit, rhs_node, rhs_debit, rhs_credit, state, description, support_id, code, document_count, date_time
     FROM task_transaction
     WHERE (lhs_debit = :text OR lhs_credit = :text OR rhs_debit = :text OR rhs_credit = :text OR description LIKE :description) AND removed = 0
     ORDER BY date_time
@@ -42,9 +42,10 @@ protected:
     QString QSSupportTransToRemoveFPTS() const override;
 
     QString QSReadNodeTrans() const override;
+    QString QSReadNodeTransWindowFPT() const override;
     QString QSReadSupportTransFPTS() const override;
     QString QSWriteNodeTrans() const override;
-    QString QSReadTransRangeFPTS(CString& in_list) const override;
+    QString QSReadTransRangeFPTS() const override;
     QString QSReplaceNodeTransFPTS() const override;
     QString QSUpdateTransValueFPTO() const override;
     QString QSSearchTrans() const override;
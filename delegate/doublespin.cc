@@ -38,11 +38,11 @@ void DoubleSpin::paint(QPainter* painter, const QStyleOptionViewItem& option, co
     if (value == 0)
         return QStyledItemDelegate::paint(painter, option, index);
 
-    PaintText(locale_.toString(value, 'f', decimal_), painter, option, index, Qt::AlignRight | Qt::AlignVCenter);
+    PaintText(FormatNumber(value, decimal_), painter, option, index, Qt::AlignRight | Qt::AlignVCenter);
 }
 
 QSize DoubleSpin::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
 {
     const double value { index.data().toDouble() };
-    return CalculateTextSize(locale_.toString(value, 'f', decimal_), option);
+    return CalculateTextSize(FormatNumber(value, decimal_), option);
 }
@@ -25,5 +25,5 @@ QString DoubleSpinUnitR::Format(const QModelIndex& index) const
     auto it { unit_symbol_map_.constFind(unit_) };
     auto symbol { (it != unit_symbol_map_.constEnd()) ? it.value() : kEmptyString };
 
-    return symbol + locale_.toString(index.data().toDouble(), 'f', decimal_);
+    return symbol + FormatNumber(index.data().toDouble(), decimal_);
 }
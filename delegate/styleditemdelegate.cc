@@ -1,10 +1,19 @@
 #include "styleditemdelegate.h"
 
 #include <QApplication>
+#include <QDateTime>
 #include <QFontMetrics>
 
+#include "component/constvalue.h"
+
 const QLocale StyledItemDelegate::locale_ { QLocale::English, QLocale::UnitedStates };
 
+QHash<std::pair<double, int>, QString> StyledItemDelegate::number_cache_ {};
+QHash<std::pair<QString, QString>, QString> StyledItemDelegate::date_time_cache_ {};
+QHash<QString, int> StyledItemDelegate::width_cache_ {};
+QString StyledItemDelegate::width_font_ {};
+int StyledItemDelegate::font_height_ {};
+
 StyledItemDelegate::StyledItemDelegate(QObject* parent)
     : QStyledItemDelegate { parent }
 {
@@ -17,16 +26,65 @@ void StyledItemDelegate::updateEditorGeometry(QWidget* editor, const QStyleOptio
     editor->setGeometry(option.rect);
 }
 
+void StyledItemDelegate::ClearCache()
+{
+    number_cache_.clear();
+    date_time_cache_.clear();
+    width_cache_.clear();
+    width_font_.clear();
+}
+
 QSize StyledItemDelegate::CalculateTextSize(CString& text, const QStyleOptionViewItem& option)
 {
     const int text_margin { QApplication::style()->pixelMetric(QStyle::PM_FocusFrameHMargin, nullptr, option.widget) };
-    const QFontMetrics fm(option.font);
-    const int width { std::max(fm.horizontalAdvance(text) + coefficient_ * text_margin, option.rect.width()) };
-    const int height { std::max(fm.height(), option.rect.height()) };
+
+    if (CString& font { option.font.key() }; font != width_font_) {
+        width_cache_.clear();
+        width_font_ = font;
+        font_height_ = QFontMetrics(option.font).height();
+    }
+
+    auto it { width_cache_.constFind(text) };
+    if (it == width_cache_.constEnd()) {
+        if (width_cache_.size() >= kDelegateCacheSize)
+            width_cache_.clear();
+
+        it = width_cache_.insert(text, QFontMetrics(option.font).horizontalAdvance(text));
+    }
+
+    const int width { std::max(it.value() + coefficient_ * text_margin, option.rect.width()) };
+    const int height { std::max(font_height_, option.rect.height()) };
 
     return QSize(width, height);
 }
 
+QString StyledItemDelegate::FormatNumber(double value, int decimal)
+{
+    const auto key { std::make_pair(value, decimal) };
+
+    if (auto it = number_cache_.constFind(key); it != number_cache_.constEnd())
+        return it.value();
+
+    if (number_cache_.size() >= kDelegateCacheSize)
+        number_cache_.clear();
+
+    return number_cache_.insert(key, locale_.toString(value, 'f', decimal)).value();
+}
+
+QString StyledItemDelegate::FormatDateTime(CString& date_time, CString& date_format)
+{
+    const auto key { std::make_pair(date_time, date_format) };
+
+    if (auto it = date_time_cache_.constFind(key); it != date_time_cache_.constEnd())
+        return it.value();
+
+    if (date_time_cache_.size() >= kDelegateCacheSize)
+        date_time_cache_.clear();
+
+    // An unparsable value is cached as empty too, so it is not parsed again on the next paint
+    return date_time_cache_.insert(key, QDateTime::fromString(date_time, kDateTimeFST).toString(date_format)).value();
+}
+
 void StyledItemDelegate::PaintText(
     CString& text, QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index, Qt::Alignment alignment) const
 {
@@ -30,8 +30,13 @@ public:
     explicit StyledItemDelegate(QObject* parent = nullptr);
     void updateEditorGeometry(QWidget* editor, const QStyleOptionViewItem& option, const QModelIndex& index) const override;
 
+    // Shared by all delegates, call when font, separator or display preferences change
+    static void ClearCache();
+
 protected:
     static QSize CalculateTextSize(CString& text, const QStyleOptionViewItem& option);
+    static QString FormatNumber(double value, int decimal);
+    static QString FormatDateTime(CString& date_time, CString& date_format);
 
     void PaintText(CString& text, QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index, Qt::Alignment alignment) const;
     void PaintCheckBox(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const;
@@ -40,6 +45,13 @@ protected:
     static const QLocale locale_;
 
 private:
+    // Keys carry the value and its format, so a rename or a decimal change produces a new key instead of a stale entry
+    static QHash<std::pair<double, int>, QString> number_cache_;
+    static QHash<std::pair<QString, QString>, QString> date_time_cache_;
+    static QHash<QString, int> width_cache_;
+    static QString width_font_;
+    static int font_height_;
+
     static constexpr int coefficient_ =
 #ifdef Q_OS_WIN
         6;
@@ -28,5 +28,5 @@ QString FinanceForeignR::Format(const QModelIndex& index) const
     auto it { unit_symbol_map_.constFind(unit) };
     auto symbol { (it != unit_symbol_map_.constEnd()) ? it.value() : kEmptyString };
 
-    return symbol + locale_.toString(value, 'f', decimal_);
+    return symbol + FormatNumber(value, decimal_);
 }
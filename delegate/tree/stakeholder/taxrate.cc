@@ -43,11 +43,11 @@ void TaxRate::paint(QPainter* painter, const QStyleOptionViewItem& option, const
     if (value == 0)
         return QStyledItemDelegate::paint(painter, option, index);
 
-    PaintText(locale_.toString(value, 'f', decimal_) + kSuffixPERCENT, painter, option, index, Qt::AlignRight | Qt::AlignVCenter);
+    PaintText(FormatNumber(value, decimal_) + kSuffixPERCENT, painter, option, index, Qt::AlignRight | Qt::AlignVCenter);
 }
 
 QSize TaxRate::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
 {
     const double value { index.data().toDouble() * kHundred };
-    return CalculateTextSize(locale_.toString(value, 'f', decimal_) + kSuffixPERCENT, option);
+    return CalculateTextSize(FormatNumber(value, decimal_) + kSuffixPERCENT, option);
 }
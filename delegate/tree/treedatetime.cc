@@ -37,15 +37,14 @@ void TreeDateTime::setModelData(QWidget* editor, QAbstractItemModel* model, cons
 
 void TreeDateTime::paint(QPainter* painter, const QStyleOptionViewItem& option, const QModelIndex& index) const
 {
-    auto date_time { index.data().toDateTime() };
-    if (!date_time.isValid())
+    CString text { FormatDateTime(index.data().toString(), date_format_) };
+    if (text.isEmpty())
         return QStyledItemDelegate::paint(painter, option, index);
 
-    PaintText(date_time.toString(date_format_), painter, option, index, Qt::AlignCenter);
+    PaintText(text, painter, option, index, Qt::AlignCenter);
 }
 
 QSize TreeDateTime::sizeHint(const QStyleOptionViewItem& option, const QModelIndex& index) const
 {
-    auto text { index.data().toDateTime().toString(date_format_) };
-    return CalculateTextSize(text, option);
+    return CalculateTextSize(FormatDateTime(index.data().toString(), date_format_), option);
 }
@@ -0,0 +1,64 @@
+#include "aging.h"
+
+#include <QHeaderView>
+
+#include "component/enumclass.h"
+#include "component/signalblocker.h"
+#include "delegate/readonly/doublespinr.h"
+#include "ui_aging.h"
+
+Aging::Aging(CTreeModel* stakeholder_tree, SqliteOrder* sql, CSettings* settings, QWidget* parent)
+    : QDialog(parent)
+    , ui(new Ui::Aging)
+    , sql_ { sql }
+    , settings_ { settings }
+{
+    ui->setupUi(this);
+    SignalBlocker blocker(this);
+
+    model_ = new AgingModel(stakeholder_tree, sql, this);
+
+    IniDialog();
+    IniView(ui->tableView);
+    IniConnect();
+
+    RUpdateAging();
+}
+
+Aging::~Aging() { delete ui; }
+
+void Aging::RUpdateAging() { model_->Query(ui->dateEdit->date()); }
+
+void Aging::IniDialog()
+{
+    ui->dateEdit->setDisplayFormat(kDateFST);
+    ui->dateEdit->setDate(QDate::currentDate());
+
+    ui->pBtnClose->setAutoDefault(false);
+    this->setWindowTitle(tr("Aging"));
+}
+
+void Aging::IniConnect()
+{
+    connect(ui->dateEdit, &QDateEdit::dateChanged, this, &Aging::RUpdateAging);
+    connect(sql_, &SqliteOrder::SUpdateAging, this, &Aging::RUpdateAging);
+}
+
+void Aging::IniView(QTableView* view)
+{
+    view->setModel(model_);
+    view->setSortingEnabled(true);
+    view->setSelectionMode(QAbstractItemView::SingleSelection);
+    view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    view->setAlternatingRowColors(true);
+    view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view->verticalHeader()->setHidden(true);
+
+    auto* amount { new DoubleSpinR(settings_->amount_decimal, true, view) };
+    for (int column = std::to_underlying(TableEnumAging::kCurrent); column <= std::to_underlying(TableEnumAging::kTotal); ++column)
+        view->setItemDelegateForColumn(column, amount);
+
+    auto* header { view->horizontalHeader() };
+    header->setSectionResizeMode(QHeaderView::ResizeToContents);
+    header->setSectionResizeMode(std::to_underlying(TableEnumAging::kParty), QHeaderView::Stretch);
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef AGING_H
+#define AGING_H
+
+#include <QDialog>
+#include <QTableView>
+
+#include "component/settings.h"
+#include "table/agingmodel.h"
+
+namespace Ui {
+class Aging;
+}
+
+class Aging final : public QDialog {
+    Q_OBJECT
+
+public:
+    Aging(CTreeModel* stakeholder_tree, SqliteOrder* sql, CSettings* settings, QWidget* parent = nullptr);
+    ~Aging();
+
+public slots:
+    void RUpdateAging();
+
+private:
+    void IniDialog();
+    void IniConnect();
+    void IniView(QTableView* view);
+
+private:
+    Ui::Aging* ui;
+
+    AgingModel* model_ {};
+    SqliteOrder* sql_ {};
+    CSettings* settings_ {};
+};
+
+#endif // AGING_H
@@ -0,0 +1,75 @@
+#include "balance.h"
+
+#include <QHeaderView>
+
+#include "component/enumclass.h"
+#include "component/signalblocker.h"
+#include "delegate/readonly/doublespinr.h"
+#include "ui_balance.h"
+
+Balance::Balance(CSettings* settings, Sqlite* sql, int node_id, bool rule, CString& name, QWidget* parent)
+    : QDialog(parent)
+    , ui(new Ui::Balance)
+    , settings_ { settings }
+{
+    ui->setupUi(this);
+    SignalBlocker blocker(this);
+
+    model_ = new BalanceModel(sql, node_id, rule, this);
+
+    IniDialog(name);
+    IniView(ui->tableView);
+    IniConnect();
+
+    RUpdateBalance();
+}
+
+Balance::~Balance() { delete ui; }
+
+void Balance::RUpdateBalance()
+{
+    const BalancePeriod period { ui->comboPeriod->currentData().toInt() };
+    model_->Query(period, ui->dateEditStart->date(), ui->dateEditEnd->date());
+}
+
+void Balance::IniDialog(CString& name)
+{
+    ui->comboPeriod->addItem(tr("Day"), std::to_underlying(BalancePeriod::kDay));
+    ui->comboPeriod->addItem(tr("Week"), std::to_underlying(BalancePeriod::kWeek));
+    ui->comboPeriod->addItem(tr("Month"), std::to_underlying(BalancePeriod::kMonth));
+    ui->comboPeriod->setCurrentIndex(std::to_underlying(BalancePeriod::kMonth));
+
+    const QDate current_date { QDate::currentDate() };
+    ui->dateEditStart->setDisplayFormat(kDateFST);
+    ui->dateEditEnd->setDisplayFormat(kDateFST);
+    ui->dateEditStart->setDate(current_date.addYears(-1));
+    ui->dateEditEnd->setDate(current_date);
+
+    ui->pBtnClose->setAutoDefault(false);
+    this->setWindowTitle(name);
+}
+
+void Balance::IniConnect()
+{
+    connect(ui->comboPeriod, &QComboBox::currentIndexChanged, this, &Balance::RUpdateBalance);
+    connect(ui->dateEditStart, &QDateEdit::dateChanged, this, &Balance::RUpdateBalance);
+    connect(ui->dateEditEnd, &QDateEdit::dateChanged, this, &Balance::RUpdateBalance);
+}
+
+void Balance::IniView(QTableView* view)
+{
+    view->setModel(model_);
+    view->setSelectionMode(QAbstractItemView::SingleSelection);
+    view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    view->setAlternatingRowColors(true);
+    view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view->verticalHeader()->setHidden(true);
+
+    auto* value { new DoubleSpinR(settings_->common_decimal, false, view) };
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumBalance::kChange), value);
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumBalance::kBalance), value);
+
+    auto* header { view->horizontalHeader() };
+    header->setSectionResizeMode(QHeaderView::ResizeToContents);
+    header->setSectionResizeMode(std::to_underlying(TableEnumBalance::kBalance), QHeaderView::Stretch);
+}
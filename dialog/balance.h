@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BALANCE_H
+#define BALANCE_H
+
+#include <QDialog>
+#include <QTableView>
+
+#include "component/settings.h"
+#include "table/balancemodel.h"
+
+namespace Ui {
+class Balance;
+}
+
+class Balance final : public QDialog {
+    Q_OBJECT
+
+public:
+    Balance(CSettings* settings, Sqlite* sql, int node_id, bool rule, CString& name, QWidget* parent = nullptr);
+    ~Balance();
+
+public slots:
+    void RUpdateBalance();
+
+private:
+    void IniDialog(CString& name);
+    void IniConnect();
+    void IniView(QTableView* view);
+
+private:
+    Ui::Balance* ui;
+
+    BalanceModel* model_ {};
+    CSettings* settings_ {};
+};
+
+#endif // BALANCE_H
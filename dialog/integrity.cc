@@ -0,0 +1,130 @@
+#include "integrity.h"
+
+#include <QFutureWatcher>
+#include <QHeaderView>
+
+#include "component/enumclass.h"
+#include "component/signalblocker.h"
+#include "ui_integrity.h"
+
+Integrity::Integrity(const QList<IntegritySection>& section_list, QWidget* parent)
+    : QDialog(parent)
+    , ui(new Ui::Integrity)
+    , section_list_ { section_list }
+{
+    ui->setupUi(this);
+    SignalBlocker blocker(this);
+
+    model_ = new IntegrityModel(section_list, this);
+
+    IniDialog();
+    IniView(ui->tableView);
+    IniConnect();
+
+    RCheck();
+}
+
+Integrity::~Integrity() { delete ui; }
+
+void Integrity::RCheck()
+{
+    if (pending_ != 0)
+        return;
+
+    model_->Clear();
+    result_hash_.clear();
+
+    ui->pBtnCheck->setEnabled(false);
+    ui->pBtnRepair->setEnabled(false);
+    ui->labelStatus->setText(tr("Checking..."));
+
+    // every section reads on its own worker connection, so they run side by side
+    pending_ = section_list_.size();
+
+    for (const auto& section : std::as_const(section_list_)) {
+        auto* watcher { new QFutureWatcher<IntegrityResult>(this) };
+
+        connect(watcher, &QFutureWatcher<IntegrityResult>::finished, this, [this, watcher, section]() {
+            CheckFinished(section, watcher->result());
+            watcher->deleteLater();
+        });
+
+        watcher->setFuture(section.sql->CheckIntegrity());
+    }
+}
+
+void Integrity::CheckFinished(const IntegritySection& section, const IntegrityResult& result)
+{
+    auto& section_result { result_hash_[section.section] };
+    section_result = result;
+
+    // branch totals only live in memory, they are compared on this thread once the leaves are known
+    section.tree->CheckBranchTotalFPT(section_result.issue_list);
+    model_->Append(section_result.issue_list);
+
+    if (--pending_ != 0)
+        return;
+
+    const int count { model_->rowCount() };
+
+    ui->labelStatus->setText(count == 0 ? tr("No issue found.") : tr("%1 issue(s) found.").arg(count));
+    ui->pBtnCheck->setEnabled(true);
+    ui->pBtnRepair->setEnabled(count != 0);
+}
+
+void Integrity::RRepair()
+{
+    if (pending_ != 0)
+        return;
+
+    bool ok { true };
+
+    for (const auto& section : std::as_const(section_list_)) {
+        const auto it { result_hash_.constFind(section.section) };
+        if (it == result_hash_.constEnd() || it->issue_list.isEmpty())
+            continue;
+
+        // one transaction per section, the tree follows only once the file holds the repaired rows
+        if (!section.sql->RepairIntegrity(it.value())) {
+            ok = false;
+            continue;
+        }
+
+        section.tree->RepairTotalFPT(it->leaf_hash);
+    }
+
+    if (!ok) {
+        ui->labelStatus->setText(tr("Repair failed, nothing was written for the sections with errors."));
+        return;
+    }
+
+    // closure rows are read when the file opens, a repaired hierarchy shows after reopening it
+    RCheck();
+}
+
+void Integrity::IniDialog()
+{
+    ui->pBtnClose->setAutoDefault(false);
+    ui->pBtnRepair->setEnabled(false);
+    this->setWindowTitle(tr("Integrity"));
+}
+
+void Integrity::IniConnect()
+{
+    connect(ui->pBtnCheck, &QPushButton::clicked, this, &Integrity::RCheck);
+    connect(ui->pBtnRepair, &QPushButton::clicked, this, &Integrity::RRepair);
+}
+
+void Integrity::IniView(QTableView* view)
+{
+    view->setModel(model_);
+    view->setSelectionMode(QAbstractItemView::SingleSelection);
+    view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    view->setAlternatingRowColors(true);
+    view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view->verticalHeader()->setHidden(true);
+
+    auto* header { view->horizontalHeader() };
+    header->setSectionResizeMode(QHeaderView::ResizeToContents);
+    header->setSectionResizeMode(std::to_underlying(TableEnumIntegrity::kNode), QHeaderView::Stretch);
+}
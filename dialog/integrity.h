@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef INTEGRITY_H
+#define INTEGRITY_H
+
+#include <QDialog>
+#include <QTableView>
+
+#include "table/integritymodel.h"
+
+namespace Ui {
+class Integrity;
+}
+
+class Integrity final : public QDialog {
+    Q_OBJECT
+
+public:
+    Integrity(const QList<IntegritySection>& section_list, QWidget* parent = nullptr);
+    ~Integrity();
+
+public slots:
+    void RCheck();
+    void RRepair();
+
+private:
+    void IniDialog();
+    void IniConnect();
+    void IniView(QTableView* view);
+
+    void CheckFinished(const IntegritySection& section, const IntegrityResult& result);
+
+private:
+    Ui::Integrity* ui;
+
+    IntegrityModel* model_ {};
+    QList<IntegritySection> section_list_ {};
+
+    QHash<Section, IntegrityResult> result_hash_ {};
+    int pending_ {};
+};
+
+#endif // INTEGRITY_H
@@ -0,0 +1,79 @@
+#include "memory.h"
+
+#include <QHeaderView>
+#include <QLocale>
+
+#include "component/enumclass.h"
+#include "component/signalblocker.h"
+#include "ui_memory.h"
+
+Memory::Memory(const QList<MemorySection>& section_list, QWidget* parent)
+    : QDialog(parent)
+    , ui(new Ui::Memory)
+    , section_list_ { section_list }
+{
+    ui->setupUi(this);
+    SignalBlocker blocker(this);
+
+    model_ = new MemoryModel(section_list, this);
+
+    IniDialog();
+    IniView(ui->tableView);
+    IniConnect();
+
+    RRefresh();
+}
+
+Memory::~Memory() { delete ui; }
+
+void Memory::RRefresh()
+{
+    model_->Refresh();
+    ui->labelStatus->setText(tr("About %1 in use.").arg(QLocale().formattedDataSize(model_->TotalBytes())));
+}
+
+void Memory::RTrim()
+{
+    const qsizetype before { model_->TotalBytes() };
+
+    // trans behind open tables, nodes and paths stay, only what is read again on demand goes
+    for (const auto& section : std::as_const(section_list_))
+        section.sql->TrimCache();
+
+    ResourcePool<Node>::Instance().Trim();
+    ResourcePool<NodeShadow>::Instance().Trim();
+    ResourcePool<Trans>::Instance().Trim();
+    ResourcePool<TransShadow>::Instance().Trim();
+
+    model_->Refresh();
+
+    const QLocale locale {};
+    const qsizetype freed { std::max(before - model_->TotalBytes(), qsizetype(0)) };
+    ui->labelStatus->setText(tr("About %1 in use, %2 freed.").arg(locale.formattedDataSize(model_->TotalBytes()), locale.formattedDataSize(freed)));
+}
+
+void Memory::IniDialog()
+{
+    ui->pBtnClose->setAutoDefault(false);
+    this->setWindowTitle(tr("Memory"));
+}
+
+void Memory::IniConnect()
+{
+    connect(ui->pBtnRefresh, &QPushButton::clicked, this, &Memory::RRefresh);
+    connect(ui->pBtnTrim, &QPushButton::clicked, this, &Memory::RTrim);
+}
+
+void Memory::IniView(QTableView* view)
+{
+    view->setModel(model_);
+    view->setSelectionMode(QAbstractItemView::SingleSelection);
+    view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    view->setAlternatingRowColors(true);
+    view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view->verticalHeader()->setHidden(true);
+
+    auto* header { view->horizontalHeader() };
+    header->setSectionResizeMode(QHeaderView::ResizeToContents);
+    header->setSectionResizeMode(std::to_underlying(TableEnumMemory::kItem), QHeaderView::Stretch);
+}
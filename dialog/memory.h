@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MEMORY_H
+#define MEMORY_H
+
+#include <QDialog>
+#include <QTableView>
+
+#include "table/memorymodel.h"
+
+namespace Ui {
+class Memory;
+}
+
+class Memory final : public QDialog {
+    Q_OBJECT
+
+public:
+    Memory(const QList<MemorySection>& section_list, QWidget* parent = nullptr);
+    ~Memory();
+
+public slots:
+    void RRefresh();
+    void RTrim();
+
+private:
+    void IniDialog();
+    void IniConnect();
+    void IniView(QTableView* view);
+
+private:
+    Ui::Memory* ui;
+
+    MemoryModel* model_ {};
+    QList<MemorySection> section_list_ {};
+};
+
+#endif // MEMORY_H
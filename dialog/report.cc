@@ -0,0 +1,83 @@
+#include "report.h"
+
+#include <QHeaderView>
+
+#include "component/enumclass.h"
+#include "component/signalblocker.h"
+#include "delegate/readonly/doublespinr.h"
+#include "ui_report.h"
+
+Report::Report(CTreeModel* stakeholder_tree, CTreeModel* product_tree, CSettings* settings, SqliteOrder* sql, QWidget* parent)
+    : QDialog(parent)
+    , ui(new Ui::Report)
+    , sql_ { sql }
+    , settings_ { settings }
+{
+    ui->setupUi(this);
+    SignalBlocker blocker(this);
+
+    model_ = new ReportModel(stakeholder_tree, product_tree, sql, this);
+
+    IniDialog();
+    IniView(ui->tableView);
+    IniConnect();
+
+    RUpdateReport();
+}
+
+Report::~Report() { delete ui; }
+
+void Report::RUpdateReport()
+{
+    const ReportGroup group { ui->comboGroup->currentData().toInt() };
+    model_->Query(group, ui->dateEditStart->date(), ui->dateEditEnd->date());
+}
+
+void Report::IniDialog()
+{
+    ui->comboGroup->addItem(tr("Party"), std::to_underlying(ReportGroup::kParty));
+    ui->comboGroup->addItem(tr("Product"), std::to_underlying(ReportGroup::kProduct));
+    ui->comboGroup->addItem(tr("Employee"), std::to_underlying(ReportGroup::kEmployee));
+    ui->comboGroup->addItem(tr("Period"), std::to_underlying(ReportGroup::kPeriod));
+
+    const QDate current_date { QDate::currentDate() };
+    ui->dateEditStart->setDisplayFormat(kDateFST);
+    ui->dateEditEnd->setDisplayFormat(kDateFST);
+    ui->dateEditStart->setDate(QDate(current_date.year(), 1, 1));
+    ui->dateEditEnd->setDate(current_date);
+
+    ui->pBtnClose->setAutoDefault(false);
+    this->setWindowTitle(tr("Report"));
+}
+
+void Report::IniConnect()
+{
+    connect(ui->comboGroup, &QComboBox::currentIndexChanged, this, &Report::RUpdateReport);
+    connect(ui->dateEditStart, &QDateEdit::dateChanged, this, &Report::RUpdateReport);
+    connect(ui->dateEditEnd, &QDateEdit::dateChanged, this, &Report::RUpdateReport);
+    connect(sql_, &SqliteOrder::SUpdateReport, this, &Report::RUpdateReport);
+}
+
+void Report::IniView(QTableView* view)
+{
+    view->setModel(model_);
+    view->setSortingEnabled(true);
+    view->setSelectionMode(QAbstractItemView::SingleSelection);
+    view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    view->setAlternatingRowColors(true);
+    view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view->verticalHeader()->setHidden(true);
+
+    auto* value { new DoubleSpinR(settings_->common_decimal, true, view) };
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumReport::kFirst), value);
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumReport::kSecond), value);
+
+    auto* amount { new DoubleSpinR(settings_->amount_decimal, true, view) };
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumReport::kAmount), amount);
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumReport::kDiscount), amount);
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumReport::kSettled), amount);
+
+    auto* header { view->horizontalHeader() };
+    header->setSectionResizeMode(QHeaderView::ResizeToContents);
+    header->setSectionResizeMode(std::to_underlying(TableEnumReport::kKey), QHeaderView::Stretch);
+}
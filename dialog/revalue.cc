@@ -0,0 +1,59 @@
+#include "revalue.h"
+
+#include <QMessageBox>
+#include <QStandardItemModel>
+#include <cmath>
+
+#include "component/signalblocker.h"
+#include "ui_revalue.h"
+
+Revalue::Revalue(CTreeModel* model, CStringMap& unit_map, int default_unit, int decimal, QWidget* parent)
+    : QDialog(parent)
+    , ui(new Ui::Revalue)
+{
+    ui->setupUi(this);
+    SignalBlocker blocker(this);
+
+    IniData(model, unit_map, default_unit, decimal);
+}
+
+Revalue::~Revalue() { delete ui; }
+
+void Revalue::on_pBtnOk_clicked()
+{
+    if (ui->comboUnit->currentIndex() == -1 || ui->comboGainLoss->currentIndex() == -1)
+        return;
+
+    QMessageBox msg(this);
+    msg.setIcon(QMessageBox::Question);
+    msg.setStandardButtons(QMessageBox::Ok | QMessageBox::Cancel);
+    msg.setText(tr("Revalue"));
+    msg.setInformativeText(tr("Revalue every %1 balance at %2 and post the differences against %3. Are you sure?")
+                               .arg(ui->comboUnit->currentText(), ui->dSpinRate->text(), ui->comboGainLoss->currentText()));
+
+    if (msg.exec() == QMessageBox::Ok) {
+        emit SRevalue(ui->comboUnit->currentData().toInt(), ui->dSpinRate->value(), ui->comboGainLoss->currentData().toInt());
+        accept();
+    }
+}
+
+void Revalue::IniData(CTreeModel* model, CStringMap& unit_map, int default_unit, int decimal)
+{
+    for (auto it = unit_map.cbegin(); it != unit_map.cend(); ++it) {
+        if (it.key() != default_unit)
+            ui->comboUnit->addItem(it.value(), it.key());
+    }
+
+    ui->dSpinRate->setDecimals(decimal);
+    ui->dSpinRate->setRange(std::pow(10.0, -decimal), std::numeric_limits<double>::max());
+    ui->dSpinRate->setValue(1.0);
+    ui->dSpinRate->setButtonSymbols(QAbstractSpinBox::NoButtons);
+
+    // the differences are base currency amounts, so only a leaf in the default unit takes them
+    auto* combo_model { new QStandardItemModel(this) };
+    model->LeafPathFilterModelFPTS(combo_model, default_unit, 0);
+    ui->comboGainLoss->setModel(combo_model);
+
+    ui->pBtnCancel->setDefault(true);
+    ui->pBtnOk->setEnabled(ui->comboUnit->count() != 0);
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef REVALUE_H
+#define REVALUE_H
+
+#include <QDialog>
+
+#include "tree/model/treemodel.h"
+
+namespace Ui {
+class Revalue;
+}
+
+class Revalue final : public QDialog {
+    Q_OBJECT
+
+public:
+    Revalue(CTreeModel* model, CStringMap& unit_map, int default_unit, int decimal, QWidget* parent = nullptr);
+    ~Revalue();
+
+signals:
+    // send to mainwindow
+    void SRevalue(int unit, double rate, int gain_loss_node);
+
+private slots:
+    void on_pBtnOk_clicked();
+
+private:
+    void IniData(CTreeModel* model, CStringMap& unit_map, int default_unit, int decimal);
+
+private:
+    Ui::Revalue* ui;
+};
+
+#endif // REVALUE_H
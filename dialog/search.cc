@@ -2,6 +2,7 @@
 
 #include <QHeaderView>
 
+#include "component/constvalue.h"
 #include "component/enumclass.h"
 #include "component/signalblocker.h"
 #include "delegate/readonly/checkboxr.h"
@@ -12,7 +13,8 @@
 #include "delegate/search/searchpathtreer.h"
 #include "ui_search.h"
 
-Search::Search(CTreeModel* tree, CTreeModel* stakeholder_tree, CTreeModel* product_tree, CSettings* settings, Sqlite* sql, CInfo& info, QWidget* parent)
+Search::Search(CTreeModel* tree, CTreeModel* stakeholder_tree, CTreeModel* product_tree, CSettings* settings, Sqlite* sql, CInfo& info,
+    const QList<SearchSection>& section_list, QWidget* parent)
     : QDialog(parent)
     , ui(new Ui::Search)
     , sql_ { sql }
@@ -27,6 +29,11 @@ Search::Search(CTreeModel* tree, CTreeModel* stakeholder_tree, CTreeModel* produ
 
     search_tree_ = new SearchNodeModel(info, tree_, stakeholder_tree, sql, this);
     search_table_ = new SearchTransModel(info, sql, this);
+    search_all_ = new SearchAllModel(section_list, stakeholder_tree, this);
+
+    search_timer_ = new QTimer(this);
+    search_timer_->setSingleShot(true);
+    search_timer_->setInterval(kSearchDelay);
 
     TreeViewDelegate(ui->searchViewNode, search_tree_);
     TableViewDelegate(ui->searchViewTrans, search_table_);
@@ -34,6 +41,11 @@ Search::Search(CTreeModel* tree, CTreeModel* stakeholder_tree, CTreeModel* produ
 
     IniView(ui->searchViewNode);
     IniView(ui->searchViewTrans);
+    IniView(ui->searchViewAll);
+
+    // hits stay in rank order
+    ui->searchViewAll->setSortingEnabled(false);
+    ui->searchViewAll->setModel(search_all_);
 
     ResizeTreeColumn(ui->searchViewNode->horizontalHeader());
     ResizeTableColumn(ui->searchViewTrans->horizontalHeader());
@@ -55,9 +67,16 @@ void Search::IniDialog()
 
 void Search::IniConnect()
 {
+    connect(ui->lineEdit, &QLineEdit::returnPressed, search_timer_, &QTimer::stop);
     connect(ui->lineEdit, &QLineEdit::returnPressed, this, &Search::RSearch);
+    connect(ui->lineEdit, &QLineEdit::textChanged, search_timer_, qOverload<>(&QTimer::start));
+    connect(search_timer_, &QTimer::timeout, this, &Search::RSearch);
+    connect(search_tree_, &SearchNodeModel::SQueryFinished, this, &Search::RNodeQueryFinished);
+    connect(search_table_, &SearchTransModel::SQueryFinished, this, &Search::RTransQueryFinished);
+    connect(search_all_, &SearchAllModel::SQueryFinished, this, &Search::RAllQueryFinished);
     connect(ui->searchViewNode, &QTableView::doubleClicked, this, &Search::RDoubleClicked);
     connect(ui->searchViewTrans, &QTableView::doubleClicked, this, &Search::RDoubleClicked);
+    connect(ui->searchViewAll, &QTableView::doubleClicked, this, &Search::RDoubleClicked);
 }
 
 void Search::HideTreeColumn(QTableView* view, Section section)
@@ -258,22 +277,43 @@ void Search::RSearch()
 {
     CString kText { ui->lineEdit->text() };
 
-    if (ui->rBtnNode->isChecked()) {
+    if (ui->rBtnNode->isChecked())
         search_tree_->Query(kText);
-        ResizeTreeColumn(ui->searchViewNode->horizontalHeader());
-    }
 
-    if (ui->rBtnTrans->isChecked()) {
+    if (ui->rBtnTrans->isChecked())
         search_table_->Query(kText);
-        ResizeTableColumn(ui->searchViewTrans->horizontalHeader());
-    }
+
+    if (ui->rBtnAll->isChecked())
+        search_all_->Query(kText);
+}
+
+void Search::RNodeQueryFinished()
+{
+    // rows arrive in index or chunk order, restore the header's order once the query is in
+    auto* header { ui->searchViewNode->horizontalHeader() };
+    ui->searchViewNode->sortByColumn(header->sortIndicatorSection(), header->sortIndicatorOrder());
+    ResizeTreeColumn(header);
+}
+
+void Search::RTransQueryFinished()
+{
+    auto* header { ui->searchViewTrans->horizontalHeader() };
+    ui->searchViewTrans->sortByColumn(header->sortIndicatorSection(), header->sortIndicatorOrder());
+    ResizeTableColumn(header);
+}
+
+void Search::RAllQueryFinished()
+{
+    auto* header { ui->searchViewAll->horizontalHeader() };
+    header->setSectionResizeMode(QHeaderView::ResizeToContents);
+    header->setSectionResizeMode(std::to_underlying(TableEnumSearchAll::kName), QHeaderView::Stretch);
 }
 
 void Search::RDoubleClicked(const QModelIndex& index)
 {
     if (ui->rBtnNode->isChecked()) {
         int node_id { index.siblingAtColumn(std::to_underlying(TreeEnum::kID)).data().toInt() };
-        emit SNodeLocation(node_id);
+        emit SNodeLocation(info_.section, node_id);
     }
 
     if (ui->rBtnTrans->isChecked()) {
@@ -284,17 +324,29 @@ void Search::RDoubleClicked(const QModelIndex& index)
 
         switch (info_.section) {
         case Section::kStakeholder:
-            emit STransLocation(trans_id, node_id, 0);
+            emit STransLocation(info_.section, trans_id, node_id, 0);
             break;
         case Section::kFinance:
         case Section::kProduct:
         case Section::kTask:
-            emit STransLocation(trans_id, lhs_node_id, rhs_node_id);
+            emit STransLocation(info_.section, trans_id, lhs_node_id, rhs_node_id);
             break;
         default:
             break;
         }
     }
+
+    if (ui->rBtnAll->isChecked()) {
+        const auto& hit { search_all_->Hit(index.row()) };
+
+        // an order line opens its order, a stakeholder trans the stakeholder it belongs to
+        if (hit.node || hit.section == Section::kSales || hit.section == Section::kPurchase)
+            emit SNodeLocation(hit.section, hit.node ? hit.id : hit.lhs_node);
+        else if (hit.section == Section::kStakeholder)
+            emit STransLocation(hit.section, hit.id, hit.lhs_node, 0);
+        else
+            emit STransLocation(hit.section, hit.id, hit.lhs_node, hit.rhs_node);
+    }
 }
 
 void Search::on_rBtnNode_toggled(bool checked)
@@ -308,3 +360,9 @@ void Search::on_rBtnTrans_toggled(bool checked)
     if (checked)
         ui->stackedWidget->setCurrentIndex(1);
 }
+
+void Search::on_rBtnAll_toggled(bool checked)
+{
+    if (checked)
+        ui->stackedWidget->setCurrentIndex(2);
+}
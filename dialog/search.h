@@ -22,8 +22,10 @@
 
 #include <QDialog>
 #include <QTableView>
+#include <QTimer>
 
 #include "component/settings.h"
+#include "table/searchallmodel.h"
 #include "table/searchnodemodel.h"
 #include "table/searchtransmodel.h"
 
@@ -35,21 +37,27 @@ class Search final : public QDialog {
     Q_OBJECT
 
 public:
-    Search(CTreeModel* tree, CTreeModel* stakeholder_tree, CTreeModel* product_tree, CSettings* settings, Sqlite* sql, CInfo& info, QWidget* parent = nullptr);
+    Search(CTreeModel* tree, CTreeModel* stakeholder_tree, CTreeModel* product_tree, CSettings* settings, Sqlite* sql, CInfo& info,
+        const QList<SearchSection>& section_list, QWidget* parent = nullptr);
     ~Search();
 
 signals:
-    void SNodeLocation(int node_id);
-    void STransLocation(int trans_id, int lhs_node_id, int rhs_node_id);
+    // section is info.section except for hits of the all sections mode
+    void SNodeLocation(Section section, int node_id);
+    void STransLocation(Section section, int trans_id, int lhs_node_id, int rhs_node_id);
 
 public slots:
     void RSearch();
 
 private slots:
     void RDoubleClicked(const QModelIndex& index);
+    void RNodeQueryFinished();
+    void RTransQueryFinished();
+    void RAllQueryFinished();
 
     void on_rBtnNode_toggled(bool checked);
     void on_rBtnTrans_toggled(bool checked);
+    void on_rBtnAll_toggled(bool checked);
 
 private:
     void IniDialog();
@@ -71,6 +79,9 @@ private:
 
     SearchNodeModel* search_tree_ {};
     SearchTransModel* search_table_ {};
+    SearchAllModel* search_all_ {};
+    // search as you type waits kSearchDelay after the last keystroke, return searches at once
+    QTimer* search_timer_ {};
     Sqlite* sql_ {};
     CTreeModel* tree_ {};
     CTreeModel* stakeholder_tree_ {};
@@ -0,0 +1,62 @@
+#include "stock.h"
+
+#include <QHeaderView>
+
+#include "component/enumclass.h"
+#include "component/signalblocker.h"
+#include "delegate/readonly/doublespinr.h"
+#include "ui_stock.h"
+
+Stock::Stock(CTreeModel* product_tree, SqliteProduct* sql, CSettings* settings, QWidget* parent)
+    : QDialog(parent)
+    , ui(new Ui::Stock)
+    , settings_ { settings }
+{
+    ui->setupUi(this);
+    SignalBlocker blocker(this);
+
+    model_ = new StockModel(product_tree, sql, this);
+
+    IniDialog();
+    IniView(ui->tableView);
+    IniConnect();
+
+    RUpdateStock();
+}
+
+Stock::~Stock() { delete ui; }
+
+void Stock::RUpdateStock() { model_->Query(ui->dateEdit->date()); }
+
+void Stock::IniDialog()
+{
+    ui->dateEdit->setDisplayFormat(kDateFST);
+    ui->dateEdit->setDate(QDate::currentDate());
+
+    ui->pBtnClose->setAutoDefault(false);
+    this->setWindowTitle(tr("Stock"));
+}
+
+void Stock::IniConnect() { connect(ui->dateEdit, &QDateEdit::dateChanged, this, &Stock::RUpdateStock); }
+
+void Stock::IniView(QTableView* view)
+{
+    view->setModel(model_);
+    view->setSortingEnabled(true);
+    view->setSelectionMode(QAbstractItemView::SingleSelection);
+    view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    view->setAlternatingRowColors(true);
+    view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view->verticalHeader()->setHidden(true);
+
+    auto* quantity { new DoubleSpinR(settings_->common_decimal, true, view) };
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumStock::kQuantity), quantity);
+
+    auto* amount { new DoubleSpinR(settings_->amount_decimal, true, view) };
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumStock::kAverage), amount);
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumStock::kValue), amount);
+
+    auto* header { view->horizontalHeader() };
+    header->setSectionResizeMode(QHeaderView::ResizeToContents);
+    header->setSectionResizeMode(std::to_underlying(TableEnumStock::kName), QHeaderView::Stretch);
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef STOCK_H
+#define STOCK_H
+
+#include <QDialog>
+#include <QTableView>
+
+#include "component/settings.h"
+#include "table/stockmodel.h"
+
+namespace Ui {
+class Stock;
+}
+
+class Stock final : public QDialog {
+    Q_OBJECT
+
+public:
+    Stock(CTreeModel* product_tree, SqliteProduct* sql, CSettings* settings, QWidget* parent = nullptr);
+    ~Stock();
+
+public slots:
+    void RUpdateStock();
+
+private:
+    void IniDialog();
+    void IniConnect();
+    void IniView(QTableView* view);
+
+private:
+    Ui::Stock* ui;
+
+    StockModel* model_ {};
+    CSettings* settings_ {};
+};
+
+#endif // STOCK_H
@@ -0,0 +1,67 @@
+#include "trialbalance.h"
+
+#include <QHeaderView>
+
+#include "component/enumclass.h"
+#include "component/signalblocker.h"
+#include "delegate/readonly/doublespinr.h"
+#include "ui_trialbalance.h"
+
+TrialBalance::TrialBalance(const TreeModelFinance* tree, const SqliteFinance* sql, CSettings* settings, QWidget* parent)
+    : QDialog(parent)
+    , ui(new Ui::TrialBalance)
+    , settings_ { settings }
+{
+    ui->setupUi(this);
+    SignalBlocker blocker(this);
+
+    model_ = new TrialBalanceModel(tree, sql, this);
+
+    IniDialog();
+    IniView(ui->tableView);
+    IniConnect();
+
+    RUpdateTrialBalance();
+}
+
+TrialBalance::~TrialBalance() { delete ui; }
+
+void TrialBalance::RUpdateTrialBalance() { model_->Query(ui->dateEditStart->date(), ui->dateEditEnd->date()); }
+
+void TrialBalance::IniDialog()
+{
+    const QDate current_date { QDate::currentDate() };
+    ui->dateEditStart->setDisplayFormat(kDateFST);
+    ui->dateEditEnd->setDisplayFormat(kDateFST);
+    ui->dateEditStart->setDate(QDate(current_date.year(), current_date.month(), 1));
+    ui->dateEditEnd->setDate(current_date);
+
+    ui->pBtnClose->setAutoDefault(false);
+    this->setWindowTitle(tr("Trial Balance"));
+}
+
+void TrialBalance::IniConnect()
+{
+    connect(ui->dateEditStart, &QDateEdit::dateChanged, this, &TrialBalance::RUpdateTrialBalance);
+    connect(ui->dateEditEnd, &QDateEdit::dateChanged, this, &TrialBalance::RUpdateTrialBalance);
+}
+
+void TrialBalance::IniView(QTableView* view)
+{
+    view->setModel(model_);
+    view->setSelectionMode(QAbstractItemView::SingleSelection);
+    view->setSelectionBehavior(QAbstractItemView::SelectRows);
+    view->setAlternatingRowColors(true);
+    view->setEditTriggers(QAbstractItemView::NoEditTriggers);
+    view->verticalHeader()->setHidden(true);
+
+    auto* amount { new DoubleSpinR(settings_->amount_decimal, true, view) };
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumTrial::kOpening), amount);
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumTrial::kDebit), amount);
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumTrial::kCredit), amount);
+    view->setItemDelegateForColumn(std::to_underlying(TableEnumTrial::kClosing), amount);
+
+    auto* header { view->horizontalHeader() };
+    header->setSectionResizeMode(QHeaderView::ResizeToContents);
+    header->setSectionResizeMode(std::to_underlying(TableEnumTrial::kName), QHeaderView::Stretch);
+}
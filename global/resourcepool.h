@@ -21,6 +21,7 @@
 #define RESOURCEPOOL_H
 
 #include <QMutex>
+#include <algorithm>
 #include <deque>
 
 template <typename T>
@@ -34,6 +35,13 @@ concept Iterable = requires(Container c) {
     { c.end() } -> std::same_as<typename Container::iterator>;
 };
 
+// Objects handed out and kept in the free list, high_water is the most ever handed out at once
+struct PoolStat {
+    qsizetype in_use {};
+    qsizetype free {};
+    qsizetype high_water {};
+};
+
 template <Resettable T> class ResourcePool {
 public:
     static ResourcePool& Instance();
@@ -41,6 +49,10 @@ public:
     void Recycle(T* resource);
     template <Iterable Container> void Recycle(Container& resource_list);
 
+    PoolStat Stat();
+    // frees the whole free list, Allocate grows it again on demand
+    void Trim();
+
 private:
     ResourcePool();
     ~ResourcePool();
@@ -56,6 +68,9 @@ private:
     std::deque<T*> pool_;
     QMutex mutex_;
 
+    qsizetype in_use_ {};
+    qsizetype high_water_ {};
+
     static constexpr qsizetype kSize { 100 };
     static constexpr qsizetype kExpandThreshold { 20 };
     static constexpr qsizetype kShrinkThreshold { 1001 };
@@ -74,6 +89,8 @@ template <Resettable T> T* ResourcePool<T>::Allocate()
     if (pool_.size() <= kExpandThreshold)
         ExpandCapacity(kSize);
 
+    high_water_ = std::max(high_water_, ++in_use_);
+
     if (pool_.empty()) {
         return new T();
     }
@@ -88,12 +105,14 @@ template <Resettable T> void ResourcePool<T>::Recycle(T* resource)
     if (!resource)
         return;
 
+    QMutexLocker locker(&mutex_);
+    --in_use_;
+
     if (pool_.size() >= kShrinkThreshold) {
         delete resource;
         return;
     }
 
-    QMutexLocker locker(&mutex_);
     resource->Reset();
     pool_.push_back(resource);
 }
@@ -103,11 +122,12 @@ template <Resettable T> template <Iterable Container> void ResourcePool<T>::Recy
     if (container.isEmpty())
         return;
 
+    QMutexLocker locker(&mutex_);
+    in_use_ -= std::count_if(container.begin(), container.end(), [](T* resource) { return resource != nullptr; });
+
     if (pool_.size() + container.size() >= kShrinkThreshold) {
         qDeleteAll(container);
     } else {
-        QMutexLocker locker(&mutex_);
-
         for (T* resource : container) {
             if (resource) {
                 resource->Reset();
@@ -119,6 +139,19 @@ template <Resettable T> template <Iterable Container> void ResourcePool<T>::Recy
     container.clear();
 }
 
+template <Resettable T> PoolStat ResourcePool<T>::Stat()
+{
+    QMutexLocker locker(&mutex_);
+    return PoolStat { in_use_, qsizetype(pool_.size()), high_water_ };
+}
+
+template <Resettable T> void ResourcePool<T>::Trim()
+{
+    QMutexLocker locker(&mutex_);
+    qDeleteAll(pool_);
+    pool_.clear();
+}
+
 template <Resettable T> ResourcePool<T>::ResourcePool() { ExpandCapacity(kSize); }
 
 template <Resettable T> void ResourcePool<T>::ExpandCapacity(int size)
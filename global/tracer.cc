@@ -0,0 +1,83 @@
+#include "tracer.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+#include <QThread>
+
+Tracer& Tracer::Instance()
+{
+    static Tracer instance {};
+    return instance;
+}
+
+void Tracer::Start()
+{
+    QMutexLocker locker(&mutex_);
+
+    event_list_.clear();
+    timer_.start();
+    enabled_.store(true, std::memory_order_relaxed);
+}
+
+void Tracer::Stop() { enabled_.store(false, std::memory_order_relaxed); }
+
+void Tracer::StartFromEnvironment()
+{
+    if (!qEnvironmentVariableIsSet(kTraceEnvironment))
+        return;
+
+    environment_path_ = qEnvironmentVariable(kTraceEnvironment);
+    if (environment_path_.isEmpty())
+        return;
+
+    Start();
+}
+
+void Tracer::Finish()
+{
+    if (environment_path_.isEmpty())
+        return;
+
+    Stop();
+    Save(environment_path_);
+}
+
+void Tracer::Append(const char* name, int section, qint64 begin, qint64 end)
+{
+    const auto thread { reinterpret_cast<quintptr>(QThread::currentThreadId()) };
+
+    QMutexLocker locker(&mutex_);
+    event_list_.emplaceBack(TraceEvent { name, section, thread, begin, end });
+}
+
+bool Tracer::Save(const QString& file_path)
+{
+    QFile file { file_path };
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+        qWarning() << "Failed in Tracer::Save" << file.errorString();
+        return false;
+    }
+
+    QMutexLocker locker(&mutex_);
+    QTextStream stream { &file };
+
+    // ts and dur are microseconds, names are literals so they need no escaping
+    stream << "{\"traceEvents\":[";
+
+    for (qsizetype index = 0; index != event_list_.size(); ++index) {
+        const auto& event { event_list_.at(index) };
+
+        stream << (index == 0 ? "\n" : ",\n") << "{\"name\":\"" << event.name << "\",\"cat\":\"ytx\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+               << ",\"ts\":" << QString::number(event.begin / 1000.0, 'f', 3) << ",\"dur\":" << QString::number((event.end - event.begin) / 1000.0, 'f', 3);
+
+        if (event.section >= 0)
+            stream << ",\"args\":{\"section\":" << event.section << "}";
+
+        stream << "}";
+    }
+
+    stream << "\n],\"displayTimeUnit\":\"ms\"}\n";
+    return stream.status() == QTextStream::Ok;
+}
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRACER_H
+#define TRACER_H
+
+#include <QElapsedTimer>
+#include <QList>
+#include <QMutex>
+#include <QString>
+#include <atomic>
+
+// Environment variable naming the trace file, set it to record from launch until the main window closes
+inline constexpr char kTraceEnvironment[] = "YTX_TRACE";
+
+// Collects complete ("ph":"X") events and writes them as Chrome trace-event JSON, open the file in chrome://tracing or Perfetto
+class Tracer {
+public:
+    static Tracer& Instance();
+    // one relaxed load, the only cost a span pays while tracing is off
+    static bool Enabled() noexcept { return enabled_.load(std::memory_order_relaxed); }
+
+    void Start();
+    void Stop();
+    bool Save(const QString& file_path);
+
+    // starts when kTraceEnvironment is set, Finish writes to the path it names
+    void StartFromEnvironment();
+    void Finish();
+
+    qint64 Now() const { return timer_.nsecsElapsed(); }
+    void Append(const char* name, int section, qint64 begin, qint64 end);
+
+private:
+    Tracer() = default;
+    ~Tracer() = default;
+
+    Tracer(const Tracer&) = delete;
+    Tracer& operator=(const Tracer&) = delete;
+    Tracer(Tracer&&) = delete;
+    Tracer& operator=(Tracer&&) = delete;
+
+private:
+    // name points at a string literal, begin and end are nanoseconds since Start
+    struct TraceEvent {
+        const char* name {};
+        int section {};
+        quintptr thread {};
+        qint64 begin {};
+        qint64 end {};
+    };
+
+    static inline std::atomic_bool enabled_ { false };
+
+    QMutex mutex_;
+    QElapsedTimer timer_ {};
+    QList<TraceEvent> event_list_ {};
+    QString environment_path_ {};
+};
+
+// Scoped span, name must be a string literal, section is recorded as an argument when not negative
+class TraceSpan {
+public:
+    explicit TraceSpan(const char* name, int section = -1) noexcept
+        : name_ { Tracer::Enabled() ? name : nullptr }
+        , section_ { section }
+    {
+        if (name_)
+            begin_ = Tracer::Instance().Now();
+    }
+
+    ~TraceSpan()
+    {
+        if (name_)
+            Tracer::Instance().Append(name_, section_, begin_, Tracer::Instance().Now());
+    }
+
+    TraceSpan(const TraceSpan&) = delete;
+    TraceSpan& operator=(const TraceSpan&) = delete;
+    TraceSpan(TraceSpan&&) = delete;
+    TraceSpan& operator=(TraceSpan&&) = delete;
+
+private:
+    const char* name_ {};
+    int section_ {};
+    qint64 begin_ {};
+};
+
+#endif // TRACER_H
@@ -17,9 +17,11 @@
  * along with YTX. If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <QCoreApplication>
 #include <QDir>
 #include <QStandardPaths>
 
+#include "batch.h"
 #include "mainwindow.h"
 
 #ifdef Q_OS_MACOS
@@ -27,6 +29,12 @@
 
 int main(int argc, char* argv[])
 {
+    // Headless runs never build widgets, so they get a core application instead
+    if (Batch::Requested(argc, argv)) {
+        QCoreApplication application(argc, argv);
+        return Batch(application.arguments()).Run();
+    }
+
     Application application(argc, argv);
     QCoreApplication::setAttribute(Qt::AA_DontUseNativeDialogs);
 
@@ -60,6 +68,11 @@ int main(int argc, char* argv[])
 
 int main(int argc, char* argv[])
 {
+    if (Batch::Requested(argc, argv)) {
+        QCoreApplication application(argc, argv);
+        return Batch(application.arguments()).Run();
+    }
+
     QApplication application(argc, argv);
     QCoreApplication::setAttribute(Qt::AA_DontUseNativeDialogs);
 
@@ -9,9 +9,11 @@
 #include <QQueue>
 #include <QResource>
 #include <QScrollBar>
+#include <QTimer>
 #include <QtConcurrent>
 
 #include "component/classparams.h"
+#include "component/columnwidth.h"
 #include "component/constvalue.h"
 #include "component/enumclass.h"
 #include "component/signalblocker.h"
@@ -42,19 +44,28 @@
 #include "delegate/tree/treedatetime.h"
 #include "delegate/tree/treeplaintext.h"
 #include "dialog/about.h"
+#include "dialog/aging.h"
+#include "dialog/balance.h"
 #include "dialog/editdocument.h"
 #include "dialog/editnode/editnodefinance.h"
 #include "dialog/editnode/editnodeorder.h"
 #include "dialog/editnode/editnodeproduct.h"
 #include "dialog/editnode/editnodestakeholder.h"
 #include "dialog/editnode/editnodetask.h"
+#include "dialog/integrity.h"
+#include "dialog/memory.h"
 #include "dialog/preferences.h"
 #include "dialog/removenode.h"
+#include "dialog/report.h"
+#include "dialog/revalue.h"
 #include "dialog/search.h"
+#include "dialog/stock.h"
+#include "dialog/trialbalance.h"
 #include "document.h"
 #include "global/resourcepool.h"
 #include "global/signalstation.h"
 #include "global/sqlconnection.h"
+#include "global/tracer.h"
 #include "mainwindowutils.h"
 #include "table/model/sortfilterproxymodel.h"
 #include "table/model/tablemodelfinance.h"
@@ -83,7 +94,21 @@ MainWindow::MainWindow(QWidget* parent)
     ui->setupUi(this);
     SignalBlocker blocker(this);
 
+    Tracer::Instance().StartFromEnvironment();
+    ui->actionTrace->setChecked(Tracer::Enabled());
+
     SetTabWidget();
+
+    prefetch_timer_ = new QTimer(this);
+    prefetch_timer_->setSingleShot(true);
+    prefetch_timer_->setInterval(kPrefetchDelay);
+
+    memory_timer_ = new QTimer(this);
+    memory_timer_->setInterval(kMemoryLogInterval);
+
+    restore_timer_ = new QTimer(this);
+    restore_timer_->setInterval(kRestoreInterval);
+
     SetConnect();
     StringInitializer::SetHeader(finance_data_.info, product_data_.info, stakeholder_data_.info, task_data_.info, sales_data_.info, purchase_data_.info);
     SetAction();
@@ -108,22 +133,26 @@ MainWindow::MainWindow(QWidget* parent)
 
 MainWindow::~MainWindow()
 {
+    // Prefetch workers call back into Sqlite, let them finish before it is destroyed
+    QThreadPool::globalInstance()->waitForDone();
+    Tracer::Instance().Finish();
+
     MainWindowUtils::WriteSettings(ui->splitter, &QSplitter::saveState, app_settings_, kWindow, kSplitterState);
     MainWindowUtils::WriteSettings(this, &QMainWindow::saveState, app_settings_, kWindow, kMainwindowState, 0);
     MainWindowUtils::WriteSettings(this, &QMainWindow::saveGeometry, app_settings_, kWindow, kMainwindowGeometry);
     MainWindowUtils::WriteSettings(app_settings_, std::to_underlying(start_), kStart, kSection);
 
     if (lock_file_) {
-        MainWindowUtils::WriteSettings(file_settings_, MainWindowUtils::SaveTab(finance_table_hash_), kFinance, kTabID);
+        MainWindowUtils::WriteSettings(file_settings_, MainWindowUtils::SaveTab(finance_table_hash_, PendingTab(Section::kFinance)), kFinance, kTabID);
         MainWindowUtils::WriteSettings(finance_tree_->View()->header(), &QHeaderView::saveState, file_settings_, kFinance, kHeaderState);
 
-        MainWindowUtils::WriteSettings(file_settings_, MainWindowUtils::SaveTab(product_table_hash_), kProduct, kTabID);
+        MainWindowUtils::WriteSettings(file_settings_, MainWindowUtils::SaveTab(product_table_hash_, PendingTab(Section::kProduct)), kProduct, kTabID);
         MainWindowUtils::WriteSettings(product_tree_->View()->header(), &QHeaderView::saveState, file_settings_, kProduct, kHeaderState);
 
-        MainWindowUtils::WriteSettings(file_settings_, MainWindowUtils::SaveTab(stakeholder_table_hash_), kStakeholder, kTabID);
+        MainWindowUtils::WriteSettings(file_settings_, MainWindowUtils::SaveTab(stakeholder_table_hash_, PendingTab(Section::kStakeholder)), kStakeholder, kTabID);
         MainWindowUtils::WriteSettings(stakeholder_tree_->View()->header(), &QHeaderView::saveState, file_settings_, kStakeholder, kHeaderState);
 
-        MainWindowUtils::WriteSettings(file_settings_, MainWindowUtils::SaveTab(task_table_hash_), kTask, kTabID);
+        MainWindowUtils::WriteSettings(file_settings_, MainWindowUtils::SaveTab(task_table_hash_, PendingTab(Section::kTask)), kTask, kTabID);
         MainWindowUtils::WriteSettings(task_tree_->View()->header(), &QHeaderView::saveState, file_settings_, kTask, kHeaderState);
 
         MainWindowUtils::WriteSettings(sales_tree_->View()->header(), &QHeaderView::saveState, file_settings_, kSales, kHeaderState);
@@ -135,6 +164,8 @@ MainWindow::~MainWindow()
 
 bool MainWindow::ROpenFile(CString& file_path)
 {
+    const TraceSpan span { "ROpenFile" };
+
     if (file_path.isEmpty())
         return false;
 
@@ -163,6 +194,8 @@ bool MainWindow::ROpenFile(CString& file_path)
         QStandardPaths::writableLocation(QStandardPaths::AppConfigLocation) + kSlash + complete_base_name + kSuffixINI, QSettings::IniFormat);
 
     sql_ = MainwindowSqlite(start_);
+    sql_.CreateIndex();
+    sql_.MigrateDocument();
     SetFinanceData();
     SetTaskData();
     SetProductData();
@@ -170,12 +203,12 @@ bool MainWindow::ROpenFile(CString& file_path)
     SetSalesData();
     SetPurchaseData();
 
-    CreateSection(finance_tree_, finance_table_hash_, finance_data_, finance_settings_, tr("Finance"));
-    CreateSection(stakeholder_tree_, stakeholder_table_hash_, stakeholder_data_, stakeholder_settings_, tr("Stakeholder"));
-    CreateSection(product_tree_, product_table_hash_, product_data_, product_settings_, tr("Product"));
-    CreateSection(task_tree_, task_table_hash_, task_data_, task_settings_, tr("Task"));
-    CreateSection(sales_tree_, sales_table_hash_, sales_data_, sales_settings_, tr("Sales"));
-    CreateSection(purchase_tree_, purchase_table_hash_, purchase_data_, purchase_settings_, tr("Purchase"));
+    CreateSection(finance_tree_, finance_data_, finance_settings_, tr("Finance"));
+    CreateSection(stakeholder_tree_, stakeholder_data_, stakeholder_settings_, tr("Stakeholder"));
+    CreateSection(product_tree_, product_data_, product_settings_, tr("Product"));
+    CreateSection(task_tree_, task_data_, task_settings_, tr("Task"));
+    CreateSection(sales_tree_, sales_data_, sales_settings_, tr("Sales"));
+    CreateSection(purchase_tree_, purchase_data_, purchase_settings_, tr("Purchase"));
 
     switch (start_) {
     case Section::kFinance:
@@ -203,6 +236,11 @@ bool MainWindow::ROpenFile(CString& file_path)
     AddRecentFile(file_path);
     EnableAction(true);
     on_tabWidget_currentChanged(0);
+    memory_timer_->start();
+
+    if (!pending_tab_.isEmpty())
+        restore_timer_->start();
+
     return true;
 }
 
@@ -275,6 +313,34 @@ void MainWindow::RTreeViewDoubleClicked(const QModelIndex& index)
     SwitchTab(node_id);
 }
 
+void MainWindow::RPrefetchTrans()
+{
+    if (!tree_widget_ || !data_)
+        return;
+
+    switch (start_) {
+    case Section::kFinance:
+    case Section::kProduct:
+    case Section::kTask:
+        break;
+    default:
+        return;
+    }
+
+    // The leaf has stayed selected for kPrefetchDelay, read its ledger ahead so a double click finds it ready
+    const auto index { tree_widget_->View()->currentIndex() };
+    if (!index.isValid())
+        return;
+
+    const int type { index.siblingAtColumn(std::to_underlying(TreeEnum::kType)).data().toInt() };
+    const int node_id { index.siblingAtColumn(std::to_underlying(TreeEnum::kID)).data().toInt() };
+
+    if (type != kTypeLeaf || node_id <= 0 || table_hash_->contains(node_id))
+        return;
+
+    data_->sql->PrefetchNodeTrans(node_id);
+}
+
 void MainWindow::SwitchTab(int node_id, int trans_id) const
 {
     auto* widget { table_hash_->value(node_id, nullptr) };
@@ -309,16 +375,17 @@ void MainWindow::CreateTableFPTS(PTreeModel tree_model, TableHash* table_hash, C
     const bool rule { tree_model->Rule(node_id) };
 
     TableModel* model {};
+    const DateWindow window { TableWidgetFPTS::CurrentQuarterFPT() };
 
     switch (section) {
     case Section::kFinance:
-        model = new TableModelFinance(sql, rule, node_id, info, this);
+        model = new TableModelFinance(sql, rule, node_id, info, window, this);
         break;
     case Section::kProduct:
-        model = new TableModelProduct(sql, rule, node_id, info, this);
+        model = new TableModelProduct(sql, rule, node_id, info, window, this);
         break;
     case Section::kTask:
-        model = new TableModelTask(sql, rule, node_id, info, this);
+        model = new TableModelTask(sql, rule, node_id, info, window, this);
         break;
     case Section::kStakeholder:
         model = new TableModelStakeholder(sql, rule, node_id, info, this);
@@ -328,12 +395,7 @@ void MainWindow::CreateTableFPTS(PTreeModel tree_model, TableHash* table_hash, C
     }
 
     TableWidgetFPTS* widget { new TableWidgetFPTS(model, this) };
-
-    const int tab_index { ui->tabWidget->addTab(widget, name) };
-    auto* tab_bar { ui->tabWidget->tabBar() };
-
-    tab_bar->setTabData(tab_index, QVariant::fromValue(Tab { section, node_id }));
-    tab_bar->setTabToolTip(tab_index, tree_model->GetPath(node_id));
+    AddTab(widget, name, tree_model->GetPath(node_id), Tab { section, node_id });
 
     auto view { widget->View() };
     SetView(view);
@@ -343,11 +405,12 @@ void MainWindow::CreateTableFPTS(PTreeModel tree_model, TableHash* table_hash, C
     case Section::kFinance:
     case Section::kProduct:
     case Section::kTask:
-        TableConnectFPT(view, model, tree_model, data);
+        TableConnectFPT(model, tree_model, data);
         DelegateFPT(view, tree_model, settings, node_id);
+        widget->ShowDateWindowFPT();
         break;
     case Section::kStakeholder:
-        TableConnectStakeholder(view, model, tree_model, data);
+        TableConnectStakeholder(model, tree_model, data);
         DelegateStakeholder(view);
         break;
     default:
@@ -371,12 +434,7 @@ void MainWindow::CreateTableSupport(PTreeModel tree_model, TableHash* table_hash
 
     auto* model { new TableModelSupport(sql, rule, node_id, info, this) };
     TableWidgetFPTS* widget { new TableWidgetFPTS(model, this) };
-
-    const int tab_index { ui->tabWidget->addTab(widget, name) };
-    auto* tab_bar { ui->tabWidget->tabBar() };
-
-    tab_bar->setTabData(tab_index, QVariant::fromValue(Tab { section, node_id }));
-    tab_bar->setTabToolTip(tab_index, tree_model->GetPath(node_id));
+    AddTab(widget, name, tree_model->GetPath(node_id), Tab { section, node_id });
 
     auto view { widget->View() };
     SetSupportView(view);
@@ -406,24 +464,19 @@ void MainWindow::CreateTableOrder(PTreeModel tree_model, TableHash* table_hash,
 
     TableWidgetOrder* widget { new TableWidgetOrder(std::move(params), this) };
 
-    const int tab_index { ui->tabWidget->addTab(widget, stakeholder_tree_->Model()->Name(party_id)) };
-    auto* tab_bar { ui->tabWidget->tabBar() };
-
-    tab_bar->setTabData(tab_index, QVariant::fromValue(Tab { section, node_id }));
-    tab_bar->setTabToolTip(tab_index, stakeholder_tree_->Model()->GetPath(party_id));
+    AddTab(widget, stakeholder_tree_->Model()->Name(party_id), stakeholder_tree_->Model()->GetPath(party_id), Tab { section, node_id });
 
     auto view { widget->View() };
     SetView(view);
 
-    TableConnectOrder(view, model, tree_model, widget);
+    TableConnectOrder(model, tree_model, widget);
     DelegateOrder(view, settings);
 
     table_hash->insert(node_id, widget);
 }
 
-void MainWindow::TableConnectFPT(PQTableView table_view, PTableModel table_model, PTreeModel tree_model, const Data* data) const
+void MainWindow::TableConnectFPT(PTableModel table_model, PTreeModel tree_model, const Data* data) const
 {
-    connect(table_model, &TableModel::SResizeColumnToContents, table_view, &QTableView::resizeColumnToContents);
     connect(table_model, &TableModel::SSearch, tree_model, &TreeModel::RSearch);
 
     connect(table_model, &TableModel::SUpdateLeafValue, tree_model, &TreeModel::RUpdateLeafValue);
@@ -439,10 +492,9 @@ void MainWindow::TableConnectFPT(PQTableView table_view, PTableModel table_model
     connect(data->sql, &Sqlite::SMoveMultiTrans, table_model, &TableModel::RMoveMultiTrans);
 }
 
-void MainWindow::TableConnectOrder(PQTableView table_view, TableModelOrder* table_model, PTreeModel tree_model, TableWidgetOrder* widget) const
+void MainWindow::TableConnectOrder(TableModelOrder* table_model, PTreeModel tree_model, TableWidgetOrder* widget) const
 {
     connect(table_model, &TableModel::SSearch, tree_model, &TreeModel::RSearch);
-    connect(table_model, &TableModel::SResizeColumnToContents, table_view, &QTableView::resizeColumnToContents);
 
     connect(table_model, &TableModel::SUpdateLeafValue, tree_model, &TreeModel::RUpdateLeafValue);
     connect(table_model, &TableModel::SUpdateLeafValueOne, tree_model, &TreeModel::RUpdateLeafValueOne);
@@ -460,9 +512,8 @@ void MainWindow::TableConnectOrder(PQTableView table_view, TableModelOrder* tabl
     connect(widget, &TableWidgetOrder::SUpdateParty, table_model, &TableModelOrder::RUpdateParty);
 }
 
-void MainWindow::TableConnectStakeholder(PQTableView table_view, PTableModel table_model, PTreeModel tree_model, const Data* data) const
+void MainWindow::TableConnectStakeholder(PTableModel table_model, PTreeModel tree_model, const Data* data) const
 {
-    connect(table_model, &TableModel::SResizeColumnToContents, table_view, &QTableView::resizeColumnToContents);
     connect(table_model, &TableModel::SSearch, tree_model, &TreeModel::RSearch);
 
     connect(data->sql, &Sqlite::SMoveMultiTrans, table_model, &TableModel::RMoveMultiTrans);
@@ -549,8 +600,10 @@ void MainWindow::DelegateOrder(PQTableView table_view, CSettings* settings) cons
     table_view->setItemDelegateForColumn(std::to_underlying(TableEnumOrder::kSettled), amount);
 }
 
-void MainWindow::CreateSection(TreeWidget* tree_widget, TableHash& table_hash, CData& data, CSettings& settings, CString& name)
+void MainWindow::CreateSection(TreeWidget* tree_widget, CData& data, CSettings& settings, CString& name)
 {
+    const TraceSpan span { "CreateSection", std::to_underlying(data.info.section) };
+
     const auto& info { data.info };
     auto* tab_widget { ui->tabWidget };
 
@@ -569,7 +622,7 @@ void MainWindow::CreateSection(TreeWidget* tree_widget, TableHash& table_hash, C
     case Section::kTask:
     case Section::kProduct:
     case Section::kStakeholder:
-        RestoreTab(model, table_hash, MainWindowUtils::ReadSettings(file_settings_, info.node, kTabID), data, settings);
+        RestoreTab(model, MainWindowUtils::ReadSettings(file_settings_, info.node, kTabID), info);
         break;
     default:
         break;
@@ -726,13 +779,12 @@ void MainWindow::TreeConnect(TreeWidget* tree_widget, const Sqlite* sql) const
 
     connect(view, &QTreeView::doubleClicked, this, &MainWindow::RTreeViewDoubleClicked);
     connect(view, &QTreeView::customContextMenuRequested, this, &MainWindow::RTreeViewCustomContextMenuRequested);
+    connect(view->selectionModel(), &QItemSelectionModel::currentChanged, prefetch_timer_, qOverload<>(&QTimer::start));
 
     connect(model, &TreeModel::SUpdateName, this, &MainWindow::RUpdateName);
 
     connect(model, &TreeModel::SUpdateDSpinBox, tree_widget, &TreeWidget::RUpdateDSpinBox);
 
-    connect(model, &TreeModel::SResizeColumnToContents, view, &QTreeView::resizeColumnToContents);
-
     connect(model, &TreeModel::SRule, &SignalStation::Instance(), &SignalStation::RRule);
 
     connect(sql, &Sqlite::SRemoveNode, model, &TreeModel::RRemoveNode);
@@ -869,25 +921,167 @@ void MainWindow::RemoveNonBranch(PTreeModel tree_model, const QModelIndex& index
     }
 }
 
-void MainWindow::RestoreTab(PTreeModel tree_model, TableHash& table_hash, CIntSet& set, CData& data, CSettings& settings)
+void MainWindow::RestoreTab(PTreeModel tree_model, CIntSet& set, CInfo& info)
 {
     if (!tree_model || set.isEmpty())
         return;
 
+    auto* tab_widget { ui->tabWidget };
+    auto* tab_bar { tab_widget->tabBar() };
+    const Section section { info.section };
+
+    // Only a lightweight placeholder is added here, the table is built when the tab is activated or the event loop is idle
     for (int node_id : set) {
-        switch (tree_model->TypeFPTS(node_id)) {
-        case kTypeSupport:
-            CreateTableSupport(tree_model, &table_hash, &data, &settings, node_id);
-            break;
-        case kTypeLeaf:
-            CreateTableFPTS(tree_model, &table_hash, &data, &settings, node_id);
-            break;
-        default:
-            break;
-        }
+        if (!tree_model->Contains(node_id))
+            continue;
+
+        const int type { tree_model->TypeFPTS(node_id) };
+        if (type != kTypeLeaf && type != kTypeSupport)
+            continue;
+
+        const Tab tab { section, node_id };
+        const int tab_index { tab_widget->addTab(new QWidget(this), tree_model->Name(node_id)) };
+
+        tab_bar->setTabData(tab_index, QVariant::fromValue(tab));
+        tab_bar->setTabToolTip(tab_index, tree_model->GetPath(node_id));
+        pending_tab_.emplaceBack(tab);
     }
 }
 
+void MainWindow::RestorePendingTab(Tab tab)
+{
+    TreeWidget* tree_widget {};
+    TableHash* table_hash {};
+    Data* data {};
+    Settings* settings {};
+
+    switch (tab.section) {
+    case Section::kFinance:
+        tree_widget = finance_tree_;
+        table_hash = &finance_table_hash_;
+        data = &finance_data_;
+        settings = &finance_settings_;
+        break;
+    case Section::kProduct:
+        tree_widget = product_tree_;
+        table_hash = &product_table_hash_;
+        data = &product_data_;
+        settings = &product_settings_;
+        break;
+    case Section::kStakeholder:
+        tree_widget = stakeholder_tree_;
+        table_hash = &stakeholder_table_hash_;
+        data = &stakeholder_data_;
+        settings = &stakeholder_settings_;
+        break;
+    case Section::kTask:
+        tree_widget = task_tree_;
+        table_hash = &task_table_hash_;
+        data = &task_data_;
+        settings = &task_settings_;
+        break;
+    default:
+        RemovePendingTab(tab);
+        return;
+    }
+
+    auto tree_model { tree_widget->Model() };
+    const int node_id { tab.node_id };
+
+    // The node may be removed or changed to a branch after its placeholder was added
+    if (!tree_model->Contains(node_id) || table_hash->contains(node_id)) {
+        RemovePendingTab(tab);
+        return;
+    }
+
+    switch (tree_model->TypeFPTS(node_id)) {
+    case kTypeSupport:
+        CreateTableSupport(tree_model, table_hash, data, settings, node_id);
+        break;
+    case kTypeLeaf:
+        CreateTableFPTS(tree_model, table_hash, data, settings, node_id);
+        break;
+    default:
+        RemovePendingTab(tab);
+        break;
+    }
+}
+
+void MainWindow::RRestorePendingTab()
+{
+    // One tab per kRestoreInterval, so restoring never runs in a burst that blocks user input
+    if (!pending_tab_.isEmpty())
+        RestorePendingTab(pending_tab_.first());
+
+    if (pending_tab_.isEmpty())
+        restore_timer_->stop();
+}
+
+void MainWindow::RemovePendingTab(CTab& tab)
+{
+    pending_tab_.removeOne(tab);
+
+    const int index { PendingTabIndex(tab) };
+    if (index == -1)
+        return;
+
+    auto* placeholder { ui->tabWidget->widget(index) };
+    ui->tabWidget->removeTab(index);
+    placeholder->deleteLater();
+}
+
+int MainWindow::PendingTabIndex(CTab& tab) const
+{
+    auto* tab_widget { ui->tabWidget };
+    auto* tab_bar { tab_widget->tabBar() };
+    const int count { tab_widget->count() };
+
+    for (int index = 0; index != count; ++index) {
+        if (tab_bar->tabData(index).value<Tab>() == tab && !qobject_cast<TableWidget*>(tab_widget->widget(index)))
+            return index;
+    }
+
+    return -1;
+}
+
+QSet<int> MainWindow::PendingTab(Section section) const
+{
+    QSet<int> set {};
+
+    for (const auto& tab : pending_tab_) {
+        if (tab.section == section)
+            set.insert(tab.node_id);
+    }
+
+    return set;
+}
+
+int MainWindow::AddTab(QWidget* widget, CString& name, CString& tool_tip, CTab& tab)
+{
+    auto* tab_widget { ui->tabWidget };
+    auto* tab_bar { tab_widget->tabBar() };
+
+    const int placeholder_index { pending_tab_.removeOne(tab) ? PendingTabIndex(tab) : -1 };
+    auto* placeholder { placeholder_index == -1 ? nullptr : tab_widget->widget(placeholder_index) };
+
+    // Take over the placeholder's position, and its current state if it is the active tab
+    const int tab_index { placeholder ? tab_widget->insertTab(placeholder_index, widget, name) : tab_widget->addTab(widget, name) };
+
+    tab_bar->setTabData(tab_index, QVariant::fromValue(tab));
+    tab_bar->setTabToolTip(tab_index, tool_tip);
+    tab_widget->setTabVisible(tab_index, tab.section == start_);
+
+    if (placeholder) {
+        if (tab_widget->currentWidget() == placeholder)
+            tab_widget->setCurrentIndex(tab_index);
+
+        tab_widget->removeTab(tab_widget->indexOf(placeholder));
+        placeholder->deleteLater();
+    }
+
+    return tab_index;
+}
+
 void MainWindow::EnableAction(bool enable)
 {
     ui->actionAppendNode->setEnabled(enable);
@@ -899,6 +1093,14 @@ void MainWindow::EnableAction(bool enable)
     ui->actionJump->setEnabled(enable);
     ui->actionPreferences->setEnabled(enable);
     ui->actionSearch->setEnabled(enable);
+    ui->actionReport->setEnabled(enable);
+    ui->actionAging->setEnabled(enable);
+    ui->actionBalance->setEnabled(enable);
+    ui->actionTrialBalance->setEnabled(enable);
+    ui->actionRevalue->setEnabled(enable);
+    ui->actionStock->setEnabled(enable);
+    ui->actionIntegrity->setEnabled(enable);
+    ui->actionMemory->setEnabled(enable);
     ui->actionSupportJump->setEnabled(enable);
     ui->actionRemove->setEnabled(enable);
     ui->actionAppendTrans->setEnabled(enable);
@@ -1003,7 +1205,13 @@ void MainWindow::on_tabWidget_tabCloseRequested(int index)
     if (index == 0)
         return;
 
-    const int node_id { ui->tabWidget->tabBar()->tabData(index).value<Tab>().node_id };
+    const auto tab { ui->tabWidget->tabBar()->tabData(index).value<Tab>() };
+    if (pending_tab_.contains(tab)) {
+        RemovePendingTab(tab);
+        return;
+    }
+
+    const int node_id { tab.node_id };
     auto* widget { table_hash_->value(node_id) };
 
     MainWindowUtils::FreeWidget(widget);
@@ -1064,6 +1272,10 @@ void MainWindow::SetView(PQTableView view) const
     h_header->setSectionResizeMode(QHeaderView::ResizeToContents);
     h_header->setSectionResizeMode(std::to_underlying(TableEnum::kDescription), QHeaderView::Stretch);
 
+    assert(dynamic_cast<TableModel*>(view->model()) && "Model is not TableModel");
+    auto* column_width { new ColumnWidth(view, h_header) };
+    connect(static_cast<TableModel*>(view->model()), &TableModel::SResizeColumnToContents, column_width, &ColumnWidth::RResizeColumn);
+
     auto* v_header { view->verticalHeader() };
     v_header->setDefaultSectionSize(kRowHeight);
     v_header->setSectionResizeMode(QHeaderView::Fixed);
@@ -1087,6 +1299,10 @@ void MainWindow::SetSupportView(PQTableView view) const
     h_header->setSectionResizeMode(QHeaderView::ResizeToContents);
     h_header->setSectionResizeMode(std::to_underlying(TableEnumSupport::kDescription), QHeaderView::Stretch);
 
+    assert(dynamic_cast<TableModel*>(view->model()) && "Model is not TableModel");
+    auto* column_width { new ColumnWidth(view, h_header) };
+    connect(static_cast<TableModel*>(view->model()), &TableModel::SResizeColumnToContents, column_width, &ColumnWidth::RResizeColumn);
+
     auto* v_header { view->verticalHeader() };
     v_header->setDefaultSectionSize(kRowHeight);
     v_header->setSectionResizeMode(QHeaderView::Fixed);
@@ -1134,6 +1350,10 @@ void MainWindow::SetConnect() const
     connect(ui->actionCheckAll, &QAction::triggered, this, &MainWindow::RUpdateState);
     connect(ui->actionCheckNone, &QAction::triggered, this, &MainWindow::RUpdateState);
     connect(ui->actionCheckReverse, &QAction::triggered, this, &MainWindow::RUpdateState);
+
+    connect(prefetch_timer_, &QTimer::timeout, this, &MainWindow::RPrefetchTrans);
+    connect(memory_timer_, &QTimer::timeout, this, &MainWindow::RMemoryLog);
+    connect(restore_timer_, &QTimer::timeout, this, &MainWindow::RRestorePendingTab);
 }
 
 void MainWindow::SetFinanceData()
@@ -1334,6 +1554,7 @@ void MainWindow::SetSalesData()
     auto* model { new TreeModelOrder(sql, info, sales_settings_.default_unit, sales_table_hash_, interface_.separator, this) };
     sales_tree_ = new TreeWidgetOrder(model, info, sales_settings_, this);
 
+    connect(model, &TreeModelOrder::SUpdateStock, static_cast<SqliteProduct*>(product_data_.sql), &SqliteProduct::RUpdateStock);
     connect(stakeholder_data_.sql, &Sqlite::SUpdateStakeholder, model, &TreeModel::RUpdateStakeholder);
     connect(product_data_.sql, &Sqlite::SUpdateProduct, sql, &Sqlite::RUpdateProduct);
 }
@@ -1375,6 +1596,7 @@ void MainWindow::SetPurchaseData()
     auto* model { new TreeModelOrder(sql, info, purchase_settings_.default_unit, purchase_table_hash_, interface_.separator, this) };
     purchase_tree_ = new TreeWidgetOrder(model, info, purchase_settings_, this);
 
+    connect(model, &TreeModelOrder::SUpdateStock, static_cast<SqliteProduct*>(product_data_.sql), &SqliteProduct::RUpdateStock);
     connect(stakeholder_data_.sql, &Sqlite::SUpdateStakeholder, model, &TreeModel::RUpdateStakeholder);
     connect(product_data_.sql, &Sqlite::SUpdateProduct, sql, &Sqlite::RUpdateProduct);
 }
@@ -1418,6 +1640,10 @@ void MainWindow::SetView(PQTreeView tree_view) const
     header->setSectionResizeMode(std::to_underlying(TreeEnum::kDescription), QHeaderView::Stretch);
     header->setStretchLastSection(true);
     header->setDefaultAlignment(Qt::AlignCenter);
+
+    assert(dynamic_cast<TreeModel*>(tree_view->model()) && "Model is not TreeModel");
+    auto* column_width { new ColumnWidth(tree_view, header) };
+    connect(static_cast<TreeModel*>(tree_view->model()), &TreeModel::SResizeColumnToContents, column_width, &ColumnWidth::RResizeColumn);
 }
 
 void MainWindow::on_actionAppendNode_triggered()
@@ -1547,6 +1773,11 @@ void MainWindow::RTreeViewCustomContextMenuRequested(const QPoint& pos)
     menu->addAction(ui->actionAppendNode);
     menu->addAction(ui->actionRemove);
 
+    if (start_ == Section::kFinance || start_ == Section::kProduct || start_ == Section::kTask) {
+        menu->addSeparator();
+        menu->addAction(ui->actionBalance);
+    }
+
     menu->exec(QCursor::pos());
 }
 
@@ -1703,8 +1934,6 @@ void MainWindow::InsertNodeOrder(Node* node, const QModelIndex& parent, int row)
         }
     });
 
-    connect(table_model, &TableModel::SResizeColumnToContents, dialog->View(), &QTableView::resizeColumnToContents);
-
     connect(table_model, &TableModel::SUpdateLeafValue, tree_model, &TreeModel::RUpdateLeafValue);
     connect(table_model, &TableModel::SUpdateLeafValueOne, tree_model, &TreeModel::RUpdateLeafValueOne);
 
@@ -1743,11 +1972,18 @@ void MainWindow::REditTransDocument()
     const auto document_dir { QDir::homePath() + "/" + settings_->document_dir };
     const int trans_id { index.siblingAtColumn(std::to_underlying(TableEnum::kID)).data().toInt() };
 
-    auto* document_pointer { table_widget->Model()->GetDocumentPointer(index) };
-    auto* dialog { new EditDocument(document_pointer, document_dir, this) };
+    // documents hang off the saved row, a trans without id has nothing to attach them to yet
+    auto* document_count { table_widget->Model()->GetDocumentPointer(index) };
+    if (trans_id <= 0 || !document_count)
+        return;
+
+    auto document { data_->sql->ReadDocument(data_->info.transaction, trans_id) };
+    auto* dialog { new EditDocument(&document, document_dir, this) };
 
-    if (dialog->exec() == QDialog::Accepted)
-        data_->sql->UpdateField(data_->info.transaction, document_pointer->join(kSemicolon), kDocument, trans_id);
+    if (dialog->exec() == QDialog::Accepted && data_->sql->WriteDocument(data_->info.transaction, trans_id, document)) {
+        *document_count = document.size();
+        view->viewport()->update();
+    }
 }
 
 void MainWindow::REditNodeDocument()
@@ -1766,11 +2002,14 @@ void MainWindow::REditNodeDocument()
     const auto document_dir { QDir::homePath() + "/" + settings_->document_dir };
     const int id { index.siblingAtColumn(std::to_underlying(TreeEnum::kID)).data().toInt() };
 
-    auto* document_pointer { tree_widget_->Model()->GetDocumentPointer(index) };
-    auto* dialog { new EditDocument(document_pointer, document_dir, this) };
+    auto* document_count { tree_widget_->Model()->GetDocumentPointer(index) };
+    auto document { data_->sql->ReadDocument(data_->info.node, id) };
+    auto* dialog { new EditDocument(&document, document_dir, this) };
 
-    if (dialog->exec() == QDialog::Accepted)
-        data_->sql->UpdateField(data_->info.node, document_pointer->join(kSemicolon), kDocument, id);
+    if (dialog->exec() == QDialog::Accepted && data_->sql->WriteDocument(data_->info.node, id, document)) {
+        *document_count = document.size();
+        view->viewport()->update();
+    }
 }
 
 void MainWindow::RUpdateName(int node_id, CString& name, bool branch)
@@ -1788,7 +2027,8 @@ void MainWindow::RUpdateName(int node_id, CString& name, bool branch)
         if (start_ == Section::kStakeholder)
             UpdateStakeholderReference(nodes, branch);
 
-        if (!table_hash_->contains(node_id))
+        // A deferred tab is still a placeholder, its title is updated like a built one
+        if (!table_hash_->contains(node_id) && !pending_tab_.contains(Tab { start_, node_id }))
             return;
 
     } else {
@@ -1825,6 +2065,8 @@ void MainWindow::RUpdateSettings(CSettings& settings, CInterface& interface)
     }
 
     if (*settings_ != settings) {
+        StyledItemDelegate::ClearCache();
+
         bool update_default_unit { settings_->default_unit != settings.default_unit };
         resize_column |= settings_->amount_decimal != settings.amount_decimal || settings_->common_decimal != settings.common_decimal
             || settings_->date_format != settings.date_format;
@@ -1842,15 +2084,12 @@ void MainWindow::RUpdateSettings(CSettings& settings, CInterface& interface)
         auto* current_widget { ui->tabWidget->currentWidget() };
 
         if (auto* table_widget = dynamic_cast<TableWidget*>(current_widget)) {
-            auto* header { table_widget->View()->horizontalHeader() };
-            ResizeColumn(header, true);
+            ResizeColumn(table_widget->View());
             return;
         }
 
-        if (auto* tree_widget = dynamic_cast<TreeWidget*>(current_widget)) {
-            auto* header { tree_widget->View()->header() };
-            ResizeColumn(header, false);
-        }
+        if (auto* tree_widget = dynamic_cast<TreeWidget*>(current_widget))
+            ResizeColumn(tree_widget->View());
     }
 }
 void MainWindow::RFreeView(int node_id)
@@ -1883,6 +2122,8 @@ void MainWindow::UpdateInterface(CInterface& interface)
     auto old_separator { interface_.separator };
 
     if (old_separator != new_separator) {
+        StyledItemDelegate::ClearCache();
+
         finance_tree_->Model()->UpdateSeparatorFPTS(old_separator, new_separator);
         stakeholder_tree_->Model()->UpdateSeparatorFPTS(old_separator, new_separator);
         product_tree_->Model()->UpdateSeparatorFPTS(old_separator, new_separator);
@@ -2015,12 +2256,10 @@ void MainWindow::LoadAndInstallTranslator(CString& language)
         qApp->installTranslator(&qt_translator_);
 }
 
-void MainWindow::ResizeColumn(QHeaderView* header, bool table_view) const
+void MainWindow::ResizeColumn(QAbstractItemView* view) const
 {
-    header->setSectionResizeMode(QHeaderView::ResizeToContents);
-    table_view ? header->setSectionResizeMode(std::to_underlying(TableEnum::kDescription), QHeaderView::Stretch)
-               : header->setSectionResizeMode(std::to_underlying(TreeEnum::kDescription), QHeaderView::Stretch);
-    ;
+    if (auto* column_width { view->findChild<ColumnWidth*>() })
+        column_width->Rebuild();
 }
 
 void MainWindow::AppSettings()
@@ -2060,11 +2299,27 @@ void MainWindow::AppSettings()
 
 void MainWindow::on_actionSearch_triggered()
 {
-    auto* dialog { new Search(tree_widget_->Model(), stakeholder_tree_->Model(), product_tree_->Model(), settings_, data_->sql, data_->info, this) };
+    // Section order, SearchAllModel looks sections up by their value
+    const QList<SearchSection> section_list {
+        { Section::kFinance, tr("Finance"), finance_data_.sql, finance_tree_->Model() },
+        { Section::kProduct, tr("Product"), product_data_.sql, product_tree_->Model() },
+        { Section::kTask, tr("Task"), task_data_.sql, task_tree_->Model() },
+        { Section::kStakeholder, tr("Stakeholder"), stakeholder_data_.sql, stakeholder_tree_->Model() },
+        { Section::kSales, tr("Sales"), sales_data_.sql, sales_tree_->Model() },
+        { Section::kPurchase, tr("Purchase"), purchase_data_.sql, purchase_tree_->Model() },
+    };
+
+    auto* dialog { new Search(tree_widget_->Model(), stakeholder_tree_->Model(), product_tree_->Model(), settings_, data_->sql, data_->info, section_list, this) };
     dialog->setWindowFlags(Qt::Dialog | Qt::WindowStaysOnTopHint);
 
-    connect(dialog, &Search::SNodeLocation, this, &MainWindow::RNodeLocation);
-    connect(dialog, &Search::STransLocation, this, &MainWindow::RTransLocation);
+    connect(dialog, &Search::SNodeLocation, this, [=, this](Section section, int node_id) {
+        SwitchSectionWith(section, dialog);
+        RNodeLocation(node_id);
+    });
+    connect(dialog, &Search::STransLocation, this, [=, this](Section section, int trans_id, int lhs_node_id, int rhs_node_id) {
+        SwitchSectionWith(section, dialog);
+        RTransLocation(trans_id, lhs_node_id, rhs_node_id);
+    });
     connect(tree_widget_->Model(), &TreeModel::SSearch, dialog, &Search::RSearch);
     connect(dialog, &QDialog::rejected, this, [=, this]() { dialog_list_->removeOne(dialog); });
 
@@ -2072,6 +2327,178 @@ void MainWindow::on_actionSearch_triggered()
     dialog->show();
 }
 
+void MainWindow::on_actionReport_triggered()
+{
+    if (start_ != Section::kSales && start_ != Section::kPurchase)
+        return;
+
+    auto* sql { static_cast<SqliteOrder*>(data_->sql) };
+    auto* dialog { new Report(stakeholder_tree_->Model(), product_tree_->Model(), settings_, sql, this) };
+    dialog->setWindowFlags(Qt::Dialog | Qt::WindowStaysOnTopHint);
+
+    connect(dialog, &QDialog::rejected, this, [=, this]() { dialog_list_->removeOne(dialog); });
+
+    dialog_list_->append(dialog);
+    dialog->show();
+}
+
+void MainWindow::on_actionAging_triggered()
+{
+    if (start_ != Section::kSales && start_ != Section::kPurchase)
+        return;
+
+    auto* sql { static_cast<SqliteOrder*>(data_->sql) };
+    auto* dialog { new Aging(stakeholder_tree_->Model(), sql, settings_, this) };
+    dialog->setWindowFlags(Qt::Dialog | Qt::WindowStaysOnTopHint);
+
+    connect(dialog, &QDialog::rejected, this, [=, this]() { dialog_list_->removeOne(dialog); });
+
+    dialog_list_->append(dialog);
+    dialog->show();
+}
+
+void MainWindow::on_actionBalance_triggered()
+{
+    if (start_ != Section::kFinance && start_ != Section::kProduct && start_ != Section::kTask)
+        return;
+
+    if (!tree_widget_)
+        return;
+
+    const auto view { tree_widget_->View() };
+    if (!MainWindowUtils::HasSelection(view))
+        return;
+
+    const auto index { view->currentIndex() };
+    if (!index.isValid())
+        return;
+
+    auto model { tree_widget_->Model() };
+    const int node_id { index.siblingAtColumn(std::to_underlying(TreeEnum::kID)).data().toInt() };
+    if (model->TypeFPTS(node_id) != kTypeLeaf)
+        return;
+
+    auto* dialog { new Balance(settings_, data_->sql, node_id, model->Rule(node_id), model->GetPath(node_id), this) };
+    dialog->setWindowFlags(Qt::Dialog | Qt::WindowStaysOnTopHint);
+
+    connect(dialog, &QDialog::rejected, this, [=, this]() { dialog_list_->removeOne(dialog); });
+
+    dialog_list_->append(dialog);
+    dialog->show();
+}
+
+void MainWindow::on_actionTrialBalance_triggered()
+{
+    auto* tree { static_cast<TreeModelFinance*>(finance_tree_->Model().data()) };
+    auto* sql { static_cast<SqliteFinance*>(finance_data_.sql) };
+
+    auto* dialog { new TrialBalance(tree, sql, &finance_settings_, this) };
+    dialog->setWindowFlags(Qt::Dialog | Qt::WindowStaysOnTopHint);
+
+    connect(dialog, &QDialog::rejected, this, [=, this]() { finance_dialog_list_.removeOne(dialog); });
+
+    finance_dialog_list_.append(dialog);
+    dialog->show();
+}
+
+void MainWindow::on_actionRevalue_triggered()
+{
+    auto* dialog { new Revalue(finance_tree_->Model(), finance_data_.info.unit_map, finance_settings_.default_unit, finance_settings_.common_decimal, this) };
+    connect(dialog, &Revalue::SRevalue, this, &MainWindow::RRevalue);
+    dialog->exec();
+    dialog->deleteLater();
+}
+
+void MainWindow::RRevalue(int unit, double rate, int gain_loss_node)
+{
+    QHash<int, std::pair<double, double>> diff_hash {};
+
+    auto* sql { static_cast<SqliteFinance*>(finance_data_.sql) };
+    if (!sql->Revalue(diff_hash, unit, rate, gain_loss_node, QDateTime::currentDateTime().toString(kDateTimeFST)))
+        return;
+
+    auto* tree { static_cast<TreeModelFinance*>(finance_tree_->Model().data()) };
+    tree->Revalue(diff_hash);
+}
+
+void MainWindow::on_actionStock_triggered()
+{
+    auto* sql { static_cast<SqliteProduct*>(product_data_.sql) };
+    auto* dialog { new Stock(product_tree_->Model(), sql, &product_settings_, this) };
+    dialog->setWindowFlags(Qt::Dialog | Qt::WindowStaysOnTopHint);
+
+    connect(dialog, &QDialog::rejected, this, [=, this]() { product_dialog_list_.removeOne(dialog); });
+
+    product_dialog_list_.append(dialog);
+    dialog->show();
+}
+
+void MainWindow::on_actionIntegrity_triggered()
+{
+    // Section order, IntegrityModel looks sections up by their value
+    const QList<IntegritySection> section_list {
+        { Section::kFinance, tr("Finance"), finance_data_.sql, finance_tree_->Model() },
+        { Section::kProduct, tr("Product"), product_data_.sql, product_tree_->Model() },
+        { Section::kTask, tr("Task"), task_data_.sql, task_tree_->Model() },
+        { Section::kStakeholder, tr("Stakeholder"), stakeholder_data_.sql, stakeholder_tree_->Model() },
+        { Section::kSales, tr("Sales"), sales_data_.sql, sales_tree_->Model() },
+        { Section::kPurchase, tr("Purchase"), purchase_data_.sql, purchase_tree_->Model() },
+    };
+
+    auto* dialog { new Integrity(section_list, this) };
+    dialog->setWindowFlags(Qt::Dialog | Qt::WindowStaysOnTopHint);
+
+    connect(dialog, &QDialog::rejected, this, [=, this]() { dialog_list_->removeOne(dialog); });
+
+    dialog_list_->append(dialog);
+    dialog->show();
+}
+
+void MainWindow::on_actionMemory_triggered()
+{
+    auto* dialog { new Memory(MemorySectionList(), this) };
+    dialog->setWindowFlags(Qt::Dialog | Qt::WindowStaysOnTopHint);
+
+    connect(dialog, &QDialog::rejected, this, [=, this]() { dialog_list_->removeOne(dialog); });
+
+    dialog_list_->append(dialog);
+    dialog->show();
+}
+
+void MainWindow::on_actionTrace_toggled(bool checked)
+{
+    if (checked) {
+        Tracer::Instance().Start();
+        return;
+    }
+
+    Tracer::Instance().Stop();
+
+    const auto file_path { QFileDialog::getSaveFileName(this, tr("Save Trace"), QDir::homePath(), "*.json") };
+    if (!file_path.isEmpty())
+        Tracer::Instance().Save(file_path);
+}
+
+void MainWindow::RMemoryLog()
+{
+    MemoryModel model(MemorySectionList());
+    model.Refresh();
+
+    qInfo().noquote() << "Memory:" << model.Summary();
+}
+
+QList<MemorySection> MainWindow::MemorySectionList() const
+{
+    return {
+        { Section::kFinance, tr("Finance"), finance_data_.sql, finance_tree_->Model() },
+        { Section::kProduct, tr("Product"), product_data_.sql, product_tree_->Model() },
+        { Section::kTask, tr("Task"), task_data_.sql, task_tree_->Model() },
+        { Section::kStakeholder, tr("Stakeholder"), stakeholder_data_.sql, stakeholder_tree_->Model() },
+        { Section::kSales, tr("Sales"), sales_data_.sql, sales_tree_->Model() },
+        { Section::kPurchase, tr("Purchase"), purchase_data_.sql, purchase_tree_->Model() },
+    };
+}
+
 void MainWindow::RNodeLocation(int node_id)
 {
     auto* widget { tree_widget_ };
@@ -2205,6 +2632,40 @@ void MainWindow::SwitchSection(CTab& last_tab) const
     MainWindowUtils::SwitchDialog(dialog_hash_, true);
 }
 
+void MainWindow::SwitchSectionWith(Section section, QDialog* dialog)
+{
+    if (section == start_)
+        return;
+
+    // the dialog moves along, otherwise it would be hidden with the section it was opened from
+    dialog_list_->removeOne(dialog);
+
+    switch (section) {
+    case Section::kFinance:
+        ui->rBtnFinance->setChecked(true);
+        break;
+    case Section::kStakeholder:
+        ui->rBtnStakeholder->setChecked(true);
+        break;
+    case Section::kProduct:
+        ui->rBtnProduct->setChecked(true);
+        break;
+    case Section::kTask:
+        ui->rBtnTask->setChecked(true);
+        break;
+    case Section::kSales:
+        ui->rBtnSales->setChecked(true);
+        break;
+    case Section::kPurchase:
+        ui->rBtnPurchase->setChecked(true);
+        break;
+    default:
+        break;
+    }
+
+    dialog_list_->append(dialog);
+}
+
 void MainWindow::UpdateLastTab() const
 {
     if (data_) {
@@ -2369,8 +2830,11 @@ void MainWindow::on_rBtnPurchase_toggled(bool checked)
     SwitchSection(data_->tab);
 }
 
-void MainWindow::on_tabWidget_currentChanged(int /*index*/)
+void MainWindow::on_tabWidget_currentChanged(int index)
 {
+    if (const auto tab { ui->tabWidget->tabBar()->tabData(index).value<Tab>() }; pending_tab_.contains(tab))
+        RestorePendingTab(tab);
+
     auto* widget { ui->tabWidget->currentWidget() };
     if (!widget)
         return;
@@ -2414,20 +2878,29 @@ void MainWindow::on_actionExportStructure_triggered()
     if (source.isEmpty())
         return;
 
+    // the copy keeps the source's hierarchy storage, a lineage file has no closure tables to export
+    const bool lineage { sql_.Lineage() };
+
     QString destination { QFileDialog::getSaveFileName(this, tr("Export Structure"), QDir::homePath(), "*.ytx") };
-    if (!MainWindowUtils::NewFile(sql_, destination))
+    if (!MainWindowUtils::NewFile(sql_, destination, lineage))
         return;
 
-    auto future = QtConcurrent::run([source, destination]() {
+    auto future = QtConcurrent::run([source, destination, lineage]() {
         try {
             QStringList tables { kFinance, kStakeholder, kTask, kProduct };
             QStringList columns { kName, kRule, kType, kUnit, kRemoved };
-            MainWindowUtils::ExportColumns(source, destination, tables, columns);
 
-            tables = { kFinancePath, kStakeholderPath, kTaskPath, kProductPath };
-            columns = { kAncestor, kDescendant, kDistance };
+            if (lineage)
+                columns << kParent << kLineage;
+
             MainWindowUtils::ExportColumns(source, destination, tables, columns);
 
+            if (!lineage) {
+                tables = { kFinancePath, kStakeholderPath, kTaskPath, kProductPath };
+                columns = { kAncestor, kDescendant, kDistance };
+                MainWindowUtils::ExportColumns(source, destination, tables, columns);
+            }
+
             return true;
         } catch (const std::exception& e) {
             qWarning() << "Export failed:" << e.what();
@@ -26,12 +26,14 @@
 #include <QPointer>
 #include <QSettings>
 #include <QTableView>
+#include <QTimer>
 #include <QTranslator>
 
 #include "component/data.h"
 #include "component/settings.h"
 #include "component/using.h"
 #include "database/mainwindowsqlite.h"
+#include "table/memorymodel.h"
 #include "table/model/tablemodel.h"
 #include "table/model/tablemodelorder.h"
 #include "tree/model/treemodel.h"
@@ -77,6 +79,15 @@ private slots:
     void on_actionAbout_triggered();
     void on_actionPreferences_triggered();
     void on_actionSearch_triggered();
+    void on_actionReport_triggered();
+    void on_actionAging_triggered();
+    void on_actionBalance_triggered();
+    void on_actionTrialBalance_triggered();
+    void on_actionRevalue_triggered();
+    void on_actionStock_triggered();
+    void on_actionIntegrity_triggered();
+    void on_actionMemory_triggered();
+    void on_actionTrace_toggled(bool checked);
     void on_actionClearMenu_triggered();
     void on_actionNewFile_triggered();
     void on_actionOpenFile_triggered();
@@ -109,6 +120,11 @@ private slots:
     void RTreeViewCustomContextMenuRequested(const QPoint& pos);
     void RTreeViewDoubleClicked(const QModelIndex& index);
 
+    void RRestorePendingTab();
+    void RPrefetchTrans();
+    void RMemoryLog();
+    void RRevalue(int unit, double rate, int gain_loss_node);
+
 private:
     void SetTabWidget();
     void SetClearMenuAction();
@@ -135,13 +151,15 @@ private:
     void SetSupportView(PQTableView table_view) const;
     void DelegateSupport(PQTableView table_view, PTreeModel tree_model, CSettings* settings) const;
 
-    void TableConnectFPT(PQTableView table_view, PTableModel table_model, PTreeModel tree_model, CData* data) const;
-    void TableConnectOrder(PQTableView table_view, TableModelOrder* table_model, PTreeModel tree_model, TableWidgetOrder* widget) const;
-    void TableConnectStakeholder(PQTableView table_view, PTableModel table_model, PTreeModel tree_model, CData* data) const;
+    void TableConnectFPT(PTableModel table_model, PTreeModel tree_model, CData* data) const;
+    void TableConnectOrder(TableModelOrder* table_model, PTreeModel tree_model, TableWidgetOrder* widget) const;
+    void TableConnectStakeholder(PTableModel table_model, PTreeModel tree_model, CData* data) const;
 
-    void CreateSection(TreeWidget* tree_widget, TableHash& table_hash, CData& data, CSettings& settings, CString& name);
+    void CreateSection(TreeWidget* tree_widget, CData& data, CSettings& settings, CString& name);
     void SwitchSection(CTab& last_tab) const;
     void UpdateLastTab() const;
+    void SwitchSectionWith(Section section, QDialog* dialog);
+    QList<MemorySection> MemorySectionList() const;
 
     void SetDelegate(PQTreeView tree_view, CInfo& info, CSettings& settings) const;
     void DelegateFPTSO(PQTreeView tree_view, CInfo& info) const;
@@ -173,12 +191,17 @@ private:
     void UpdateStakeholderReference(QSet<int> stakeholder_nodes, bool branch) const;
 
     void LoadAndInstallTranslator(CString& language);
-    void ResizeColumn(QHeaderView* header, bool table_view = true) const;
+    void ResizeColumn(QAbstractItemView* view) const;
 
     void AppSettings();
     bool LockFile(const QFileInfo& file_info);
 
-    void RestoreTab(PTreeModel tree_model, TableHash& table_hash, CIntSet& set, CData& data, CSettings& settings);
+    void RestoreTab(PTreeModel tree_model, CIntSet& set, CInfo& info);
+    void RestorePendingTab(Tab tab);
+    void RemovePendingTab(CTab& tab);
+    int PendingTabIndex(CTab& tab) const;
+    QSet<int> PendingTab(Section section) const;
+    int AddTab(QWidget* widget, CString& name, CString& tool_tip, CTab& tab);
 
     void EnableAction(bool enable);
     void RestoreRecentFile();
@@ -201,6 +224,11 @@ private:
     std::shared_ptr<QSettings> app_settings_ {};
     std::shared_ptr<QSettings> file_settings_ {};
 
+    QList<Tab> pending_tab_ {};
+    QTimer* prefetch_timer_ {};
+    QTimer* memory_timer_ {};
+    QTimer* restore_timer_ {};
+
     TreeWidget* tree_widget_ {};
     TableHash* table_hash_ {};
     QList<PDialog>* dialog_list_ {};
@@ -53,17 +53,22 @@ QString MainWindowUtils::ResourceFile()
     return path;
 }
 
-QVariantList MainWindowUtils::SaveTab(CTableHash& table_hash)
+QVariantList MainWindowUtils::SaveTab(CTableHash& table_hash, CIntSet& pending_set)
 {
-    if (table_hash.isEmpty())
+    if (table_hash.isEmpty() && pending_set.isEmpty())
         return {};
 
     const auto keys { table_hash.keys() };
     QVariantList list {};
+    list.reserve(keys.size() + pending_set.size());
 
     for (int node_id : keys)
         list.emplaceBack(node_id);
 
+    // tabs restored as placeholders but never activated still belong to the session
+    for (int node_id : pending_set)
+        list.emplaceBack(node_id);
+
     return list;
 }
 
@@ -118,7 +123,7 @@ bool MainWindowUtils::CopyFile(CString& source, CString& destination)
     return true;
 }
 
-bool MainWindowUtils::NewFile(MainwindowSqlite& sql, QString& file_path)
+bool MainWindowUtils::NewFile(MainwindowSqlite& sql, QString& file_path, bool lineage)
 {
     if (file_path.isEmpty())
         return false;
@@ -131,7 +136,7 @@ bool MainWindowUtils::NewFile(MainwindowSqlite& sql, QString& file_path)
         QFile::remove(file_path);
     }
 
-    sql.NewFile(file_path);
+    sql.NewFile(file_path, lineage);
 
     return true;
 }
@@ -225,8 +230,10 @@ void MainWindowUtils::ExportColumns(CString& source, CString& destination, CStri
 
         while (source_query.next()) {
             QVariantList values;
+            // NULL stays NULL, a removed node's parent is NULL in a lineage file
             for (int i = 0; i < columns.size(); ++i) {
-                values.append(source_query.value(i).toString());
+                const QVariant value { source_query.value(i) };
+                values.append(value.isNull() ? QVariant() : value.toString());
             }
 
             insert_query = QString("INSERT INTO %1 (%2) VALUES (%3);").arg(name, column_names, GeneratePlaceholder(values));
@@ -41,7 +41,7 @@ concept MemberFunction = std::is_member_function_pointer_v<T>;
 class MainWindowUtils {
 public:
     static QString ResourceFile();
-    static QVariantList SaveTab(CTableHash& table_hash);
+    static QVariantList SaveTab(CTableHash& table_hash, CIntSet& pending_set = {});
     static QSet<int> ReadSettings(std::shared_ptr<QSettings> settings, CString& section, CString& property);
 
     static void WriteSettings(std::shared_ptr<QSettings> settings, const QVariant& value, CString& section, CString& property);
@@ -49,7 +49,7 @@ public:
     static void Message(QMessageBox::Icon icon, CString& title, CString& text, int timeout);
 
     static bool CopyFile(CString& source, CString& destination);
-    static bool NewFile(MainwindowSqlite& sql, QString& file_path);
+    static bool NewFile(MainwindowSqlite& sql, QString& file_path, bool lineage = false);
     static bool IsValidFile(const QFileInfo& file_info, CString& suffix = ytx);
     static bool IsTreeWidget(const QWidget* widget) { return widget && widget->inherits("TreeWidget"); }
 
@@ -0,0 +1,116 @@
+#include "agingmodel.h"
+
+#include "component/enumclass.h"
+
+AgingModel::AgingModel(CTreeModel* stakeholder_tree, SqliteOrder* sql, QObject* parent)
+    : QAbstractItemModel { parent }
+    , stakeholder_tree_ { stakeholder_tree }
+    , sql_ { sql }
+    , header_ { tr("Party"), tr("Current"), tr("1-30"), tr("31-60"), tr("61-90"), tr("90+"), tr("Total") }
+{
+}
+
+QModelIndex AgingModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (!hasIndex(row, column, parent))
+        return QModelIndex();
+
+    return createIndex(row, column);
+}
+
+QModelIndex AgingModel::parent(const QModelIndex& index) const
+{
+    Q_UNUSED(index);
+    return QModelIndex();
+}
+
+int AgingModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return row_list_.size();
+}
+
+int AgingModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return header_.size();
+}
+
+QVariant AgingModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole)
+        return QVariant();
+
+    const auto& row { row_list_.at(index.row()) };
+    const TableEnumAging kColumn { index.column() };
+
+    if (kColumn == TableEnumAging::kParty)
+        return stakeholder_tree_->GetPath(row.party);
+
+    return row.bucket.at(index.column() - 1);
+}
+
+QVariant AgingModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
+        return header_.at(section);
+
+    return QVariant();
+}
+
+void AgingModel::sort(int column, Qt::SortOrder order)
+{
+    if (column <= -1 || column >= header_.size())
+        return;
+
+    auto Compare = [this, column, order](const AgingRow& lhs, const AgingRow& rhs) -> bool {
+        const TableEnumAging kColumn { column };
+
+        if (kColumn == TableEnumAging::kParty) {
+            const auto lhs_path { stakeholder_tree_->GetPath(lhs.party) };
+            const auto rhs_path { stakeholder_tree_->GetPath(rhs.party) };
+            return (order == Qt::AscendingOrder) ? (lhs_path < rhs_path) : (lhs_path > rhs_path);
+        }
+
+        const double lhs_value { lhs.bucket.at(column - 1) };
+        const double rhs_value { rhs.bucket.at(column - 1) };
+        return (order == Qt::AscendingOrder) ? (lhs_value < rhs_value) : (lhs_value > rhs_value);
+    };
+
+    emit layoutAboutToBeChanged();
+    std::sort(row_list_.begin(), row_list_.end(), Compare);
+    emit layoutChanged();
+}
+
+void AgingModel::Query(const QDate& date)
+{
+    const auto* aging_hash { sql_->ReadAging() };
+    if (!aging_hash)
+        return;
+
+    QList<AgingRow> row_list {};
+    row_list.reserve(aging_hash->size());
+
+    const int total { std::to_underlying(TableEnumAging::kTotal) - 1 };
+
+    for (auto party = aging_hash->cbegin(); party != aging_hash->cend(); ++party) {
+        AgingRow row { party.key(), {} };
+
+        // payment term in days, read now so an edited term shows at once
+        const int term { qRound(stakeholder_tree_->First(party.key())) };
+
+        for (auto it = party->cbegin(); it != party->cend(); ++it) {
+            const auto overdue { QDate::fromString(it.key(), kDateFST).addDays(term).daysTo(date) };
+            const int bucket { overdue <= 0 ? 0 : static_cast<int>(std::min<qint64>((overdue - 1) / 30 + 1, total - 1)) };
+
+            row.bucket[bucket] += it.value();
+            row.bucket[total] += it.value();
+        }
+
+        row_list.emplaceBack(row);
+    }
+
+    beginResetModel();
+    row_list_ = std::move(row_list);
+    endResetModel();
+}
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef AGINGMODEL_H
+#define AGINGMODEL_H
+
+#include <QAbstractItemModel>
+
+#include "database/sqlite/sqliteorder.h"
+#include "tree/model/treemodel.h"
+
+// Outstanding of one party split by days past due, the last bucket is the total
+struct AgingRow {
+    int party {};
+    std::array<double, 6> bucket {};
+};
+
+class AgingModel final : public QAbstractItemModel {
+    Q_OBJECT
+public:
+    AgingModel(CTreeModel* stakeholder_tree, SqliteOrder* sql, QObject* parent = nullptr);
+    ~AgingModel() = default;
+
+public:
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& index) const override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    void sort(int column, Qt::SortOrder order) override;
+
+public:
+    void Query(const QDate& date);
+
+private:
+    CTreeModel* stakeholder_tree_ {};
+    SqliteOrder* sql_ {};
+
+    QStringList header_ {};
+    QList<AgingRow> row_list_ {};
+};
+
+#endif // AGINGMODEL_H
@@ -0,0 +1,78 @@
+#include "balancemodel.h"
+
+#include "component/enumclass.h"
+
+BalanceModel::BalanceModel(Sqlite* sql, int node_id, bool rule, QObject* parent)
+    : QAbstractItemModel { parent }
+    , sql_ { sql }
+    , node_id_ { node_id }
+    , rule_ { rule }
+    , header_ { tr("Date"), tr("Count"), tr("Change"), tr("Balance") }
+{
+}
+
+QModelIndex BalanceModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (!hasIndex(row, column, parent))
+        return QModelIndex();
+
+    return createIndex(row, column);
+}
+
+QModelIndex BalanceModel::parent(const QModelIndex& index) const
+{
+    Q_UNUSED(index);
+    return QModelIndex();
+}
+
+int BalanceModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return point_list_.size();
+}
+
+int BalanceModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return header_.size();
+}
+
+QVariant BalanceModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole)
+        return QVariant();
+
+    const auto& point { point_list_.at(index.row()) };
+    const TableEnumBalance kColumn { index.column() };
+
+    switch (kColumn) {
+    case TableEnumBalance::kDate:
+        return point.date;
+    case TableEnumBalance::kCount:
+        return point.count;
+    case TableEnumBalance::kChange:
+        return point.change;
+    case TableEnumBalance::kBalance:
+        return point.balance;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant BalanceModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
+        return header_.at(section);
+
+    return QVariant();
+}
+
+void BalanceModel::Query(BalancePeriod period, const QDate& start_date, const QDate& end_date)
+{
+    QList<BalancePoint> point_list {};
+    sql_->BalanceHistoryFPT(point_list, node_id_, rule_, period, start_date, end_date);
+
+    beginResetModel();
+    point_list_ = std::move(point_list);
+    endResetModel();
+}
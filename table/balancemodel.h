@@ -0,0 +1,55 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef BALANCEMODEL_H
+#define BALANCEMODEL_H
+
+#include <QAbstractItemModel>
+
+#include "database/sqlite/sqlite.h"
+
+class BalanceModel final : public QAbstractItemModel {
+    Q_OBJECT
+public:
+    BalanceModel(Sqlite* sql, int node_id, bool rule, QObject* parent = nullptr);
+    ~BalanceModel() = default;
+
+public:
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& index) const override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+public:
+    void Query(BalancePeriod period, const QDate& start_date, const QDate& end_date);
+
+private:
+    Sqlite* sql_ {};
+    const int node_id_ {};
+    const bool rule_ {};
+
+    QStringList header_ {};
+    QList<BalancePoint> point_list_ {};
+};
+
+#endif // BALANCEMODEL_H
@@ -0,0 +1,118 @@
+#include "integritymodel.h"
+
+#include "component/enumclass.h"
+
+IntegrityModel::IntegrityModel(const QList<IntegritySection>& section_list, QObject* parent)
+    : QAbstractItemModel { parent }
+    , section_list_ { section_list }
+    , header_ { tr("Section"), tr("Node"), tr("Issue"), tr("Ancestor"), tr("Stored"), tr("Expected") }
+{
+}
+
+QModelIndex IntegrityModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (!hasIndex(row, column, parent))
+        return QModelIndex();
+
+    return createIndex(row, column);
+}
+
+QModelIndex IntegrityModel::parent(const QModelIndex& index) const
+{
+    Q_UNUSED(index);
+    return QModelIndex();
+}
+
+int IntegrityModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return issue_list_.size();
+}
+
+int IntegrityModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return header_.size();
+}
+
+QVariant IntegrityModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole)
+        return QVariant();
+
+    const auto& issue { issue_list_.at(index.row()) };
+    const TableEnumIntegrity kColumn { index.column() };
+
+    switch (kColumn) {
+    case TableEnumIntegrity::kSection:
+        return section_list_.at(std::to_underlying(issue.section)).name;
+    case TableEnumIntegrity::kNode:
+        return NodePath(issue.section, issue.node_id);
+    case TableEnumIntegrity::kKind:
+        return KindText(issue.kind);
+    case TableEnumIntegrity::kAncestor:
+        return issue.ancestor_id == 0 ? QVariant() : NodePath(issue.section, issue.ancestor_id);
+    case TableEnumIntegrity::kStored:
+        return issue.stored;
+    case TableEnumIntegrity::kExpected:
+        return issue.expected;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant IntegrityModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
+        return header_.at(section);
+
+    return QVariant();
+}
+
+void IntegrityModel::Append(const QList<IntegrityIssue>& issue_list)
+{
+    if (issue_list.isEmpty())
+        return;
+
+    const int row { static_cast<int>(issue_list_.size()) };
+
+    beginInsertRows(QModelIndex(), row, row + issue_list.size() - 1);
+    issue_list_.append(issue_list);
+    endInsertRows();
+}
+
+void IntegrityModel::Clear()
+{
+    beginResetModel();
+    issue_list_.clear();
+    endResetModel();
+}
+
+QString IntegrityModel::NodePath(Section section, int node_id) const
+{
+    // removed or unknown nodes have no path in the tree, the id still tells which row is wrong
+    const auto path { section_list_.at(std::to_underlying(section)).tree->GetPath(node_id) };
+    return path.isEmpty() ? QString::number(node_id) : path;
+}
+
+QString IntegrityModel::KindText(IntegrityKind kind) const
+{
+    switch (kind) {
+    case IntegrityKind::kLeafInitial:
+        return tr("Leaf initial total");
+    case IntegrityKind::kLeafFinal:
+        return tr("Leaf final total");
+    case IntegrityKind::kBranchInitial:
+        return tr("Branch initial total");
+    case IntegrityKind::kBranchFinal:
+        return tr("Branch final total");
+    case IntegrityKind::kSelfRow:
+        return tr("Self row");
+    case IntegrityKind::kParent:
+        return tr("Parent");
+    case IntegrityKind::kPath:
+        return tr("Path distance");
+    default:
+        return {};
+    }
+}
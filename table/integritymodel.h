@@ -0,0 +1,68 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef INTEGRITYMODEL_H
+#define INTEGRITYMODEL_H
+
+#include <QAbstractItemModel>
+
+#include "database/sqlite/sqlite.h"
+#include "tree/model/treemodel.h"
+
+// One section the check runs over, its tree resolves paths and holds the branch totals kept in memory
+struct IntegritySection {
+    Section section {};
+    QString name {};
+    Sqlite* sql {};
+    TreeModel* tree {};
+};
+
+class IntegrityModel final : public QAbstractItemModel {
+    Q_OBJECT
+public:
+    // section_list holds all six sections in Section order
+    IntegrityModel(const QList<IntegritySection>& section_list, QObject* parent = nullptr);
+    ~IntegrityModel() = default;
+
+public:
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& index) const override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+public:
+    void Append(const QList<IntegrityIssue>& issue_list);
+    void Clear();
+
+private:
+    QString NodePath(Section section, int node_id) const;
+    QString KindText(IntegrityKind kind) const;
+
+private:
+    QList<IntegritySection> section_list_ {};
+
+    QStringList header_ {};
+    QList<IntegrityIssue> issue_list_ {};
+};
+
+#endif // INTEGRITYMODEL_H
@@ -0,0 +1,142 @@
+#include "memorymodel.h"
+
+#include <QLocale>
+
+#include "component/enumclass.h"
+
+MemoryModel::MemoryModel(const QList<MemorySection>& section_list, QObject* parent)
+    : QAbstractItemModel { parent }
+    , section_list_ { section_list }
+    , header_ { tr("Section"), tr("Item"), tr("Count"), tr("Bytes"), tr("Free"), tr("High Water") }
+{
+}
+
+QModelIndex MemoryModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (!hasIndex(row, column, parent))
+        return QModelIndex();
+
+    return createIndex(row, column);
+}
+
+QModelIndex MemoryModel::parent(const QModelIndex& index) const
+{
+    Q_UNUSED(index);
+    return QModelIndex();
+}
+
+int MemoryModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return row_list_.size();
+}
+
+int MemoryModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return header_.size();
+}
+
+QVariant MemoryModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid())
+        return QVariant();
+
+    const TableEnumMemory kColumn { index.column() };
+
+    if (role == Qt::TextAlignmentRole)
+        return kColumn == TableEnumMemory::kSection || kColumn == TableEnumMemory::kItem ? QVariant() : QVariant(int(Qt::AlignRight | Qt::AlignVCenter));
+
+    if (role != Qt::DisplayRole)
+        return QVariant();
+
+    const auto& row { row_list_.at(index.row()) };
+
+    switch (kColumn) {
+    case TableEnumMemory::kSection:
+        return row.owner;
+    case TableEnumMemory::kItem:
+        return row.item;
+    case TableEnumMemory::kCount:
+        return row.count;
+    case TableEnumMemory::kBytes:
+        return QLocale().formattedDataSize(row.bytes);
+    case TableEnumMemory::kFree:
+        return row.pool ? QVariant(row.pool->free) : QVariant();
+    case TableEnumMemory::kHighWater:
+        return row.pool ? QVariant(row.pool->high_water) : QVariant();
+    default:
+        return QVariant();
+    }
+}
+
+QVariant MemoryModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
+        return header_.at(section);
+
+    return QVariant();
+}
+
+template <Resettable T> void MemoryModel::AppendPool(CString& item)
+{
+    const PoolStat stat { ResourcePool<T>::Instance().Stat() };
+    const qsizetype bytes { (stat.in_use + stat.free) * qsizetype(sizeof(T)) };
+
+    row_list_.emplaceBack(MemoryRow { tr("Pool"), item, stat.in_use, bytes, stat });
+}
+
+void MemoryModel::Refresh()
+{
+    beginResetModel();
+    row_list_.clear();
+
+    // pool bytes count the structs only, the strings they hold are counted by the caches below
+    AppendPool<Node>(QStringLiteral("Node"));
+    AppendPool<NodeShadow>(QStringLiteral("NodeShadow"));
+    AppendPool<Trans>(QStringLiteral("Trans"));
+    AppendPool<TransShadow>(QStringLiteral("TransShadow"));
+
+    QList<MemoryStat> stat_list {};
+
+    for (const auto& section : std::as_const(section_list_)) {
+        stat_list.clear();
+        section.sql->AppendMemoryStat(stat_list);
+        section.tree->AppendMemoryStat(stat_list);
+
+        for (const auto& stat : std::as_const(stat_list))
+            row_list_.emplaceBack(MemoryRow { section.name, stat.item, stat.count, stat.bytes, std::nullopt });
+    }
+
+    endResetModel();
+}
+
+qsizetype MemoryModel::TotalBytes() const
+{
+    qsizetype bytes {};
+    for (const auto& row : row_list_)
+        bytes += row.bytes;
+
+    return bytes;
+}
+
+QString MemoryModel::Summary() const
+{
+    const QLocale locale {};
+    QStringList part_list {};
+
+    for (const auto& section : section_list_) {
+        qsizetype bytes {};
+        for (const auto& row : row_list_)
+            if (!row.pool && row.owner == section.name)
+                bytes += row.bytes;
+
+        part_list.emplaceBack(QStringLiteral("%1 %2").arg(section.name, locale.formattedDataSize(bytes)));
+    }
+
+    for (const auto& row : row_list_)
+        if (row.pool)
+            part_list.emplaceBack(QStringLiteral("%1 %2/%3/%4").arg(row.item).arg(row.pool->in_use).arg(row.pool->free).arg(row.pool->high_water));
+
+    return part_list.join(QStringLiteral(", "));
+}
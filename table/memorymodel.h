@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef MEMORYMODEL_H
+#define MEMORYMODEL_H
+
+#include <QAbstractItemModel>
+#include <optional>
+
+#include "database/sqlite/sqlite.h"
+#include "global/resourcepool.h"
+#include "tree/model/treemodel.h"
+
+// One section whose database caches and tree are reported
+struct MemorySection {
+    Section section {};
+    QString name {};
+    Sqlite* sql {};
+    TreeModel* tree {};
+};
+
+// pool rows carry the free list and the high water mark, section rows leave them empty
+struct MemoryRow {
+    QString owner {};
+    QString item {};
+    qsizetype count {};
+    qsizetype bytes {};
+    std::optional<PoolStat> pool {};
+};
+
+class MemoryModel final : public QAbstractItemModel {
+    Q_OBJECT
+public:
+    MemoryModel(const QList<MemorySection>& section_list, QObject* parent = nullptr);
+    ~MemoryModel() = default;
+
+public:
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& index) const override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+public:
+    // reads the pools and every section again, cheap enough to run on the GUI thread
+    void Refresh();
+    qsizetype TotalBytes() const;
+    // one line for the log, bytes per section then in use / free / high water of each pool
+    QString Summary() const;
+
+private:
+    template <Resettable T> void AppendPool(CString& item);
+
+private:
+    QList<MemorySection> section_list_ {};
+
+    QStringList header_ {};
+    QList<MemoryRow> row_list_ {};
+};
+
+#endif // MEMORYMODEL_H
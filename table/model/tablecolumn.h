@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TABLECOLUMN_H
+#define TABLECOLUMN_H
+
+#include "component/column.h"
+#include "component/enumclass.h"
+#include "table/trans.h"
+
+using TransField = ColumnField<TransShadow, int*, double*, QString*, bool*, double>;
+using TransColumn = ColumnDescriptor<TransField>;
+
+// Finance Product Task, subtotal is read but never sorted, the running balance follows the row order
+inline constexpr std::array kTableFinance {
+    TransColumn { .field = &TransShadow::id },
+    TransColumn { .field = &TransShadow::date_time, .sortable = true },
+    TransColumn { .field = &TransShadow::lhs_ratio, .sortable = true },
+    TransColumn { .field = &TransShadow::code, .sortable = true },
+    TransColumn { .field = &TransShadow::description, .sortable = true },
+    TransColumn { .field = &TransShadow::support_id, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::document, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::state, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::rhs_node, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::lhs_debit, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::lhs_credit, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::subtotal },
+};
+static_assert(kTableFinance.size() == std::to_underlying(TableEnumFinance::kSubtotal) + 1);
+
+inline constexpr std::array kTableProduct {
+    TransColumn { .field = &TransShadow::id },
+    TransColumn { .field = &TransShadow::date_time, .sortable = true },
+    TransColumn { .field = &TransShadow::unit_price, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::code, .sortable = true },
+    TransColumn { .field = &TransShadow::description, .sortable = true },
+    TransColumn { .field = &TransShadow::support_id, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::document, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::state, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::rhs_node, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::lhs_debit, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::lhs_credit, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::subtotal },
+};
+static_assert(kTableProduct.size() == std::to_underlying(TableEnumProduct::kSubtotal) + 1);
+
+// same layout as product, unit cost sits where product keeps its unit price
+inline constexpr auto kTableTask { kTableProduct };
+static_assert(kTableTask.size() == std::to_underlying(TableEnumTask::kSubtotal) + 1);
+
+inline constexpr std::array kTableStakeholder {
+    TransColumn { .field = &TransShadow::id },
+    TransColumn { .field = &TransShadow::date_time, .sortable = true },
+    TransColumn { .field = &TransShadow::unit_price, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::code, .sortable = true },
+    TransColumn { .field = &TransShadow::description, .sortable = true },
+    TransColumn { .field = &TransShadow::support_id, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::document, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::state, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::rhs_node, .blank_zero = true, .sortable = true },
+};
+static_assert(kTableStakeholder.size() == std::to_underlying(TableEnumStakeholder::kInsideProduct) + 1);
+
+inline constexpr std::array kTableSupport {
+    TransColumn { .field = &TransShadow::id },
+    TransColumn { .field = &TransShadow::date_time, .sortable = true },
+    TransColumn { .field = &TransShadow::code, .sortable = true },
+    TransColumn { .field = &TransShadow::lhs_node, .sortable = true },
+    TransColumn { .field = &TransShadow::lhs_ratio, .sortable = true },
+    TransColumn { .field = &TransShadow::lhs_debit, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::lhs_credit, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::description, .sortable = true },
+    TransColumn { .field = &TransShadow::unit_price, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::document, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::state, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::rhs_credit, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::rhs_debit, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::rhs_ratio, .sortable = true },
+    TransColumn { .field = &TransShadow::rhs_node, .sortable = true },
+};
+static_assert(kTableSupport.size() == std::to_underlying(TableEnumSupport::kRhsNode) + 1);
+
+// color is looked up in the product tree by TableModelOrder
+inline constexpr std::array kTableOrder {
+    TransColumn { .field = &TransShadow::id },
+    TransColumn { .field = &TransShadow::rhs_node, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::support_id, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::code, .sortable = true },
+    TransColumn { .field = &TransShadow::description },
+    TransColumn {},
+    TransColumn { .field = &TransShadow::lhs_debit, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::lhs_credit, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::unit_price, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::rhs_credit, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::discount_price, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::rhs_debit, .blank_zero = true, .sortable = true },
+    TransColumn { .field = &TransShadow::settled, .blank_zero = true, .sortable = true },
+};
+static_assert(kTableOrder.size() == std::to_underlying(TableEnumOrder::kSettled) + 1);
+
+#endif // TABLECOLUMN_H
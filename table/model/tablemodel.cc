@@ -1,7 +1,9 @@
 #include "tablemodel.h"
 
+#include <QTimer>
 #include <QtConcurrent>
 
+#include "component/constvalue.h"
 #include "global/resourcepool.h"
 #include "tablemodelutils.h"
 
@@ -41,7 +43,104 @@ void TableModel::RRule(int node_id, bool rule)
     for (auto* trans_shadow : trans_shadow_list_)
         trans_shadow->subtotal = -trans_shadow->subtotal;
 
+    opening_balance_ = -opening_balance_;
     rule_ = rule;
+
+    if (const int column { SubtotalColumn() }; column != -1 && !trans_shadow_list_.isEmpty())
+        emit dataChanged(index(0, column), index(rowCount() - 1, column), { Qt::DisplayRole });
+}
+
+void TableModel::AccumulateSubtotal(int start)
+{
+    TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, start, rule_, opening_balance_, this, [this](int first, int last) {
+        const int column { SubtotalColumn() };
+        last = std::min(last, rowCount() - 1);
+
+        if (column != -1 && first <= last)
+            emit dataChanged(index(first, column), index(last, column), { Qt::DisplayRole });
+    });
+}
+
+void TableModel::SetDateWindowFPT(const DateWindow& window)
+{
+    beginResetModel();
+
+    {
+        QMutexLocker locker(&mutex_);
+        ResourcePool<TransShadow>::Instance().Recycle(trans_shadow_list_);
+        window_ = window;
+        opening_balance_ = 0.0;
+        ReadTransFPT();
+    }
+
+    endResetModel();
+    AccumulateSubtotal(0);
+    emit SOpeningBalance(opening_balance_);
+}
+
+void TableModel::ReadTransFPT()
+{
+    if (node_id_ <= 0)
+        return;
+
+    if (window_.start_date.isValid()) {
+        sql_->OpeningBalanceFPT(opening_balance_, node_id_, rule_, window_.start_date);
+        sql_->ReadNodeTransWindowFPT(trans_shadow_list_, node_id_, window_.start_date, window_.end_date);
+    } else {
+        sql_->ReadNodeTrans(trans_shadow_list_, node_id_);
+    }
+}
+
+int TableModel::WindowSideFPT(CString& date_time) const
+{
+    if (!window_.start_date.isValid())
+        return 0;
+
+    if (date_time < window_.start_date.toString(kDateFST))
+        return -1;
+
+    return date_time >= window_.end_date.addDays(1).toString(kDateFST) ? 1 : 0;
+}
+
+void TableModel::ShiftOpeningBalanceFPT(double diff)
+{
+    if (diff == 0.0)
+        return;
+
+    opening_balance_ += diff;
+    AccumulateSubtotal(0);
+    emit SOpeningBalance(opening_balance_);
+}
+
+void TableModel::RedateFPT(int trans_id)
+{
+    if (!window_.start_date.isValid())
+        return;
+
+    // queued, the row is still under the editor that wrote the new date
+    QTimer::singleShot(0, this, [this, trans_id]() {
+        auto index { GetIndex(trans_id) };
+        if (!index.isValid())
+            return;
+
+        const int row { index.row() };
+        auto* trans_shadow { trans_shadow_list_.at(row) };
+
+        const int side { WindowSideFPT(*trans_shadow->date_time) };
+        if (side == 0)
+            return;
+
+        const double balance { TableModelUtils::Balance(rule_, *trans_shadow->lhs_debit, *trans_shadow->lhs_credit) };
+
+        beginRemoveRows(QModelIndex(), row, row);
+        ResourcePool<TransShadow>::Instance().Recycle(trans_shadow_list_.takeAt(row));
+        endRemoveRows();
+
+        if (side == -1)
+            ShiftOpeningBalanceFPT(balance);
+        else
+            AccumulateSubtotal(row);
+    });
 }
 
 void TableModel::RAppendOneTrans(const TransShadow* trans_shadow)
@@ -49,6 +148,14 @@ void TableModel::RAppendOneTrans(const TransShadow* trans_shadow)
     if (node_id_ != *trans_shadow->rhs_node)
         return;
 
+    // rows dated outside the window stay out, an earlier one is carried in the opening balance
+    if (const int side { WindowSideFPT(*trans_shadow->date_time) }; side != 0) {
+        if (side == -1)
+            ShiftOpeningBalanceFPT(TableModelUtils::Balance(rule_, *trans_shadow->rhs_debit, *trans_shadow->rhs_credit));
+
+        return;
+    }
+
     auto* new_trans_shadow { ResourcePool<TransShadow>::Instance().Allocate() };
     new_trans_shadow->date_time = trans_shadow->date_time;
     new_trans_shadow->id = trans_shadow->id;
@@ -77,7 +184,7 @@ void TableModel::RAppendOneTrans(const TransShadow* trans_shadow)
     trans_shadow_list_.emplaceBack(new_trans_shadow);
     endInsertRows();
 
-    double previous_balance { row >= 1 ? trans_shadow_list_.at(row - 1)->subtotal : 0.0 };
+    double previous_balance { row >= 1 ? trans_shadow_list_.at(row - 1)->subtotal : opening_balance_ };
     new_trans_shadow->subtotal = TableModelUtils::Balance(rule_, *new_trans_shadow->lhs_debit, *new_trans_shadow->lhs_credit) + previous_balance;
 }
 
@@ -95,7 +202,7 @@ void TableModel::RRemoveOneTrans(int node_id, int trans_id)
     ResourcePool<TransShadow>::Instance().Recycle(trans_shadow_list_.takeAt(row));
     endRemoveRows();
 
-    TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, row, rule_);
+    AccumulateSubtotal(row);
 }
 
 void TableModel::RUpdateBalance(int node_id, int trans_id)
@@ -105,7 +212,7 @@ void TableModel::RUpdateBalance(int node_id, int trans_id)
 
     auto index { GetIndex(trans_id) };
     if (index.isValid())
-        TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, index.row(), rule_);
+        AccumulateSubtotal(index.row());
 }
 
 bool TableModel::removeRows(int row, int /*count*/, const QModelIndex& parent)
@@ -133,7 +240,7 @@ bool TableModel::removeRows(int row, int /*count*/, const QModelIndex& parent)
 
         int trans_id { *trans_shadow->id };
         emit SRemoveOneTrans(info_.section, rhs_node_id, trans_id);
-        TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, row, rule_);
+        AccumulateSubtotal(row);
 
         if (int support_id = *trans_shadow->support_id; support_id != 0)
             emit SRemoveSupportTrans(info_.section, support_id, *trans_shadow->id);
@@ -290,7 +397,8 @@ QModelIndex TableModel::index(int row, int column, const QModelIndex& parent) co
     if (!hasIndex(row, column, parent))
         return QModelIndex();
 
-    return createIndex(row, column);
+    // the shadow identifies the row for its whole life, before and after it gets an id
+    return createIndex(row, column, trans_shadow_list_.at(row));
 }
 
 QModelIndex TableModel::parent(const QModelIndex& /*index*/) const { return QModelIndex(); }
@@ -333,7 +441,7 @@ QModelIndex TableModel::GetIndex(int trans_id) const
     return QModelIndex();
 }
 
-QStringList* TableModel::GetDocumentPointer(const QModelIndex& index) const
+int* TableModel::GetDocumentPointer(const QModelIndex& index) const
 {
     if (!index.isValid() || index.row() < 0 || index.row() >= trans_shadow_list_.size()) {
         qWarning() << "Invalid QModelIndex provided.";
@@ -372,6 +480,7 @@ bool TableModel::RemoveMultiTrans(const QList<int>& trans_id_list)
 
     int min_row { -1 };
     int trans_id {};
+    qsizetype removed {};
 
     for (int i = trans_shadow_list_.size() - 1; i >= 0; --i) {
         trans_id = *trans_shadow_list_.at(i)->id;
@@ -383,11 +492,21 @@ bool TableModel::RemoveMultiTrans(const QList<int>& trans_id_list)
             beginRemoveRows(QModelIndex(), i, i);
             ResourcePool<TransShadow>::Instance().Recycle(trans_shadow_list_.takeAt(i));
             endRemoveRows();
+            ++removed;
+        }
+    }
+
+    // ids missing from a windowed table may be dated before it, the database already has them moved or removed
+    if (window_.start_date.isValid() && removed != trans_id_list.size()) {
+        double opening_balance {};
+        if (sql_->OpeningBalanceFPT(opening_balance, node_id_, rule_, window_.start_date) && opening_balance != opening_balance_) {
+            ShiftOpeningBalanceFPT(opening_balance - opening_balance_);
+            return true;
         }
     }
 
     if (min_row != -1)
-        TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, min_row, rule_);
+        AccumulateSubtotal(min_row);
 
     return true;
 }
@@ -398,11 +517,31 @@ bool TableModel::AppendMultiTrans(int node_id, const QList<int>& trans_id_list)
     TransShadowList trans_shadow_list {};
 
     sql_->ReadTransRange(trans_shadow_list, node_id, trans_id_list);
-    beginInsertRows(QModelIndex(), row, row + trans_shadow_list.size() - 1);
-    trans_shadow_list_.append(trans_shadow_list);
-    endInsertRows();
 
-    TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, row, rule_);
+    // moved in rows dated outside the window stay out, earlier ones are carried in the opening balance
+    double opening_diff {};
+    trans_shadow_list.removeIf([this, &opening_diff](TransShadow* trans_shadow) {
+        const int side { WindowSideFPT(*trans_shadow->date_time) };
+        if (side == 0)
+            return false;
+
+        if (side == -1)
+            opening_diff += TableModelUtils::Balance(rule_, *trans_shadow->lhs_debit, *trans_shadow->lhs_credit);
+
+        ResourcePool<TransShadow>::Instance().Recycle(trans_shadow);
+        return true;
+    });
+
+    if (!trans_shadow_list.isEmpty()) {
+        beginInsertRows(QModelIndex(), row, row + trans_shadow_list.size() - 1);
+        trans_shadow_list_.append(trans_shadow_list);
+        endInsertRows();
+    }
+
+    if (opening_diff != 0.0)
+        ShiftOpeningBalanceFPT(opening_diff);
+    else
+        AccumulateSubtotal(row);
 
     return true;
 }
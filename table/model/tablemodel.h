@@ -27,6 +27,12 @@
 
 #include "database/sqlite/sqlite.h"
 
+// Finance Product Task, the rows dated inside [start_date, end_date] are loaded, an invalid start_date is the full history
+struct DateWindow {
+    QDate start_date {};
+    QDate end_date {};
+};
+
 class TableModel : public QAbstractItemModel {
     Q_OBJECT
 
@@ -54,6 +60,7 @@ signals:
 
     // send to its table view
     void SResizeColumnToContents(int column);
+    void SOpeningBalance(double opening_balance);
 
 public slots:
     // receive from Sqlite
@@ -80,12 +87,19 @@ public:
 
     virtual int GetNodeRow(int node_id) const;
     virtual bool IsSupport() const { return false; }
+    virtual int SubtotalColumn() const { return -1; }
 
     QModelIndex GetIndex(int trans_id) const;
-    QStringList* GetDocumentPointer(const QModelIndex& index) const;
+    int* GetDocumentPointer(const QModelIndex& index) const;
 
     void UpdateAllState(Check state);
 
+    // Finance Product Task, reloads only the rows dated inside the window, earlier rows are summed into
+    // opening_balance_ so subtotals stay those of the full ledger, an invalid start_date loads the full history again
+    void SetDateWindowFPT(const DateWindow& window);
+    const DateWindow& Window() const { return window_; }
+    double OpeningBalance() const { return opening_balance_; }
+
 protected:
     // virtual functions
     virtual bool UpdateDebit(TransShadow* trans_shadow, double value);
@@ -95,12 +109,26 @@ protected:
     virtual bool RemoveMultiTrans(const QList<int>& trans_id_list); // just remove trnas_shadow, keep trans
     virtual bool AppendMultiTrans(int node_id, const QList<int>& trans_id_list);
 
+    // runs the subtotal pass from start, the rows it changed are then announced by dataChanged on the subtotal column
+    void AccumulateSubtotal(int start);
+
+    // Finance Product Task, the first read, windowed when the constructor set window_
+    void ReadTransFPT();
+    // -1 before the window, 1 after it, 0 inside or without a window, compared as text the way the window query does
+    int WindowSideFPT(CString& date_time) const;
+    // a saved row whose date_time was just edited, it leaves the table once it falls outside the window
+    void RedateFPT(int trans_id);
+    // a row dated before the window moves opening_balance_ instead of joining the table
+    void ShiftOpeningBalanceFPT(double diff);
+
 protected:
     Sqlite* sql_ {};
     bool rule_ {};
 
     CInfo& info_;
     int node_id_ {};
+    DateWindow window_ {};
+    double opening_balance_ {};
     QMutex mutex_ {};
 
     QList<TransShadow*> trans_shadow_list_ {};
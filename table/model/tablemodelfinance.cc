@@ -1,13 +1,15 @@
 #include "tablemodelfinance.h"
 
 #include "component/constvalue.h"
+#include "global/tracer.h"
+#include "tablecolumn.h"
 #include "tablemodelutils.h"
 
-TableModelFinance::TableModelFinance(Sqlite* sql, bool rule, int node_id, CInfo& info, QObject* parent)
+TableModelFinance::TableModelFinance(Sqlite* sql, bool rule, int node_id, CInfo& info, const DateWindow& window, QObject* parent)
     : TableModel { sql, rule, node_id, info, parent }
 {
-    if (node_id >= 1)
-        sql_->ReadNodeTrans(trans_shadow_list_, node_id);
+    window_ = window;
+    ReadTransFPT();
 }
 
 QVariant TableModelFinance::data(const QModelIndex& index, int role) const
@@ -16,36 +18,7 @@ QVariant TableModelFinance::data(const QModelIndex& index, int role) const
         return QVariant();
 
     auto* trans_shadow { trans_shadow_list_.at(index.row()) };
-    const TableEnumFinance kColumn { index.column() };
-
-    switch (kColumn) {
-    case TableEnumFinance::kID:
-        return *trans_shadow->id;
-    case TableEnumFinance::kDateTime:
-        return *trans_shadow->date_time;
-    case TableEnumFinance::kCode:
-        return *trans_shadow->code;
-    case TableEnumFinance::kLhsRatio:
-        return *trans_shadow->lhs_ratio;
-    case TableEnumFinance::kDescription:
-        return *trans_shadow->description;
-    case TableEnumFinance::kSupportID:
-        return *trans_shadow->support_id == 0 ? QVariant() : *trans_shadow->support_id;
-    case TableEnumFinance::kRhsNode:
-        return *trans_shadow->rhs_node == 0 ? QVariant() : *trans_shadow->rhs_node;
-    case TableEnumFinance::kState:
-        return *trans_shadow->state ? *trans_shadow->state : QVariant();
-    case TableEnumFinance::kDocument:
-        return trans_shadow->document->isEmpty() ? QVariant() : trans_shadow->document->size();
-    case TableEnumFinance::kDebit:
-        return *trans_shadow->lhs_debit == 0 ? QVariant() : *trans_shadow->lhs_debit;
-    case TableEnumFinance::kCredit:
-        return *trans_shadow->lhs_credit == 0 ? QVariant() : *trans_shadow->lhs_credit;
-    case TableEnumFinance::kSubtotal:
-        return trans_shadow->subtotal;
-    default:
-        return QVariant();
-    }
+    return ColumnUtils::Data(kTableFinance, index.column(), trans_shadow);
 }
 
 bool TableModelFinance::setData(const QModelIndex& index, const QVariant& value, int role)
@@ -68,7 +41,8 @@ bool TableModelFinance::setData(const QModelIndex& index, const QVariant& value,
 
     switch (kColumn) {
     case TableEnumFinance::kDateTime:
-        TableModelUtils::UpdateField(sql_, trans_shadow, info_.transaction, value.toString(), kDateTime, &TransShadow::date_time);
+        if (TableModelUtils::UpdateField(sql_, trans_shadow, info_.transaction, value.toString(), kDateTime, &TransShadow::date_time))
+            RedateFPT(*trans_shadow->id);
         break;
     case TableEnumFinance::kCode:
         TableModelUtils::UpdateField(sql_, trans_shadow, info_.transaction, value.toString(), kCode, &TransShadow::code);
@@ -102,9 +76,8 @@ bool TableModelFinance::setData(const QModelIndex& index, const QVariant& value,
     if (old_rhs_node == 0) {
         if (rhs_changed) {
             sql_->WriteTrans(trans_shadow);
-            TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, kRow, rule_);
+            AccumulateSubtotal(kRow);
 
-            emit SResizeColumnToContents(std::to_underlying(TableEnumFinance::kSubtotal));
             emit SAppendOneTrans(info_.section, trans_shadow);
 
             double ratio { *trans_shadow->lhs_ratio };
@@ -141,10 +114,8 @@ bool TableModelFinance::setData(const QModelIndex& index, const QVariant& value,
         }
     }
 
-    if (deb_changed || cre_changed) {
-        TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, kRow, rule_);
-        emit SResizeColumnToContents(std::to_underlying(TableEnumFinance::kSubtotal));
-    }
+    if (deb_changed || cre_changed)
+        AccumulateSubtotal(kRow);
 
     if (rhs_changed) {
         sql_->UpdateTransValue(trans_shadow);
@@ -164,43 +135,19 @@ bool TableModelFinance::setData(const QModelIndex& index, const QVariant& value,
 
 void TableModelFinance::sort(int column, Qt::SortOrder order)
 {
+    const TraceSpan span { "TableSort", std::to_underlying(info_.section) };
+
     if (column <= -1 || column >= info_.table_header.size() - 1)
         return;
 
-    auto Compare = [column, order](TransShadow* lhs, TransShadow* rhs) -> bool {
-        const TableEnumFinance kColumn { column };
-
-        switch (kColumn) {
-        case TableEnumFinance::kDateTime:
-            return (order == Qt::AscendingOrder) ? (*lhs->date_time < *rhs->date_time) : (*lhs->date_time > *rhs->date_time);
-        case TableEnumFinance::kCode:
-            return (order == Qt::AscendingOrder) ? (*lhs->code < *rhs->code) : (*lhs->code > *rhs->code);
-        case TableEnumFinance::kLhsRatio:
-            return (order == Qt::AscendingOrder) ? (*lhs->lhs_ratio < *rhs->lhs_ratio) : (*lhs->lhs_ratio > *rhs->lhs_ratio);
-        case TableEnumFinance::kDescription:
-            return (order == Qt::AscendingOrder) ? (*lhs->description < *rhs->description) : (*lhs->description > *rhs->description);
-        case TableEnumFinance::kSupportID:
-            return (order == Qt::AscendingOrder) ? (*lhs->support_id < *rhs->support_id) : (*lhs->support_id > *rhs->support_id);
-        case TableEnumFinance::kRhsNode:
-            return (order == Qt::AscendingOrder) ? (*lhs->rhs_node < *rhs->rhs_node) : (*lhs->rhs_node > *rhs->rhs_node);
-        case TableEnumFinance::kState:
-            return (order == Qt::AscendingOrder) ? (*lhs->state < *rhs->state) : (*lhs->state > *rhs->state);
-        case TableEnumFinance::kDocument:
-            return (order == Qt::AscendingOrder) ? (lhs->document->size() < rhs->document->size()) : (lhs->document->size() > rhs->document->size());
-        case TableEnumFinance::kDebit:
-            return (order == Qt::AscendingOrder) ? (*lhs->lhs_debit < *rhs->lhs_debit) : (*lhs->lhs_debit > *rhs->lhs_debit);
-        case TableEnumFinance::kCredit:
-            return (order == Qt::AscendingOrder) ? (*lhs->lhs_credit < *rhs->lhs_credit) : (*lhs->lhs_credit > *rhs->lhs_credit);
-        default:
-            return false;
-        }
-    };
+    if (!ColumnUtils::Sortable(kTableFinance, column))
+        return;
 
     emit layoutAboutToBeChanged();
-    std::sort(trans_shadow_list_.begin(), trans_shadow_list_.end(), Compare);
+    ColumnUtils::Sort(kTableFinance, column, order, [this](auto Compare) { std::sort(trans_shadow_list_.begin(), trans_shadow_list_.end(), Compare); });
     emit layoutChanged();
 
-    TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, 0, rule_);
+    AccumulateSubtotal(0);
 }
 
 Qt::ItemFlags TableModelFinance::flags(const QModelIndex& index) const
@@ -26,13 +26,14 @@ class TableModelFinance final : public TableModel {
     Q_OBJECT
 
 public:
-    TableModelFinance(Sqlite* sql, bool rule, int node_id, CInfo& info, QObject* parent = nullptr);
+    TableModelFinance(Sqlite* sql, bool rule, int node_id, CInfo& info, const DateWindow& window, QObject* parent = nullptr);
     ~TableModelFinance() override = default;
 
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
     bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
     void sort(int column, Qt::SortOrder order) override;
     Qt::ItemFlags flags(const QModelIndex& index) const override;
+    int SubtotalColumn() const override { return std::to_underlying(TableEnumFinance::kSubtotal); }
 };
 
 #endif // TABLEMODELFINANCE_H
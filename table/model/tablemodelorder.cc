@@ -1,6 +1,8 @@
 #include "tablemodelorder.h"
 
 #include "global/resourcepool.h"
+#include "global/tracer.h"
+#include "tablecolumn.h"
 
 TableModelOrder::TableModelOrder(
     Sqlite* sql, bool rule, int node_id, CInfo& info, const NodeShadow* node_shadow, CTreeModel* product_tree, Sqlite* sqlite_stakeholder, QObject* parent)
@@ -14,7 +16,7 @@ TableModelOrder::TableModelOrder(
         sql_->ReadNodeTrans(trans_shadow_list_, node_id);
 
     if (party_id_ >= 1)
-        sqlite_stakeholder_->ReadTrans(party_id_);
+        sqlite_stakeholder_->ReadPriceBook(party_id_);
 }
 
 void TableModelOrder::RUpdateNodeID(int node_id)
@@ -86,7 +88,7 @@ void TableModelOrder::RUpdateParty(int node_id, int party_id)
         return;
 
     party_id_ = party_id;
-    sqlite_stakeholder_->ReadTrans(party_id);
+    sqlite_stakeholder_->ReadPriceBook(party_id);
 }
 
 QVariant TableModelOrder::data(const QModelIndex& index, int role) const
@@ -95,38 +97,11 @@ QVariant TableModelOrder::data(const QModelIndex& index, int role) const
         return QVariant();
 
     auto* trans_shadow { trans_shadow_list_.at(index.row()) };
-    const TableEnumOrder kColumn { index.column() };
 
-    switch (kColumn) {
-    case TableEnumOrder::kID:
-        return *trans_shadow->id;
-    case TableEnumOrder::kCode:
-        return *trans_shadow->code;
-    case TableEnumOrder::kInsideProduct:
-        return *trans_shadow->rhs_node == 0 ? QVariant() : *trans_shadow->rhs_node;
-    case TableEnumOrder::kUnitPrice:
-        return *trans_shadow->unit_price == 0 ? QVariant() : *trans_shadow->unit_price;
-    case TableEnumOrder::kSecond:
-        return *trans_shadow->lhs_credit == 0 ? QVariant() : *trans_shadow->lhs_credit;
-    case TableEnumOrder::kDescription:
-        return *trans_shadow->description;
-    case TableEnumOrder::kColor:
+    if (index.column() == std::to_underlying(TableEnumOrder::kColor))
         return *trans_shadow->rhs_node == 0 ? QVariant() : product_tree_->Color(*trans_shadow->rhs_node);
-    case TableEnumOrder::kFirst:
-        return *trans_shadow->lhs_debit == 0 ? QVariant() : *trans_shadow->lhs_debit;
-    case TableEnumOrder::kAmount:
-        return *trans_shadow->rhs_credit == 0 ? QVariant() : *trans_shadow->rhs_credit;
-    case TableEnumOrder::kSettled:
-        return *trans_shadow->settled == 0 ? QVariant() : *trans_shadow->settled;
-    case TableEnumOrder::kDiscount:
-        return *trans_shadow->rhs_debit == 0 ? QVariant() : *trans_shadow->rhs_debit;
-    case TableEnumOrder::kDiscountPrice:
-        return *trans_shadow->discount_price == 0 ? QVariant() : *trans_shadow->discount_price;
-    case TableEnumOrder::kOutsideProduct:
-        return *trans_shadow->support_id == 0 ? QVariant() : *trans_shadow->support_id;
-    default:
-        return QVariant();
-    }
+
+    return ColumnUtils::Data(kTableOrder, index.column(), trans_shadow);
 }
 
 bool TableModelOrder::setData(const QModelIndex& index, const QVariant& value, int role)
@@ -223,41 +198,17 @@ bool TableModelOrder::setData(const QModelIndex& index, const QVariant& value, i
 
 void TableModelOrder::sort(int column, Qt::SortOrder order)
 {
+    const TraceSpan span { "TableSort", std::to_underlying(info_.section) };
+
     // ignore subtotal column
     if (column <= -1 || column >= info_.table_header.size() - 1)
         return;
 
-    auto Compare = [column, order](TransShadow* lhs, TransShadow* rhs) -> bool {
-        const TableEnumOrder kColumn { column };
-
-        switch (kColumn) {
-        case TableEnumOrder::kCode:
-            return (order == Qt::AscendingOrder) ? (*lhs->code < *rhs->code) : (*lhs->code > *rhs->code);
-        case TableEnumOrder::kInsideProduct:
-            return (order == Qt::AscendingOrder) ? (*lhs->rhs_node < *rhs->rhs_node) : (*lhs->rhs_node > *rhs->rhs_node);
-        case TableEnumOrder::kUnitPrice:
-            return (order == Qt::AscendingOrder) ? (*lhs->unit_price < *rhs->unit_price) : (*lhs->unit_price > *rhs->unit_price);
-        case TableEnumOrder::kFirst:
-            return (order == Qt::AscendingOrder) ? (*lhs->lhs_debit < *rhs->lhs_debit) : (*lhs->lhs_debit > *rhs->lhs_debit);
-        case TableEnumOrder::kSecond:
-            return (order == Qt::AscendingOrder) ? (*lhs->lhs_credit < *rhs->lhs_credit) : (*lhs->lhs_credit > *rhs->lhs_credit);
-        case TableEnumOrder::kAmount:
-            return (order == Qt::AscendingOrder) ? (*lhs->rhs_credit < *rhs->rhs_credit) : (*lhs->rhs_credit > *rhs->rhs_credit);
-        case TableEnumOrder::kDiscount:
-            return (order == Qt::AscendingOrder) ? (*lhs->rhs_debit < *rhs->rhs_debit) : (*lhs->rhs_debit > *rhs->rhs_debit);
-        case TableEnumOrder::kDiscountPrice:
-            return (order == Qt::AscendingOrder) ? (*lhs->discount_price < *rhs->discount_price) : (*lhs->discount_price > *rhs->discount_price);
-        case TableEnumOrder::kOutsideProduct:
-            return (order == Qt::AscendingOrder) ? (*lhs->support_id < *rhs->support_id) : (*lhs->support_id > *rhs->support_id);
-        case TableEnumOrder::kSettled:
-            return (order == Qt::AscendingOrder) ? (*lhs->settled < *rhs->settled) : (*lhs->settled > *rhs->settled);
-        default:
-            return false;
-        }
-    };
+    if (!ColumnUtils::Sortable(kTableOrder, column))
+        return;
 
     emit layoutAboutToBeChanged();
-    std::sort(trans_shadow_list_.begin(), trans_shadow_list_.end(), Compare);
+    ColumnUtils::Sort(kTableOrder, column, order, [this](auto Compare) { std::sort(trans_shadow_list_.begin(), trans_shadow_list_.end(), Compare); });
     emit layoutChanged();
 }
 
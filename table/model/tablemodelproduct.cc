@@ -2,13 +2,15 @@
 
 #include "component/constvalue.h"
 #include "global/resourcepool.h"
+#include "global/tracer.h"
+#include "tablecolumn.h"
 #include "tablemodelutils.h"
 
-TableModelProduct::TableModelProduct(Sqlite* sql, bool rule, int node_id, CInfo& info, QObject* parent)
+TableModelProduct::TableModelProduct(Sqlite* sql, bool rule, int node_id, CInfo& info, const DateWindow& window, QObject* parent)
     : TableModel { sql, rule, node_id, info, parent }
 {
-    if (node_id >= 1)
-        sql_->ReadNodeTrans(trans_shadow_list_, node_id);
+    window_ = window;
+    ReadTransFPT();
 }
 
 QVariant TableModelProduct::data(const QModelIndex& index, int role) const
@@ -17,36 +19,7 @@ QVariant TableModelProduct::data(const QModelIndex& index, int role) const
         return QVariant();
 
     auto* trans_shadow { trans_shadow_list_.at(index.row()) };
-    const TableEnumProduct kColumn { index.column() };
-
-    switch (kColumn) {
-    case TableEnumProduct::kID:
-        return *trans_shadow->id;
-    case TableEnumProduct::kDateTime:
-        return *trans_shadow->date_time;
-    case TableEnumProduct::kCode:
-        return *trans_shadow->code;
-    case TableEnumProduct::kUnitCost:
-        return *trans_shadow->unit_price == 0 ? QVariant() : *trans_shadow->unit_price;
-    case TableEnumProduct::kDescription:
-        return *trans_shadow->description;
-    case TableEnumProduct::kSupportID:
-        return *trans_shadow->support_id == 0 ? QVariant() : *trans_shadow->support_id;
-    case TableEnumProduct::kRhsNode:
-        return *trans_shadow->rhs_node == 0 ? QVariant() : *trans_shadow->rhs_node;
-    case TableEnumProduct::kState:
-        return *trans_shadow->state ? *trans_shadow->state : QVariant();
-    case TableEnumProduct::kDocument:
-        return trans_shadow->document->isEmpty() ? QVariant() : trans_shadow->document->size();
-    case TableEnumProduct::kDebit:
-        return *trans_shadow->lhs_debit == 0 ? QVariant() : *trans_shadow->lhs_debit;
-    case TableEnumProduct::kCredit:
-        return *trans_shadow->lhs_credit == 0 ? QVariant() : *trans_shadow->lhs_credit;
-    case TableEnumProduct::kSubtotal:
-        return trans_shadow->subtotal;
-    default:
-        return QVariant();
-    }
+    return ColumnUtils::Data(kTableProduct, index.column(), trans_shadow);
 }
 
 bool TableModelProduct::setData(const QModelIndex& index, const QVariant& value, int role)
@@ -69,7 +42,8 @@ bool TableModelProduct::setData(const QModelIndex& index, const QVariant& value,
 
     switch (kColumn) {
     case TableEnumProduct::kDateTime:
-        TableModelUtils::UpdateField(sql_, trans_shadow, info_.transaction, value.toString(), kDateTime, &TransShadow::date_time);
+        if (TableModelUtils::UpdateField(sql_, trans_shadow, info_.transaction, value.toString(), kDateTime, &TransShadow::date_time))
+            RedateFPT(*trans_shadow->id);
         break;
     case TableEnumProduct::kCode:
         TableModelUtils::UpdateField(sql_, trans_shadow, info_.transaction, value.toString(), kCode, &TransShadow::code);
@@ -103,9 +77,8 @@ bool TableModelProduct::setData(const QModelIndex& index, const QVariant& value,
     if (old_rhs_node == 0) {
         if (rhs_changed) {
             sql_->WriteTrans(trans_shadow);
-            TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, kRow, rule_);
+            AccumulateSubtotal(kRow);
 
-            emit SResizeColumnToContents(std::to_underlying(TableEnumProduct::kSubtotal));
             emit SAppendOneTrans(info_.section, trans_shadow);
 
             emit SUpdateLeafValueOne(*trans_shadow->rhs_node, *trans_shadow->unit_price, kUnitCost);
@@ -145,10 +118,8 @@ bool TableModelProduct::setData(const QModelIndex& index, const QVariant& value,
         }
     }
 
-    if (deb_changed || cre_changed) {
-        TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, kRow, rule_);
-        emit SResizeColumnToContents(std::to_underlying(TableEnumProduct::kSubtotal));
-    }
+    if (deb_changed || cre_changed)
+        AccumulateSubtotal(kRow);
 
     if (rhs_changed) {
         sql_->UpdateTransValue(trans_shadow);
@@ -168,43 +139,19 @@ bool TableModelProduct::setData(const QModelIndex& index, const QVariant& value,
 
 void TableModelProduct::sort(int column, Qt::SortOrder order)
 {
+    const TraceSpan span { "TableSort", std::to_underlying(info_.section) };
+
     if (column <= -1 || column >= info_.table_header.size() - 1)
         return;
 
-    auto Compare = [column, order](TransShadow* lhs, TransShadow* rhs) -> bool {
-        const TableEnumProduct kColumn { column };
-
-        switch (kColumn) {
-        case TableEnumProduct::kDateTime:
-            return (order == Qt::AscendingOrder) ? (*lhs->date_time < *rhs->date_time) : (*lhs->date_time > *rhs->date_time);
-        case TableEnumProduct::kCode:
-            return (order == Qt::AscendingOrder) ? (*lhs->code < *rhs->code) : (*lhs->code > *rhs->code);
-        case TableEnumProduct::kUnitCost:
-            return (order == Qt::AscendingOrder) ? (*lhs->unit_price < *rhs->unit_price) : (*lhs->unit_price > *rhs->unit_price);
-        case TableEnumProduct::kDescription:
-            return (order == Qt::AscendingOrder) ? (*lhs->description < *rhs->description) : (*lhs->description > *rhs->description);
-        case TableEnumProduct::kSupportID:
-            return (order == Qt::AscendingOrder) ? (*lhs->support_id < *rhs->support_id) : (*lhs->support_id > *rhs->support_id);
-        case TableEnumProduct::kRhsNode:
-            return (order == Qt::AscendingOrder) ? (*lhs->rhs_node < *rhs->rhs_node) : (*lhs->rhs_node > *rhs->rhs_node);
-        case TableEnumProduct::kState:
-            return (order == Qt::AscendingOrder) ? (*lhs->state < *rhs->state) : (*lhs->state > *rhs->state);
-        case TableEnumProduct::kDocument:
-            return (order == Qt::AscendingOrder) ? (lhs->document->size() < rhs->document->size()) : (lhs->document->size() > rhs->document->size());
-        case TableEnumProduct::kDebit:
-            return (order == Qt::AscendingOrder) ? (*lhs->lhs_debit < *rhs->lhs_debit) : (*lhs->lhs_debit > *rhs->lhs_debit);
-        case TableEnumProduct::kCredit:
-            return (order == Qt::AscendingOrder) ? (*lhs->lhs_credit < *rhs->lhs_credit) : (*lhs->lhs_credit > *rhs->lhs_credit);
-        default:
-            return false;
-        }
-    };
+    if (!ColumnUtils::Sortable(kTableProduct, column))
+        return;
 
     emit layoutAboutToBeChanged();
-    std::sort(trans_shadow_list_.begin(), trans_shadow_list_.end(), Compare);
+    ColumnUtils::Sort(kTableProduct, column, order, [this](auto Compare) { std::sort(trans_shadow_list_.begin(), trans_shadow_list_.end(), Compare); });
     emit layoutChanged();
 
-    TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, 0, rule_);
+    AccumulateSubtotal(0);
 }
 
 Qt::ItemFlags TableModelProduct::flags(const QModelIndex& index) const
@@ -254,7 +201,7 @@ bool TableModelProduct::removeRows(int row, int /*count*/, const QModelIndex& pa
 
         int trans_id { *trans_shadow->id };
         emit SRemoveOneTrans(info_.section, rhs_node_id, trans_id);
-        TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, row, rule_);
+        AccumulateSubtotal(row);
 
         if (int support_id = *trans_shadow->support_id; support_id != 0)
             emit SRemoveSupportTrans(info_.section, support_id, *trans_shadow->id);
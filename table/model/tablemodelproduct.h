@@ -26,7 +26,7 @@ class TableModelProduct final : public TableModel {
     Q_OBJECT
 
 public:
-    TableModelProduct(Sqlite* sql, bool rule, int node_id, CInfo& info, QObject* parent = nullptr);
+    TableModelProduct(Sqlite* sql, bool rule, int node_id, CInfo& info, const DateWindow& window, QObject* parent = nullptr);
     ~TableModelProduct() override = default;
 
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
@@ -35,6 +35,7 @@ public:
     Qt::ItemFlags flags(const QModelIndex& index) const override;
 
     bool removeRows(int row, int count, const QModelIndex& parent = QModelIndex()) override;
+    int SubtotalColumn() const override { return std::to_underlying(TableEnumProduct::kSubtotal); }
 
 protected:
     bool UpdateDebit(TransShadow* trans_shadow, double value) override;
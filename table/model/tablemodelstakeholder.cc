@@ -4,6 +4,8 @@
 
 #include "component/constvalue.h"
 #include "global/resourcepool.h"
+#include "global/tracer.h"
+#include "tablecolumn.h"
 #include "tablemodelutils.h"
 
 TableModelStakeholder::TableModelStakeholder(Sqlite* sql, bool rule, int node_id, CInfo& info, QObject* parent)
@@ -93,30 +95,7 @@ QVariant TableModelStakeholder::data(const QModelIndex& index, int role) const
         return QVariant();
 
     auto* trans_shadow { trans_shadow_list_.at(index.row()) };
-    const TableEnumStakeholder kColumn { index.column() };
-
-    switch (kColumn) {
-    case TableEnumStakeholder::kID:
-        return *trans_shadow->id;
-    case TableEnumStakeholder::kDateTime:
-        return *trans_shadow->date_time;
-    case TableEnumStakeholder::kCode:
-        return *trans_shadow->code;
-    case TableEnumStakeholder::kUnitPrice:
-        return *trans_shadow->unit_price == 0 ? QVariant() : *trans_shadow->unit_price;
-    case TableEnumStakeholder::kDescription:
-        return *trans_shadow->description;
-    case TableEnumStakeholder::kDocument:
-        return trans_shadow->document->isEmpty() ? QVariant() : trans_shadow->document->size();
-    case TableEnumStakeholder::kState:
-        return *trans_shadow->state ? *trans_shadow->state : QVariant();
-    case TableEnumStakeholder::kInsideProduct:
-        return *trans_shadow->rhs_node == 0 ? QVariant() : *trans_shadow->rhs_node;
-    case TableEnumStakeholder::kOutsideProduct:
-        return *trans_shadow->support_id == 0 ? QVariant() : *trans_shadow->support_id;
-    default:
-        return QVariant();
-    }
+    return ColumnUtils::Data(kTableStakeholder, index.column(), trans_shadow);
 }
 
 bool TableModelStakeholder::setData(const QModelIndex& index, const QVariant& value, int role)
@@ -190,37 +169,17 @@ bool TableModelStakeholder::setData(const QModelIndex& index, const QVariant& va
 
 void TableModelStakeholder::sort(int column, Qt::SortOrder order)
 {
+    const TraceSpan span { "TableSort", std::to_underlying(info_.section) };
+
     // ignore subtotal column
     if (column <= -1 || column >= info_.table_header.size() - 1)
         return;
 
-    auto Compare = [column, order](TransShadow* lhs, TransShadow* rhs) -> bool {
-        const TableEnumStakeholder kColumn { column };
-
-        switch (kColumn) {
-        case TableEnumStakeholder::kDateTime:
-            return (order == Qt::AscendingOrder) ? (*lhs->date_time < *rhs->date_time) : (*lhs->date_time > *rhs->date_time);
-        case TableEnumStakeholder::kCode:
-            return (order == Qt::AscendingOrder) ? (*lhs->code < *rhs->code) : (*lhs->code > *rhs->code);
-        case TableEnumStakeholder::kUnitPrice:
-            return (order == Qt::AscendingOrder) ? (*lhs->unit_price < *rhs->unit_price) : (*lhs->unit_price > *rhs->unit_price);
-        case TableEnumStakeholder::kDescription:
-            return (order == Qt::AscendingOrder) ? (*lhs->description < *rhs->description) : (*lhs->description > *rhs->description);
-        case TableEnumStakeholder::kDocument:
-            return (order == Qt::AscendingOrder) ? (lhs->document->size() < rhs->document->size()) : (lhs->document->size() > rhs->document->size());
-        case TableEnumStakeholder::kState:
-            return (order == Qt::AscendingOrder) ? (*lhs->state < *rhs->state) : (*lhs->state > *rhs->state);
-        case TableEnumStakeholder::kOutsideProduct:
-            return (order == Qt::AscendingOrder) ? (*lhs->support_id < *rhs->support_id) : (*lhs->support_id > *rhs->support_id);
-        case TableEnumStakeholder::kInsideProduct:
-            return (order == Qt::AscendingOrder) ? (*lhs->rhs_node < *rhs->rhs_node) : (*lhs->rhs_node > *rhs->rhs_node);
-        default:
-            return false;
-        }
-    };
+    if (!ColumnUtils::Sortable(kTableStakeholder, column))
+        return;
 
     emit layoutAboutToBeChanged();
-    std::sort(trans_shadow_list_.begin(), trans_shadow_list_.end(), Compare);
+    ColumnUtils::Sort(kTableStakeholder, column, order, [this](auto Compare) { std::sort(trans_shadow_list_.begin(), trans_shadow_list_.end(), Compare); });
     emit layoutChanged();
 }
 
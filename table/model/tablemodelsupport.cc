@@ -3,6 +3,8 @@
 #include "component/constvalue.h"
 #include "component/enumclass.h"
 #include "global/resourcepool.h"
+#include "global/tracer.h"
+#include "tablecolumn.h"
 #include "tablemodelutils.h"
 
 TableModelSupport::TableModelSupport(Sqlite* sql, bool rule, int node_id, CInfo& info, QObject* parent)
@@ -83,42 +85,7 @@ QVariant TableModelSupport::data(const QModelIndex& index, int role) const
         return QVariant();
 
     auto* trans_shadow { trans_shadow_list_.at(index.row()) };
-    const TableEnumSupport kColumn { index.column() };
-
-    switch (kColumn) {
-    case TableEnumSupport::kID:
-        return *trans_shadow->id;
-    case TableEnumSupport::kDateTime:
-        return *trans_shadow->date_time;
-    case TableEnumSupport::kCode:
-        return *trans_shadow->code;
-    case TableEnumSupport::kLhsNode:
-        return *trans_shadow->lhs_node;
-    case TableEnumSupport::kLhsRatio:
-        return *trans_shadow->lhs_ratio;
-    case TableEnumSupport::kLhsDebit:
-        return *trans_shadow->lhs_debit == 0 ? QVariant() : *trans_shadow->lhs_debit;
-    case TableEnumSupport::kLhsCredit:
-        return *trans_shadow->lhs_credit == 0 ? QVariant() : *trans_shadow->lhs_credit;
-    case TableEnumSupport::kDescription:
-        return *trans_shadow->description;
-    case TableEnumSupport::kUnitPrice:
-        return *trans_shadow->unit_price == 0 ? QVariant() : *trans_shadow->unit_price;
-    case TableEnumSupport::kRhsNode:
-        return *trans_shadow->rhs_node;
-    case TableEnumSupport::kRhsRatio:
-        return *trans_shadow->rhs_ratio;
-    case TableEnumSupport::kRhsDebit:
-        return *trans_shadow->rhs_debit == 0 ? QVariant() : *trans_shadow->rhs_debit;
-    case TableEnumSupport::kRhsCredit:
-        return *trans_shadow->rhs_credit == 0 ? QVariant() : *trans_shadow->rhs_credit;
-    case TableEnumSupport::kState:
-        return *trans_shadow->state ? *trans_shadow->state : QVariant();
-    case TableEnumSupport::kDocument:
-        return trans_shadow->document->isEmpty() ? QVariant() : trans_shadow->document->size();
-    default:
-        return QVariant();
-    }
+    return ColumnUtils::Data(kTableSupport, index.column(), trans_shadow);
 }
 
 bool TableModelSupport::setData(const QModelIndex& index, const QVariant& value, int role)
@@ -155,48 +122,16 @@ bool TableModelSupport::setData(const QModelIndex& index, const QVariant& value,
 
 void TableModelSupport::sort(int column, Qt::SortOrder order)
 {
+    const TraceSpan span { "TableSort", std::to_underlying(info_.section) };
+
     if (column <= -1 || column >= info_.search_trans_header.size() - 1)
         return;
 
-    auto Compare = [column, order](const TransShadow* lhs, const TransShadow* rhs) -> bool {
-        const TableEnumSupport kColumn { column };
-
-        switch (kColumn) {
-        case TableEnumSupport::kDateTime:
-            return (order == Qt::AscendingOrder) ? (*lhs->date_time < *rhs->date_time) : (*lhs->date_time > *rhs->date_time);
-        case TableEnumSupport::kCode:
-            return (order == Qt::AscendingOrder) ? (*lhs->code < *rhs->code) : (*lhs->code > *rhs->code);
-        case TableEnumSupport::kLhsNode:
-            return (order == Qt::AscendingOrder) ? (*lhs->lhs_node < *rhs->lhs_node) : (*lhs->lhs_node > *rhs->lhs_node);
-        case TableEnumSupport::kLhsRatio:
-            return (order == Qt::AscendingOrder) ? (*lhs->lhs_ratio < *rhs->lhs_ratio) : (*lhs->lhs_ratio > *rhs->lhs_ratio);
-        case TableEnumSupport::kLhsDebit:
-            return (order == Qt::AscendingOrder) ? (*lhs->lhs_debit < *rhs->lhs_debit) : (*lhs->lhs_debit > *rhs->lhs_debit);
-        case TableEnumSupport::kLhsCredit:
-            return (order == Qt::AscendingOrder) ? (*lhs->lhs_credit < *rhs->lhs_credit) : (*lhs->lhs_credit > *rhs->lhs_credit);
-        case TableEnumSupport::kDescription:
-            return (order == Qt::AscendingOrder) ? (*lhs->description < *rhs->description) : (*lhs->description > *rhs->description);
-        case TableEnumSupport::kRhsNode:
-            return (order == Qt::AscendingOrder) ? (*lhs->rhs_node < *rhs->rhs_node) : (*lhs->rhs_node > *rhs->rhs_node);
-        case TableEnumSupport::kRhsRatio:
-            return (order == Qt::AscendingOrder) ? (*lhs->rhs_ratio < *rhs->rhs_ratio) : (*lhs->rhs_ratio > *rhs->rhs_ratio);
-        case TableEnumSupport::kRhsDebit:
-            return (order == Qt::AscendingOrder) ? (*lhs->rhs_debit < *rhs->rhs_debit) : (*lhs->rhs_debit > *rhs->rhs_debit);
-        case TableEnumSupport::kRhsCredit:
-            return (order == Qt::AscendingOrder) ? (*lhs->rhs_credit < *rhs->rhs_credit) : (*lhs->rhs_credit > *rhs->rhs_credit);
-        case TableEnumSupport::kState:
-            return (order == Qt::AscendingOrder) ? (*lhs->state < *rhs->state) : (*lhs->state > *rhs->state);
-        case TableEnumSupport::kDocument:
-            return (order == Qt::AscendingOrder) ? (lhs->document->size() < rhs->document->size()) : (lhs->document->size() > rhs->document->size());
-        case TableEnumSupport::kUnitPrice:
-            return (order == Qt::AscendingOrder) ? (*lhs->unit_price < *rhs->unit_price) : (*lhs->unit_price > *rhs->unit_price);
-        default:
-            return false;
-        }
-    };
+    if (!ColumnUtils::Sortable(kTableSupport, column))
+        return;
 
     emit layoutAboutToBeChanged();
-    std::sort(trans_shadow_list_.begin(), trans_shadow_list_.end(), Compare);
+    ColumnUtils::Sort(kTableSupport, column, order, [this](auto Compare) { std::sort(trans_shadow_list_.begin(), trans_shadow_list_.end(), Compare); });
     emit layoutChanged();
 }
 
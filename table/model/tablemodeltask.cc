@@ -4,13 +4,15 @@
 
 #include "component/constvalue.h"
 #include "global/resourcepool.h"
+#include "global/tracer.h"
+#include "tablecolumn.h"
 #include "tablemodelutils.h"
 
-TableModelTask::TableModelTask(Sqlite* sql, bool rule, int node_id, CInfo& info, QObject* parent)
+TableModelTask::TableModelTask(Sqlite* sql, bool rule, int node_id, CInfo& info, const DateWindow& window, QObject* parent)
     : TableModel { sql, rule, node_id, info, parent }
 {
-    if (node_id >= 1)
-        sql_->ReadNodeTrans(trans_shadow_list_, node_id);
+    window_ = window;
+    ReadTransFPT();
 }
 
 QVariant TableModelTask::data(const QModelIndex& index, int role) const
@@ -19,36 +21,7 @@ QVariant TableModelTask::data(const QModelIndex& index, int role) const
         return QVariant();
 
     auto* trans_shadow { trans_shadow_list_.at(index.row()) };
-    const TableEnumTask kColumn { index.column() };
-
-    switch (kColumn) {
-    case TableEnumTask::kID:
-        return *trans_shadow->id;
-    case TableEnumTask::kDateTime:
-        return *trans_shadow->date_time;
-    case TableEnumTask::kCode:
-        return *trans_shadow->code;
-    case TableEnumTask::kUnitCost:
-        return *trans_shadow->unit_price == 0 ? QVariant() : *trans_shadow->unit_price;
-    case TableEnumTask::kDescription:
-        return *trans_shadow->description;
-    case TableEnumTask::kSupportID:
-        return *trans_shadow->support_id == 0 ? QVariant() : *trans_shadow->support_id;
-    case TableEnumTask::kRhsNode:
-        return *trans_shadow->rhs_node == 0 ? QVariant() : *trans_shadow->rhs_node;
-    case TableEnumTask::kState:
-        return *trans_shadow->state ? *trans_shadow->state : QVariant();
-    case TableEnumTask::kDocument:
-        return trans_shadow->document->isEmpty() ? QVariant() : trans_shadow->document->size();
-    case TableEnumTask::kDebit:
-        return *trans_shadow->lhs_debit == 0 ? QVariant() : *trans_shadow->lhs_debit;
-    case TableEnumTask::kCredit:
-        return *trans_shadow->lhs_credit == 0 ? QVariant() : *trans_shadow->lhs_credit;
-    case TableEnumTask::kSubtotal:
-        return trans_shadow->subtotal;
-    default:
-        return QVariant();
-    }
+    return ColumnUtils::Data(kTableTask, index.column(), trans_shadow);
 }
 
 bool TableModelTask::setData(const QModelIndex& index, const QVariant& value, int role)
@@ -71,7 +44,8 @@ bool TableModelTask::setData(const QModelIndex& index, const QVariant& value, in
 
     switch (kColumn) {
     case TableEnumTask::kDateTime:
-        TableModelUtils::UpdateField(sql_, trans_shadow, info_.transaction, value.toString(), kDateTime, &TransShadow::date_time);
+        if (TableModelUtils::UpdateField(sql_, trans_shadow, info_.transaction, value.toString(), kDateTime, &TransShadow::date_time))
+            RedateFPT(*trans_shadow->id);
         break;
     case TableEnumTask::kCode:
         TableModelUtils::UpdateField(sql_, trans_shadow, info_.transaction, value.toString(), kCode, &TransShadow::code);
@@ -105,9 +79,8 @@ bool TableModelTask::setData(const QModelIndex& index, const QVariant& value, in
     if (old_rhs_node == 0) {
         if (rhs_changed) {
             sql_->WriteTrans(trans_shadow);
-            TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, kRow, rule_);
+            AccumulateSubtotal(kRow);
 
-            emit SResizeColumnToContents(std::to_underlying(TableEnumTask::kSubtotal));
             emit SAppendOneTrans(info_.section, trans_shadow);
 
             emit SUpdateLeafValueOne(*trans_shadow->rhs_node, *trans_shadow->unit_price, kUnitCost);
@@ -138,10 +111,8 @@ bool TableModelTask::setData(const QModelIndex& index, const QVariant& value, in
         emit SUpdateBalance(info_.section, old_rhs_node, *trans_shadow->id);
     }
 
-    if (deb_changed || cre_changed) {
-        TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, kRow, rule_);
-        emit SResizeColumnToContents(std::to_underlying(TableEnumTask::kSubtotal));
-    }
+    if (deb_changed || cre_changed)
+        AccumulateSubtotal(kRow);
 
     if (sup_changed) {
         if (old_hel_node != 0)
@@ -170,43 +141,19 @@ bool TableModelTask::setData(const QModelIndex& index, const QVariant& value, in
 
 void TableModelTask::sort(int column, Qt::SortOrder order)
 {
+    const TraceSpan span { "TableSort", std::to_underlying(info_.section) };
+
     if (column <= -1 || column >= info_.table_header.size() - 1)
         return;
 
-    auto Compare = [column, order](TransShadow* lhs, TransShadow* rhs) -> bool {
-        const TableEnumTask kColumn { column };
-
-        switch (kColumn) {
-        case TableEnumTask::kDateTime:
-            return (order == Qt::AscendingOrder) ? (*lhs->date_time < *rhs->date_time) : (*lhs->date_time > *rhs->date_time);
-        case TableEnumTask::kCode:
-            return (order == Qt::AscendingOrder) ? (*lhs->code < *rhs->code) : (*lhs->code > *rhs->code);
-        case TableEnumTask::kUnitCost:
-            return (order == Qt::AscendingOrder) ? (*lhs->unit_price < *rhs->unit_price) : (*lhs->unit_price > *rhs->unit_price);
-        case TableEnumTask::kDescription:
-            return (order == Qt::AscendingOrder) ? (*lhs->description < *rhs->description) : (*lhs->description > *rhs->description);
-        case TableEnumTask::kSupportID:
-            return (order == Qt::AscendingOrder) ? (*lhs->support_id < *rhs->support_id) : (*lhs->support_id > *rhs->support_id);
-        case TableEnumTask::kRhsNode:
-            return (order == Qt::AscendingOrder) ? (*lhs->rhs_node < *rhs->rhs_node) : (*lhs->rhs_node > *rhs->rhs_node);
-        case TableEnumTask::kState:
-            return (order == Qt::AscendingOrder) ? (*lhs->state < *rhs->state) : (*lhs->state > *rhs->state);
-        case TableEnumTask::kDocument:
-            return (order == Qt::AscendingOrder) ? (lhs->document->size() < rhs->document->size()) : (lhs->document->size() > rhs->document->size());
-        case TableEnumTask::kDebit:
-            return (order == Qt::AscendingOrder) ? (*lhs->lhs_debit < *rhs->lhs_debit) : (*lhs->lhs_debit > *rhs->lhs_debit);
-        case TableEnumTask::kCredit:
-            return (order == Qt::AscendingOrder) ? (*lhs->lhs_credit < *rhs->lhs_credit) : (*lhs->lhs_credit > *rhs->lhs_credit);
-        default:
-            return false;
-        }
-    };
+    if (!ColumnUtils::Sortable(kTableTask, column))
+        return;
 
     emit layoutAboutToBeChanged();
-    std::sort(trans_shadow_list_.begin(), trans_shadow_list_.end(), Compare);
+    ColumnUtils::Sort(kTableTask, column, order, [this](auto Compare) { std::sort(trans_shadow_list_.begin(), trans_shadow_list_.end(), Compare); });
     emit layoutChanged();
 
-    TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, 0, rule_);
+    AccumulateSubtotal(0);
 }
 
 Qt::ItemFlags TableModelTask::flags(const QModelIndex& index) const
@@ -257,7 +204,7 @@ bool TableModelTask::removeRows(int row, int /*count*/, const QModelIndex& paren
         int trans_id { *trans_shadow->id };
         emit SRemoveOneTrans(info_.section, rhs_node_id, trans_id);
 
-        TableModelUtils::AccumulateSubtotal(mutex_, trans_shadow_list_, row, rule_);
+        AccumulateSubtotal(row);
 
         if (int support_id = *trans_shadow->support_id; support_id != 0)
             emit SRemoveSupportTrans(info_.section, support_id, *trans_shadow->id);
@@ -2,19 +2,37 @@
 
 #include <QtConcurrent>
 
-void TableModelUtils::AccumulateSubtotal(QMutex& mutex, QList<TransShadow*>& trans_shadow_list, int start, bool rule)
+#include "global/tracer.h"
+
+void TableModelUtils::AccumulateSubtotal(
+    QMutex& mutex, QList<TransShadow*>& trans_shadow_list, int start, bool rule, double opening, QObject* context, const std::function<void(int, int)>& done)
 {
+    const TraceSpan span { "AccumulateSubtotal" };
+
     if (start <= -1 || start >= trans_shadow_list.size() || trans_shadow_list.isEmpty())
         return;
 
-    auto future = QtConcurrent::run([&, start, rule]() {
+    auto future = QtConcurrent::run([&, start, rule, opening, context, done]() {
         QMutexLocker locker(&mutex);
-        double previous_subtotal { start >= 1 ? trans_shadow_list.at(start - 1)->subtotal : 0.0 };
+        double previous_subtotal { start >= 1 ? trans_shadow_list.at(start - 1)->subtotal : opening };
+        int first { -1 };
+        int last { -1 };
+
+        for (int row = start; row != trans_shadow_list.size(); ++row) {
+            auto* trans_shadow { trans_shadow_list.at(row) };
+            const double subtotal { Balance(rule, *trans_shadow->lhs_debit, *trans_shadow->lhs_credit) + previous_subtotal };
+
+            if (trans_shadow->subtotal != subtotal) {
+                trans_shadow->subtotal = subtotal;
+                first = first == -1 ? row : first;
+                last = row;
+            }
+
+            previous_subtotal = subtotal;
+        }
 
-        std::accumulate(trans_shadow_list.begin() + start, trans_shadow_list.end(), previous_subtotal, [&](double current_subtotal, TransShadow* trans_shadow) {
-            trans_shadow->subtotal = Balance(rule, *trans_shadow->lhs_debit, *trans_shadow->lhs_credit) + current_subtotal;
-            return trans_shadow->subtotal;
-        });
+        if (context && done && first != -1)
+            QMetaObject::invokeMethod(context, [done, first, last]() { done(first, last); }, Qt::QueuedConnection);
     });
 }
 
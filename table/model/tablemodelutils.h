@@ -56,7 +56,10 @@ public:
         return true;
     }
 
-    static void AccumulateSubtotal(QMutex& mutex, QList<TransShadow*>& trans_shadow_list, int start, bool rule);
+    // opening is the balance carried in before the first row, nonzero only for a date windowed ledger
+    // done runs on context's thread after the pass, with the first and last row whose subtotal it changed
+    static void AccumulateSubtotal(QMutex& mutex, QList<TransShadow*>& trans_shadow_list, int start, bool rule, double opening = 0.0, QObject* context = nullptr,
+        const std::function<void(int, int)>& done = {});
     static double Balance(bool rule, double debit, double credit) { return (rule ? 1 : -1) * (credit - debit); };
     static bool UpdateRhsNode(TransShadow* trans_shadow, int value);
 };
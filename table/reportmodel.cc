@@ -0,0 +1,133 @@
+#include "reportmodel.h"
+
+#include "component/enumclass.h"
+
+ReportModel::ReportModel(CTreeModel* stakeholder_tree, CTreeModel* product_tree, SqliteOrder* sql, QObject* parent)
+    : QAbstractItemModel { parent }
+    , sql_ { sql }
+    , stakeholder_tree_ { stakeholder_tree }
+    , product_tree_ { product_tree }
+    , header_ { tr("Name"), tr("Orders"), tr("First"), tr("Second"), tr("Amount"), tr("Discount"), tr("Settled") }
+{
+}
+
+QModelIndex ReportModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (!hasIndex(row, column, parent))
+        return QModelIndex();
+
+    return createIndex(row, column);
+}
+
+QModelIndex ReportModel::parent(const QModelIndex& index) const
+{
+    Q_UNUSED(index);
+    return QModelIndex();
+}
+
+int ReportModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return report_list_.size();
+}
+
+int ReportModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return header_.size();
+}
+
+QVariant ReportModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole)
+        return QVariant();
+
+    const auto& row { report_list_.at(index.row()) };
+    const TableEnumReport kColumn { index.column() };
+
+    switch (kColumn) {
+    case TableEnumReport::kKey:
+        return Key(row);
+    case TableEnumReport::kCount:
+        return row.count;
+    case TableEnumReport::kFirst:
+        return row.first;
+    case TableEnumReport::kSecond:
+        return row.second;
+    case TableEnumReport::kAmount:
+        return row.amount;
+    case TableEnumReport::kDiscount:
+        return row.discount;
+    case TableEnumReport::kSettled:
+        return row.settled;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant ReportModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
+        return header_.at(section);
+
+    return QVariant();
+}
+
+void ReportModel::sort(int column, Qt::SortOrder order)
+{
+    if (column <= -1 || column >= header_.size())
+        return;
+
+    auto Compare = [this, column, order](const ReportRow& lhs, const ReportRow& rhs) -> bool {
+        const TableEnumReport kColumn { column };
+
+        switch (kColumn) {
+        case TableEnumReport::kKey:
+            return (order == Qt::AscendingOrder) ? (Key(lhs) < Key(rhs)) : (Key(lhs) > Key(rhs));
+        case TableEnumReport::kCount:
+            return (order == Qt::AscendingOrder) ? (lhs.count < rhs.count) : (lhs.count > rhs.count);
+        case TableEnumReport::kFirst:
+            return (order == Qt::AscendingOrder) ? (lhs.first < rhs.first) : (lhs.first > rhs.first);
+        case TableEnumReport::kSecond:
+            return (order == Qt::AscendingOrder) ? (lhs.second < rhs.second) : (lhs.second > rhs.second);
+        case TableEnumReport::kAmount:
+            return (order == Qt::AscendingOrder) ? (lhs.amount < rhs.amount) : (lhs.amount > rhs.amount);
+        case TableEnumReport::kDiscount:
+            return (order == Qt::AscendingOrder) ? (lhs.discount < rhs.discount) : (lhs.discount > rhs.discount);
+        case TableEnumReport::kSettled:
+            return (order == Qt::AscendingOrder) ? (lhs.settled < rhs.settled) : (lhs.settled > rhs.settled);
+        default:
+            return false;
+        }
+    };
+
+    emit layoutAboutToBeChanged();
+    std::sort(report_list_.begin(), report_list_.end(), Compare);
+    emit layoutChanged();
+}
+
+void ReportModel::Query(ReportGroup group, const QDate& start_date, const QDate& end_date)
+{
+    ReportHash report_hash {};
+    sql_->ReadReport(report_hash, group, start_date, end_date);
+
+    beginResetModel();
+    group_ = group;
+    report_list_ = report_hash.values();
+    endResetModel();
+}
+
+QString ReportModel::Key(const ReportRow& row) const
+{
+    switch (group_) {
+    case ReportGroup::kParty:
+    case ReportGroup::kEmployee:
+        return stakeholder_tree_->GetPath(row.key.toInt());
+    case ReportGroup::kProduct:
+        return product_tree_->GetPath(row.key.toInt());
+    case ReportGroup::kPeriod:
+        return row.key;
+    default:
+        return {};
+    }
+}
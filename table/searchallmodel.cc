@@ -0,0 +1,175 @@
+#include "searchallmodel.h"
+
+#include "component/enumclass.h"
+#include "tree/model/treemodelstakeholder.h"
+
+SearchAllModel::SearchAllModel(const QList<SearchSection>& section_list, CTreeModel* stakeholder_tree, QObject* parent)
+    : QAbstractItemModel { parent }
+    , section_list_ { section_list }
+    , stakeholder_tree_ { stakeholder_tree }
+    , header_ { tr("Section"), tr("Kind"), tr("Name"), tr("Code"), tr("Path"), tr("DateTime") }
+{
+}
+
+SearchAllModel::~SearchAllModel() { Cancel(); }
+
+QModelIndex SearchAllModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (!hasIndex(row, column, parent))
+        return QModelIndex();
+
+    return createIndex(row, column);
+}
+
+QModelIndex SearchAllModel::parent(const QModelIndex& index) const
+{
+    Q_UNUSED(index);
+    return QModelIndex();
+}
+
+int SearchAllModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return hit_list_.size();
+}
+
+int SearchAllModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return header_.size();
+}
+
+QVariant SearchAllModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole)
+        return QVariant();
+
+    const auto& hit { hit_list_.at(index.row()) };
+    const auto& search_section { section_list_.at(std::to_underlying(hit.section)) };
+    const TableEnumSearchAll kColumn { index.column() };
+
+    switch (kColumn) {
+    case TableEnumSearchAll::kSection:
+        return search_section.name;
+    case TableEnumSearchAll::kKind:
+        return hit.node ? tr("Node") : tr("Trans");
+    case TableEnumSearchAll::kName:
+        return hit.name;
+    case TableEnumSearchAll::kCode:
+        return hit.code;
+    case TableEnumSearchAll::kPath:
+        return search_section.tree->GetPath(hit.node ? hit.id : hit.lhs_node);
+    case TableEnumSearchAll::kDateTime:
+        return hit.date_time;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant SearchAllModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
+        return header_.at(section);
+
+    return QVariant();
+}
+
+void SearchAllModel::Query(CString& text)
+{
+    Cancel();
+
+    beginResetModel();
+    hit_list_.clear();
+    endResetModel();
+
+    if (text.isEmpty()) {
+        emit SQueryFinished();
+        return;
+    }
+
+    cancel_ = std::make_shared<std::atomic_bool>(false);
+    pending_ = section_list_.size();
+
+    auto* stakeholder_tree { static_cast<const TreeModelStakeholder*>(stakeholder_tree_) };
+
+    for (const auto& search_section : section_list_) {
+        // party names live in the stakeholder tree, so orders are matched by the ids found there
+        QList<int> party_id_list {};
+
+        if (search_section.section == Section::kSales)
+            party_id_list = stakeholder_tree->PartyList(text, kUnitCust);
+
+        if (search_section.section == Section::kPurchase)
+            party_id_list = stakeholder_tree->PartyList(text, kUnitVend);
+
+        search_section.sql->SearchAllAsync(text, party_id_list, cancel_, [this](const QList<SearchHit>& chunk, bool finished) { Insert(chunk, finished); });
+    }
+}
+
+void SearchAllModel::Cancel()
+{
+    if (cancel_)
+        cancel_->store(true);
+
+    cancel_.reset();
+    pending_ = 0;
+}
+
+void SearchAllModel::Insert(const QList<SearchHit>& chunk, bool finished)
+{
+    // rank first, nodes ahead of trans, then section order and newest date
+    auto Less = [](const SearchHit& lhs, const SearchHit& rhs) {
+        return std::tuple { lhs.rank, !lhs.node, lhs.section, rhs.date_time } < std::tuple { rhs.rank, !rhs.node, rhs.section, lhs.date_time };
+    };
+
+    if (!chunk.isEmpty()) {
+        QList<SearchHit> sorted { chunk };
+        std::stable_sort(sorted.begin(), sorted.end(), Less);
+
+        const auto first { std::upper_bound(hit_list_.cbegin(), hit_list_.cend(), sorted.first(), Less) - hit_list_.cbegin() };
+        const auto last { std::upper_bound(hit_list_.cbegin(), hit_list_.cend(), sorted.last(), Less) - hit_list_.cbegin() };
+
+        if (first == last) {
+            // the whole chunk falls between two rows, one insert
+            beginInsertRows(QModelIndex(), first, first + sorted.size() - 1);
+            hit_list_.insert(first, sorted.size(), SearchHit {});
+            std::move(sorted.begin(), sorted.end(), hit_list_.begin() + first);
+            endInsertRows();
+        } else {
+            // interleaved with rows already shown, one merge pass as a layout change,
+            // so the selection and the scroll position follow the rows they were on
+            emit layoutAboutToBeChanged();
+
+            QList<SearchHit> merged {};
+            merged.reserve(hit_list_.size() + sorted.size());
+
+            QList<int> new_row(hit_list_.size());
+            auto old_it { hit_list_.begin() };
+            auto chunk_it { sorted.begin() };
+
+            // the same order as std::merge, a row already shown stays ahead of an equal hit from the chunk
+            while (old_it != hit_list_.end() || chunk_it != sorted.end()) {
+                if (chunk_it == sorted.end() || (old_it != hit_list_.end() && !Less(*chunk_it, *old_it))) {
+                    new_row[old_it - hit_list_.begin()] = merged.size();
+                    merged.emplaceBack(std::move(*old_it++));
+                } else
+                    merged.emplaceBack(std::move(*chunk_it++));
+            }
+
+            hit_list_.swap(merged);
+
+            const auto from_list { persistentIndexList() };
+            QModelIndexList to_list {};
+            to_list.reserve(from_list.size());
+
+            for (const auto& from : from_list)
+                to_list.emplaceBack(createIndex(new_row.at(from.row()), from.column()));
+
+            changePersistentIndexList(from_list, to_list);
+            emit layoutChanged();
+        }
+    }
+
+    if (finished && --pending_ == 0)
+        emit SQueryFinished();
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef SEARCHALLMODEL_H
+#define SEARCHALLMODEL_H
+
+#include <QAbstractItemModel>
+
+#include "database/sqlite/sqlite.h"
+#include "tree/model/treemodel.h"
+
+// One section the all sections search runs over, its tree resolves node paths
+struct SearchSection {
+    Section section {};
+    QString name {};
+    Sqlite* sql {};
+    CTreeModel* tree {};
+};
+
+class SearchAllModel final : public QAbstractItemModel {
+    Q_OBJECT
+public:
+    // section_list holds all six sections in Section order
+    SearchAllModel(const QList<SearchSection>& section_list, CTreeModel* stakeholder_tree, QObject* parent = nullptr);
+    ~SearchAllModel();
+
+signals:
+    // send to Search, every section has delivered its last chunk
+    void SQueryFinished();
+
+public:
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& index) const override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+public:
+    // starts all sections at once, hits are kept ordered by rank as they arrive
+    void Query(CString& text);
+    const SearchHit& Hit(int row) const { return hit_list_.at(row); }
+
+private:
+    void Cancel();
+    void Insert(const QList<SearchHit>& chunk, bool finished);
+
+private:
+    QList<SearchSection> section_list_ {};
+    CTreeModel* stakeholder_tree_ {};
+
+    QStringList header_ {};
+    QList<SearchHit> hit_list_ {};
+    SearchCancel cancel_ {};
+    int pending_ {};
+};
+
+#endif // SEARCHALLMODEL_H
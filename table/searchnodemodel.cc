@@ -73,7 +73,7 @@ QVariant SearchNodeModel::data(const QModelIndex& index, int role) const
     case TreeEnumSearch::kColor:
         return node->color;
     case TreeEnumSearch::kDocument:
-        return node->document.isEmpty() ? QVariant() : node->document.size();
+        return node->document == 0 ? QVariant() : node->document;
     case TreeEnumSearch::kFirst:
         return node->first == 0 ? QVariant() : node->first;
     case TreeEnumSearch::kSecond:
@@ -131,7 +131,7 @@ void SearchNodeModel::sort(int column, Qt::SortOrder order)
         case TreeEnumSearch::kColor:
             return (order == Qt::AscendingOrder) ? (lhs->color < rhs->color) : (lhs->color > rhs->color);
         case TreeEnumSearch::kDocument:
-            return (order == Qt::AscendingOrder) ? (lhs->document.size() < rhs->document.size()) : (lhs->document.size() > rhs->document.size());
+            return (order == Qt::AscendingOrder) ? (lhs->document < rhs->document) : (lhs->document > rhs->document);
         case TreeEnumSearch::kFirst:
             return (order == Qt::AscendingOrder) ? (lhs->first < rhs->first) : (lhs->first > rhs->first);
         case TreeEnumSearch::kSecond:
@@ -156,10 +156,11 @@ void SearchNodeModel::sort(int column, Qt::SortOrder order)
 
 void SearchNodeModel::Query(const QString& text)
 {
-    node_list_.clear();
     auto* stakeholder_tree { static_cast<const TreeModelStakeholder*>(stakeholder_tree_model_) };
 
     beginResetModel();
+    node_list_.clear();
+
     switch (info_.section) {
     case Section::kSales:
         static_cast<SqliteOrder*>(sql_)->SearchNode(node_list_, stakeholder_tree->PartyList(text, kUnitCust));
@@ -171,11 +172,12 @@ void SearchNodeModel::Query(const QString& text)
     case Section::kProduct:
     case Section::kTask:
     case Section::kStakeholder:
-        tree_model_->SearchNodeFPTS(node_list_, sql_->SearchNodeName(text));
+        tree_model_->SearchNodeFPTS(node_list_, text);
         break;
     default:
         break;
     }
 
     endResetModel();
+    emit SQueryFinished();
 }
@@ -33,6 +33,10 @@ public:
     SearchNodeModel(CInfo& info, CTreeModel* tree_model, CTreeModel* stakeholder_tree_model, Sqlite* sql, QObject* parent = nullptr);
     ~SearchNodeModel() = default;
 
+signals:
+    // send to Search, the current query is in
+    void SQueryFinished();
+
 public:
     QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
     QModelIndex parent(const QModelIndex& index) const override;
@@ -46,6 +50,7 @@ public:
     void sort(int column, Qt::SortOrder order) override;
 
 public:
+    // Finance Product Task Stakeholder are answered by the tree's node index, orders are still read from sql
     void Query(CString& text);
 
 private:
@@ -1,6 +1,7 @@
 #include "searchtransmodel.h"
 
 #include "component/enumclass.h"
+#include "global/resourcepool.h"
 
 SearchTransModel::SearchTransModel(CInfo& info, Sqlite* sql, QObject* parent)
     : QAbstractItemModel { parent }
@@ -9,7 +10,11 @@ SearchTransModel::SearchTransModel(CInfo& info, Sqlite* sql, QObject* parent)
 {
 }
 
-SearchTransModel::~SearchTransModel() { trans_list_.clear(); }
+SearchTransModel::~SearchTransModel()
+{
+    Cancel();
+    ResourcePool<Trans>::Instance().Recycle(trans_list_);
+}
 
 QModelIndex SearchTransModel::index(int row, int column, const QModelIndex& parent) const
 {
@@ -77,7 +82,7 @@ QVariant SearchTransModel::data(const QModelIndex& index, int role) const
     case TableEnumSearch::kState:
         return trans->state ? trans->state : QVariant();
     case TableEnumSearch::kDocument:
-        return trans->document.isEmpty() ? QVariant() : trans->document.size();
+        return trans->document == 0 ? QVariant() : trans->document;
     default:
         return QVariant();
     }
@@ -125,7 +130,7 @@ void SearchTransModel::sort(int column, Qt::SortOrder order)
         case TableEnumSearch::kState:
             return (order == Qt::AscendingOrder) ? (lhs->state < rhs->state) : (lhs->state > rhs->state);
         case TableEnumSearch::kDocument:
-            return (order == Qt::AscendingOrder) ? (lhs->document.size() < rhs->document.size()) : (lhs->document.size() > rhs->document.size());
+            return (order == Qt::AscendingOrder) ? (lhs->document < rhs->document) : (lhs->document > rhs->document);
         case TableEnumSearch::kUnitPrice:
             return (order == Qt::AscendingOrder) ? (lhs->unit_price < rhs->unit_price) : (lhs->unit_price > rhs->unit_price);
         case TableEnumSearch::kSupportID:
@@ -144,11 +149,39 @@ void SearchTransModel::sort(int column, Qt::SortOrder order)
 
 void SearchTransModel::Query(const QString& text)
 {
-    beginResetModel();
-    if (!trans_list_.isEmpty())
-        trans_list_.clear();
+    Cancel();
 
-    if (!text.isEmpty())
-        sql_->SearchTrans(trans_list_, text);
+    beginResetModel();
+    ResourcePool<Trans>::Instance().Recycle(trans_list_);
     endResetModel();
+
+    if (text.isEmpty()) {
+        emit SQueryFinished();
+        return;
+    }
+
+    cancel_ = std::make_shared<std::atomic_bool>(false);
+    sql_->SearchTransAsync(text, cancel_, [this](TransList& chunk, bool finished) { AppendChunk(chunk, finished); });
+}
+
+void SearchTransModel::Cancel()
+{
+    if (cancel_)
+        cancel_->store(true);
+
+    cancel_.reset();
+}
+
+void SearchTransModel::AppendChunk(TransList& chunk, bool finished)
+{
+    if (!chunk.isEmpty()) {
+        const auto row { trans_list_.size() };
+
+        beginInsertRows(QModelIndex(), row, row + chunk.size() - 1);
+        trans_list_.append(chunk);
+        endInsertRows();
+    }
+
+    if (finished)
+        emit SQueryFinished();
 }
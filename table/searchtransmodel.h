@@ -31,6 +31,10 @@ public:
     SearchTransModel(CInfo& info, Sqlite* sql, QObject* parent = nullptr);
     ~SearchTransModel();
 
+signals:
+    // send to Search, the last chunk of the current query has arrived
+    void SQueryFinished();
+
 public:
     QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
     QModelIndex parent(const QModelIndex& index) const override;
@@ -44,12 +48,19 @@ public:
     void sort(int column, Qt::SortOrder order) override;
 
 public:
+    // cancels the running query, rows of the new one are appended as the worker delivers them
     void Query(const QString& text);
 
+private:
+    void Cancel();
+    void AppendChunk(TransList& chunk, bool finished);
+
 private:
     Sqlite* sql_ {};
 
+    // owned by the model, read on the worker connection and recycled on the next query
     TransList trans_list_ {};
+    SearchCancel cancel_ {};
     CInfo& info_;
 };
 
@@ -0,0 +1,115 @@
+#include "stockmodel.h"
+
+#include "component/enumclass.h"
+
+StockModel::StockModel(CTreeModel* product_tree, SqliteProduct* sql, QObject* parent)
+    : QAbstractItemModel { parent }
+    , product_tree_ { product_tree }
+    , sql_ { sql }
+    , header_ { tr("Name"), tr("Quantity"), tr("Average"), tr("Value") }
+{
+}
+
+QModelIndex StockModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (!hasIndex(row, column, parent))
+        return QModelIndex();
+
+    return createIndex(row, column);
+}
+
+QModelIndex StockModel::parent(const QModelIndex& index) const
+{
+    Q_UNUSED(index);
+    return QModelIndex();
+}
+
+int StockModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return row_list_.size();
+}
+
+int StockModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return header_.size();
+}
+
+QVariant StockModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole)
+        return QVariant();
+
+    const auto& row { row_list_.at(index.row()) };
+    const TableEnumStock kColumn { index.column() };
+
+    switch (kColumn) {
+    case TableEnumStock::kName:
+        return product_tree_->GetPath(row.product_id);
+    case TableEnumStock::kQuantity:
+        return row.quantity;
+    case TableEnumStock::kAverage:
+        return std::abs(row.quantity) < kTolerance ? 0.0 : row.value / row.quantity;
+    case TableEnumStock::kValue:
+        return row.value;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant StockModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
+        return header_.at(section);
+
+    return QVariant();
+}
+
+void StockModel::sort(int column, Qt::SortOrder order)
+{
+    if (column <= -1 || column >= header_.size())
+        return;
+
+    auto Average = [](const StockRow& row) { return std::abs(row.quantity) < kTolerance ? 0.0 : row.value / row.quantity; };
+
+    auto Compare = [this, column, order, &Average](const StockRow& lhs, const StockRow& rhs) -> bool {
+        const TableEnumStock kColumn { column };
+
+        switch (kColumn) {
+        case TableEnumStock::kName:
+            return (order == Qt::AscendingOrder) ? (product_tree_->GetPath(lhs.product_id) < product_tree_->GetPath(rhs.product_id))
+                                                 : (product_tree_->GetPath(lhs.product_id) > product_tree_->GetPath(rhs.product_id));
+        case TableEnumStock::kQuantity:
+            return (order == Qt::AscendingOrder) ? (lhs.quantity < rhs.quantity) : (lhs.quantity > rhs.quantity);
+        case TableEnumStock::kAverage:
+            return (order == Qt::AscendingOrder) ? (Average(lhs) < Average(rhs)) : (Average(lhs) > Average(rhs));
+        case TableEnumStock::kValue:
+            return (order == Qt::AscendingOrder) ? (lhs.value < rhs.value) : (lhs.value > rhs.value);
+        default:
+            return false;
+        }
+    };
+
+    emit layoutAboutToBeChanged();
+    std::sort(row_list_.begin(), row_list_.end(), Compare);
+    emit layoutChanged();
+}
+
+void StockModel::Query(const QDate& date)
+{
+    QList<StockRow> row_list {};
+    StockRow row {};
+
+    for (int product_id : sql_->StockProduct()) {
+        row.product_id = product_id;
+        sql_->Stock(row.quantity, row.value, product_id, date);
+
+        if (std::abs(row.quantity) >= kTolerance || std::abs(row.value) >= kTolerance)
+            row_list.emplaceBack(row);
+    }
+
+    beginResetModel();
+    row_list_ = std::move(row_list);
+    endResetModel();
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef STOCKMODEL_H
+#define STOCKMODEL_H
+
+#include <QAbstractItemModel>
+
+#include "database/sqlite/sqliteproduct.h"
+#include "tree/model/treemodel.h"
+
+// Quantity and value on hand of every stocked product at one date
+struct StockRow {
+    int product_id {};
+    double quantity {};
+    double value {};
+};
+
+class StockModel final : public QAbstractItemModel {
+    Q_OBJECT
+public:
+    StockModel(CTreeModel* product_tree, SqliteProduct* sql, QObject* parent = nullptr);
+    ~StockModel() = default;
+
+public:
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+    QModelIndex parent(const QModelIndex& index) const override;
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+
+    void sort(int column, Qt::SortOrder order) override;
+
+public:
+    void Query(const QDate& date);
+
+private:
+    CTreeModel* product_tree_ {};
+    SqliteProduct* sql_ {};
+
+    QStringList header_ {};
+    QList<StockRow> row_list_ {};
+};
+
+#endif // STOCKMODEL_H
@@ -31,7 +31,7 @@ struct Trans {
     double lhs_debit {};
     double lhs_credit {};
     QString description {};
-    QStringList document {};
+    int document {}; // rows in the document table, the paths are read only when edited
     bool state { false };
     double rhs_credit {};
     double rhs_debit {};
@@ -59,12 +59,18 @@ struct Trans {
         rhs_debit = 0.0;
         rhs_credit = 0.0;
         state = false;
-        document.clear();
+        document = 0;
         support_id = 0;
         discount_price = 0.0;
         unit_price = 0.0;
         settled = 0.0;
     }
+
+    // estimated heap footprint, the struct plus the strings it owns
+    qsizetype Bytes() const noexcept
+    {
+        return qsizetype(sizeof(Trans)) + (date_time.capacity() + code.capacity() + description.capacity()) * qsizetype(sizeof(QChar));
+    }
 };
 
 struct TransShadow {
@@ -76,7 +82,7 @@ struct TransShadow {
     double* lhs_debit {};
     double* lhs_credit {};
     QString* description {};
-    QStringList* document {};
+    int* document {};
     bool* state {};
     double* rhs_credit {};
     double* rhs_debit {};
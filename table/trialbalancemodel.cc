@@ -0,0 +1,82 @@
+#include "trialbalancemodel.h"
+
+#include "component/enumclass.h"
+
+TrialBalanceModel::TrialBalanceModel(const TreeModelFinance* tree, const SqliteFinance* sql, QObject* parent)
+    : QAbstractItemModel { parent }
+    , tree_ { tree }
+    , sql_ { sql }
+    , header_ { tr("Name"), tr("Opening"), tr("Debit"), tr("Credit"), tr("Closing") }
+{
+}
+
+QModelIndex TrialBalanceModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if (!hasIndex(row, column, parent))
+        return QModelIndex();
+
+    return createIndex(row, column);
+}
+
+QModelIndex TrialBalanceModel::parent(const QModelIndex& index) const
+{
+    Q_UNUSED(index);
+    return QModelIndex();
+}
+
+int TrialBalanceModel::rowCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return row_list_.size();
+}
+
+int TrialBalanceModel::columnCount(const QModelIndex& parent) const
+{
+    Q_UNUSED(parent);
+    return header_.size();
+}
+
+QVariant TrialBalanceModel::data(const QModelIndex& index, int role) const
+{
+    if (!index.isValid() || role != Qt::DisplayRole)
+        return QVariant();
+
+    const auto& row { row_list_.at(index.row()) };
+    const TableEnumTrial kColumn { index.column() };
+
+    switch (kColumn) {
+    case TableEnumTrial::kName:
+        return row.node_id == -1 ? tr("Total") : tree_->GetPath(row.node_id);
+    case TableEnumTrial::kOpening:
+        return row.opening;
+    case TableEnumTrial::kDebit:
+        return row.debit;
+    case TableEnumTrial::kCredit:
+        return row.credit;
+    case TableEnumTrial::kClosing:
+        return row.closing;
+    default:
+        return QVariant();
+    }
+}
+
+QVariant TrialBalanceModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+    if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
+        return header_.at(section);
+
+    return QVariant();
+}
+
+void TrialBalanceModel::Query(const QDate& start_date, const QDate& end_date)
+{
+    TrialHash leaf_hash {};
+    sql_->TrialBalance(leaf_hash, start_date, end_date);
+
+    QList<TrialRow> row_list {};
+    tree_->TrialBalance(row_list, leaf_hash);
+
+    beginResetModel();
+    row_list_ = std::move(row_list);
+    endResetModel();
+}
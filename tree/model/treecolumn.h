@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef TREECOLUMN_H
+#define TREECOLUMN_H
+
+#include "component/column.h"
+#include "component/enumclass.h"
+#include "tree/node.h"
+
+// data() stays in each tree model, totals and units read differently for branches, so these tables drive sort only
+using NodeField = ColumnField<Node, int, double, bool, QString>;
+using NodeColumn = ColumnDescriptor<NodeField>;
+
+inline constexpr std::array kTreeFinance {
+    NodeColumn { .field = &Node::name, .sortable = true },
+    NodeColumn { .field = &Node::id },
+    NodeColumn { .field = &Node::code, .sortable = true },
+    NodeColumn { .field = &Node::description, .sortable = true },
+    NodeColumn { .field = &Node::note, .sortable = true },
+    NodeColumn { .field = &Node::rule, .sortable = true },
+    NodeColumn { .field = &Node::type, .sortable = true },
+    NodeColumn { .field = &Node::unit, .sortable = true },
+    NodeColumn { .field = &Node::initial_total, .sortable = true },
+    NodeColumn { .field = &Node::final_total, .sortable = true },
+};
+static_assert(kTreeFinance.size() == std::to_underlying(TreeEnumFinance::kFinalTotal) + 1);
+
+inline constexpr std::array kTreeTask {
+    NodeColumn { .field = &Node::name, .sortable = true },
+    NodeColumn { .field = &Node::id },
+    NodeColumn { .field = &Node::code, .sortable = true },
+    NodeColumn { .field = &Node::description, .sortable = true },
+    NodeColumn { .field = &Node::note, .sortable = true },
+    NodeColumn { .field = &Node::rule, .sortable = true },
+    NodeColumn { .field = &Node::type, .sortable = true },
+    NodeColumn { .field = &Node::unit, .sortable = true },
+    NodeColumn { .field = &Node::date_time, .sortable = true },
+    NodeColumn { .field = &Node::color, .sortable = true },
+    NodeColumn { .field = &Node::document, .sortable = true },
+    NodeColumn { .field = &Node::finished, .sortable = true },
+    NodeColumn { .field = &Node::first, .sortable = true },
+    NodeColumn { .field = &Node::initial_total, .sortable = true },
+    NodeColumn { .field = &Node::final_total, .sortable = true },
+};
+static_assert(kTreeTask.size() == std::to_underlying(TreeEnumTask::kAmount) + 1);
+
+inline constexpr std::array kTreeProduct {
+    NodeColumn { .field = &Node::name, .sortable = true },
+    NodeColumn { .field = &Node::id },
+    NodeColumn { .field = &Node::code, .sortable = true },
+    NodeColumn { .field = &Node::description, .sortable = true },
+    NodeColumn { .field = &Node::note, .sortable = true },
+    NodeColumn { .field = &Node::rule, .sortable = true },
+    NodeColumn { .field = &Node::type, .sortable = true },
+    NodeColumn { .field = &Node::unit, .sortable = true },
+    NodeColumn { .field = &Node::color, .sortable = true },
+    NodeColumn { .field = &Node::first, .sortable = true },
+    NodeColumn { .field = &Node::second, .sortable = true },
+    NodeColumn { .field = &Node::initial_total, .sortable = true },
+    NodeColumn { .field = &Node::final_total, .sortable = true },
+};
+static_assert(kTreeProduct.size() == std::to_underlying(TreeEnumProduct::kAmount) + 1);
+
+inline constexpr std::array kTreeStakeholder {
+    NodeColumn { .field = &Node::name, .sortable = true },
+    NodeColumn { .field = &Node::id },
+    NodeColumn { .field = &Node::code, .sortable = true },
+    NodeColumn { .field = &Node::description, .sortable = true },
+    NodeColumn { .field = &Node::note, .sortable = true },
+    NodeColumn { .field = &Node::rule, .sortable = true },
+    NodeColumn { .field = &Node::type, .sortable = true },
+    NodeColumn { .field = &Node::unit, .sortable = true },
+    NodeColumn { .field = &Node::date_time, .sortable = true },
+    NodeColumn { .field = &Node::employee, .sortable = true },
+    NodeColumn { .field = &Node::first, .sortable = true },
+    NodeColumn { .field = &Node::second, .sortable = true },
+};
+static_assert(kTreeStakeholder.size() == std::to_underlying(TreeEnumStakeholder::kTaxRate) + 1);
+
+inline constexpr std::array kTreeOrder {
+    NodeColumn { .field = &Node::name, .sortable = true },
+    NodeColumn { .field = &Node::id },
+    NodeColumn { .field = &Node::code, .sortable = true },
+    NodeColumn { .field = &Node::description, .sortable = true },
+    NodeColumn { .field = &Node::note, .sortable = true },
+    NodeColumn { .field = &Node::rule, .sortable = true },
+    NodeColumn { .field = &Node::type, .sortable = true },
+    NodeColumn { .field = &Node::unit, .sortable = true },
+    NodeColumn { .field = &Node::party, .sortable = true },
+    NodeColumn { .field = &Node::employee, .sortable = true },
+    NodeColumn { .field = &Node::date_time, .sortable = true },
+    NodeColumn { .field = &Node::first, .sortable = true },
+    NodeColumn { .field = &Node::second, .sortable = true },
+    NodeColumn { .field = &Node::finished, .sortable = true },
+    NodeColumn { .field = &Node::initial_total, .sortable = true },
+    NodeColumn { .field = &Node::discount, .sortable = true },
+    NodeColumn { .field = &Node::final_total, .sortable = true },
+};
+static_assert(kTreeOrder.size() == std::to_underlying(TreeEnumOrder::kSettled) + 1);
+
+#endif // TREECOLUMN_H
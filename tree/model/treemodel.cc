@@ -2,6 +2,8 @@
 
 #include <QQueue>
 
+#include "global/tracer.h"
+
 TreeModel::TreeModel(Sqlite* sql, CInfo& info, int default_unit, CTableHash& table_hash, CString& separator, QObject* parent)
     : QAbstractItemModel(parent)
     , sql_ { sql }
@@ -69,7 +71,7 @@ QMimeData* TreeModel::mimeData(const QModelIndexList& indexes) const
     return mime_data;
 }
 
-QStringList* TreeModel::GetDocumentPointer(const QModelIndex& index) const { return &GetNodeByIndex(index)->document; }
+int* TreeModel::GetDocumentPointer(const QModelIndex& index) const { return &GetNodeByIndex(index)->document; }
 
 QStringList TreeModel::ChildrenNameFPTS(int node_id, int exclude_child) const
 {
@@ -142,16 +144,114 @@ void TreeModel::UpdateSeparatorFPTS(CString& old_separator, CString& new_separat
     TreeModelUtils::UpdateModelSeparatorFPTS(support_model_, support_path_);
 }
 
-void TreeModel::SearchNodeFPTS(QList<const Node*>& node_list, const QList<int>& node_id_list) const
+void TreeModel::SearchNodeFPTS(QList<const Node*>& node_list, CString& text) const
+{
+    const TraceSpan span { "SearchNode", std::to_underlying(info_.section) };
+
+    const auto node_id_list { node_index_.Search(text, node_hash_) };
+    node_list.reserve(node_list.size() + node_id_list.size());
+
+    for (int node_id : node_id_list)
+        node_list.emplaceBack(node_hash_.value(node_id));
+}
+
+void TreeModel::AppendMemoryStat(QList<MemoryStat>& stat_list) const
 {
-    node_list.reserve(node_id_list.size());
+    qsizetype bytes { node_hash_.size() * qsizetype(sizeof(int) + sizeof(Node*)) };
+    for (const auto* node : node_hash_)
+        bytes += node->Bytes();
+
+    stat_list.emplaceBack(MemoryStat { tr("Nodes"), node_hash_.size(), bytes });
+
+    bytes = TreeModelUtils::PathBytes(leaf_path_) + TreeModelUtils::PathBytes(branch_path_) + TreeModelUtils::PathBytes(support_path_);
+    stat_list.emplaceBack(MemoryStat { tr("Paths"), leaf_path_.size() + branch_path_.size() + support_path_.size(), bytes });
+
+    stat_list.emplaceBack(MemoryStat { tr("Node Index"), node_index_.GramCount(), node_index_.Bytes() });
+
+    const qsizetype count { (leaf_model_ ? leaf_model_->rowCount() : 0) + (support_model_ ? support_model_->rowCount() : 0) };
+    bytes = TreeModelUtils::ModelBytes(leaf_model_) + TreeModelUtils::ModelBytes(support_model_);
+    stat_list.emplaceBack(MemoryStat { tr("Path Combo Models"), count, bytes });
+}
 
-    for (int node_id : node_id_list) {
-        auto it { node_hash_.constFind(node_id) };
-        if (it != node_hash_.constEnd() && it.value()) {
-            node_list.emplaceBack(it.value());
+void TreeModel::CheckBranchTotalFPT(QList<IntegrityIssue>& issue_list) const
+{
+    if (info_.section != Section::kFinance && info_.section != Section::kProduct && info_.section != Section::kTask)
+        return;
+
+    const auto branch_hash { BranchTotalFPT() };
+
+    for (auto it = branch_hash.cbegin(); it != branch_hash.cend(); ++it) {
+        const auto* node { node_hash_.value(it.key()) };
+
+        if (std::abs(node->initial_total - it->first) > kTolerance)
+            issue_list.emplaceBack(IntegrityIssue { info_.section, IntegrityKind::kBranchInitial, node->id, 0, node->initial_total, it->first });
+
+        if (std::abs(node->final_total - it->second) > kTolerance)
+            issue_list.emplaceBack(IntegrityIssue { info_.section, IntegrityKind::kBranchFinal, node->id, 0, node->final_total, it->second });
+    }
+}
+
+void TreeModel::RepairTotalFPT(const QHash<int, std::pair<double, double>>& leaf_hash)
+{
+    if (info_.section != Section::kFinance && info_.section != Section::kProduct && info_.section != Section::kTask)
+        return;
+
+    // only values change, the totals are the last two columns of every FPT tree
+    const int final_column { columnCount() - 1 };
+    const int initial_column { final_column - 1 };
+
+    auto Repair = [&](Node* node, const std::pair<double, double>& total) {
+        if (std::abs(node->initial_total - total.first) <= kTolerance && std::abs(node->final_total - total.second) <= kTolerance)
+            return;
+
+        node->initial_total = total.first;
+        node->final_total = total.second;
+
+        const auto index { GetIndex(node->id) };
+        emit dataChanged(index.siblingAtColumn(initial_column), index.siblingAtColumn(final_column), { Qt::DisplayRole });
+    };
+
+    for (auto it = leaf_hash.cbegin(); it != leaf_hash.cend(); ++it) {
+        auto* node { node_hash_.value(it.key()) };
+        if (!node || node->type != kTypeLeaf)
+            continue;
+
+        Repair(node, it.value());
+    }
+
+    const auto branch_hash { BranchTotalFPT() };
+
+    for (auto it = branch_hash.cbegin(); it != branch_hash.cend(); ++it)
+        Repair(node_hash_.value(it.key()), it.value());
+
+    emit SUpdateDSpinBox();
+}
+
+QHash<int, std::pair<double, double>> TreeModel::BranchTotalFPT() const
+{
+    // Same rule as UpdateAncestorValueFPT, applied to whole leaf totals instead of diffs
+    QHash<int, std::pair<double, double>> branch_hash {};
+
+    for (const auto* node : node_hash_) {
+        if (node->type == kTypeBranch)
+            branch_hash.insert(node->id, {});
+    }
+
+    for (const auto* node : node_hash_) {
+        if (node->type != kTypeLeaf)
+            continue;
+
+        for (const Node* current = node->parent; current && current != root_; current = current->parent) {
+            auto& total { branch_hash[current->id] };
+            const int sign { current->rule == node->rule ? 1 : -1 };
+
+            total.second += sign * node->final_total;
+            if (current->unit == node->unit)
+                total.first += sign * node->initial_total;
         }
     }
+
+    return branch_hash;
 }
 
 void TreeModel::SetParent(Node* node, int parent_id) const
@@ -214,6 +314,7 @@ bool TreeModel::UpdateName(Node* node, CString& value)
 
     TreeModelUtils::UpdatePathFPTS(leaf_path_, branch_path_, support_path_, root_, node, separator_);
     TreeModelUtils::UpdateModel(leaf_path_, leaf_model_, support_path_, support_model_, node);
+    node_index_.Update(node);
 
     emit SResizeColumnToContents(std::to_underlying(TreeEnum::kName));
     emit SSearch();
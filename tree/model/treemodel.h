@@ -25,6 +25,7 @@
 
 #include "component/constvalue.h"
 #include "component/enumclass.h"
+#include "tree/nodeindex.h"
 #include "treemodelutils.h"
 
 class TreeModel : public QAbstractItemModel {
@@ -113,11 +114,12 @@ public:
     // Default implementations
     double InitialTotalFPT(int node_id) const { return TreeModelUtils::GetValue(node_hash_, node_id, &Node::initial_total); }
     double FinalTotalFPT(int node_id) const { return TreeModelUtils::GetValue(node_hash_, node_id, &Node::final_total); }
+    double First(int node_id) const { return TreeModelUtils::GetValue(node_hash_, node_id, &Node::first); }
     int TypeFPTS(int node_id) { return TreeModelUtils::GetValue(node_hash_, node_id, &Node::type); }
     int Unit(int node_id) const { return TreeModelUtils::GetValue(node_hash_, node_id, &Node::unit); }
     QString Name(int node_id) const { return TreeModelUtils::GetValue(node_hash_, node_id, &Node::name); }
     bool Rule(int node_id) const { return TreeModelUtils::GetValue(node_hash_, node_id, &Node::rule); }
-    QStringList* GetDocumentPointer(const QModelIndex& index) const;
+    int* GetDocumentPointer(const QModelIndex& index) const;
 
     bool ChildrenEmpty(int node_id) const;
     bool Contains(int node_id) const { return node_hash_.contains(node_id); }
@@ -135,7 +137,13 @@ public:
     void SetNodeShadowOrder(NodeShadow* node_shadow, int node_id) const;
     void SetNodeShadowOrder(NodeShadow* node_shadow, Node* node) const;
 
-    void SearchNodeFPTS(QList<const Node*>& node_list, const QList<int>& node_id_list) const;
+    // served by node_index_, matches name, code, description and note without touching the database
+    void SearchNodeFPTS(QList<const Node*>& node_list, CString& text) const;
+
+    // Finance Product Task, branch totals kept by deltas against a fresh rollup of the leaves
+    void CheckBranchTotalFPT(QList<IntegrityIssue>& issue_list) const;
+    // sets the recomputed leaf totals, then rebuilds every branch total from the leaves
+    void RepairTotalFPT(const QHash<int, std::pair<double, double>>& leaf_hash);
 
     void SetParent(Node* node, int parent_id) const;
     QModelIndex GetIndex(int node_id) const;
@@ -153,6 +161,8 @@ public:
 
     virtual void UpdateDefaultUnit(int default_unit) { root_->unit = default_unit; }
     virtual QString GetPath(int node_id) const;
+    // memory diagnostics, nodes, path hashes, trigram index and the combo models built from the paths
+    virtual void AppendMemoryStat(QList<MemoryStat>& stat_list) const;
 
     // Core pure virtual functions
     virtual bool InsertNode(int row, const QModelIndex& parent, Node* node) = 0;
@@ -160,6 +170,7 @@ public:
 
 protected:
     Node* GetNodeByIndex(const QModelIndex& index) const;
+    QHash<int, std::pair<double, double>> BranchTotalFPT() const;
 
     virtual bool UpdateTypeFPTS(Node* node, int value);
     virtual bool UpdateName(Node* node, CString& value);
@@ -176,6 +187,7 @@ protected:
     StringHash leaf_path_ {};
     StringHash branch_path_ {};
     StringHash support_path_ {};
+    NodeIndex node_index_ {};
 
     QStandardItemModel* support_model_ {};
     QStandardItemModel* leaf_model_ {};
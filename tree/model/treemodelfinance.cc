@@ -1,6 +1,10 @@
 #include "treemodelfinance.h"
 
+#include <QStack>
+
 #include "global/resourcepool.h"
+#include "global/tracer.h"
+#include "treecolumn.h"
 
 TreeModelFinance::TreeModelFinance(Sqlite* sql, CInfo& info, int default_unit, CTableHash& table_hash, CString& separator, QObject* parent)
     : TreeModel(sql, info, default_unit, table_hash, separator, parent)
@@ -34,6 +38,87 @@ void TreeModelFinance::RUpdateLeafValue(
     emit SUpdateDSpinBox();
 }
 
+void TreeModelFinance::TrialBalance(QList<TrialRow>& row_list, const TrialHash& leaf_hash) const
+{
+    row_list.clear();
+    row_list.reserve(node_hash_.size() + 1);
+
+    struct Frame {
+        const Node* node {};
+        qsizetype row {};
+        qsizetype parent_row {};
+        bool visited {};
+    };
+
+    QStack<Frame> stack {};
+    stack.push(Frame { root_, -1, -1, false });
+
+    while (!stack.isEmpty()) {
+        Frame frame { stack.pop() };
+        const Node* node { frame.node };
+
+        if (!frame.visited) {
+            if (node->type == kTypeSupport)
+                continue;
+
+            // reserve the row in tree order, amounts arrive when the node is left
+            frame.row = row_list.size();
+            frame.visited = true;
+            row_list.emplaceBack(TrialRow { node->id, 0.0, 0.0, 0.0, 0.0 });
+            stack.push(frame);
+
+            for (auto it = node->children.crbegin(); it != node->children.crend(); ++it)
+                stack.push(Frame { *it, -1, frame.row, false });
+
+            continue;
+        }
+
+        auto& row { row_list[frame.row] };
+
+        if (node->type == kTypeLeaf) {
+            if (auto it = leaf_hash.constFind(node->id); it != leaf_hash.constEnd()) {
+                row.opening = it->opening;
+                row.debit = it->debit;
+                row.credit = it->credit;
+            }
+        }
+
+        // children are summed as raw credit - debit, the rule is applied once per row
+        if (frame.parent_row != -1) {
+            auto& parent { row_list[frame.parent_row] };
+            parent.opening += row.opening;
+            parent.debit += row.debit;
+            parent.credit += row.credit;
+        }
+
+        const int coefficient { node->rule ? 1 : -1 };
+        row.closing = coefficient * (row.opening + row.credit - row.debit);
+        row.opening = coefficient * row.opening;
+    }
+
+    if (!row_list.isEmpty())
+        row_list.append(row_list.takeFirst());
+}
+
+void TreeModelFinance::Revalue(const QHash<int, std::pair<double, double>>& diff_hash)
+{
+    Node* node {};
+
+    for (auto it = diff_hash.cbegin(); it != diff_hash.cend(); ++it) {
+        node = TreeModelUtils::GetNodeByID(node_hash_, it.key());
+        if (!node || node->type != kTypeLeaf)
+            continue;
+
+        const auto [initial_diff, final_diff] = it.value();
+
+        node->initial_total += initial_diff;
+        node->final_total += final_diff;
+        TreeModelUtils::UpdateAncestorValueFPT(root_, node, initial_diff, final_diff);
+    }
+
+    emit SUpdateDSpinBox();
+}
+
 void TreeModelFinance::RUpdateMultiLeafTotal(const QList<int>& node_list)
 {
     double old_final_total {};
@@ -109,6 +194,7 @@ bool TreeModelFinance::RemoveNode(int row, const QModelIndex& parent)
 
     ResourcePool<Node>::Instance().Recycle(node);
     node_hash_.remove(node_id);
+    node_index_.Remove(node_id);
 
     return true;
 }
@@ -126,6 +212,7 @@ bool TreeModelFinance::InsertNode(int row, const QModelIndex& parent, Node* node
 
     sql_->WriteNode(parent_node->id, node);
     node_hash_.insert(node->id, node);
+    node_index_.Insert(node);
 
     CString path { TreeModelUtils::ConstructPathFPTS(root_, node, separator_) };
 
@@ -174,6 +261,7 @@ void TreeModelFinance::UpdateNodeFPTS(const Node* tmp_node)
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->description, kDescription, &Node::description);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->code, kCode, &Node::code);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->note, kNote, &Node::note);
+    node_index_.Update(node);
 }
 
 void TreeModelFinance::UpdateDefaultUnit(int default_unit)
@@ -241,12 +329,15 @@ bool TreeModelFinance::setData(const QModelIndex& index, const QVariant& value,
     switch (kColumn) {
     case TreeEnumFinance::kCode:
         TreeModelUtils::UpdateField(sql_, node, info_.node, value.toString(), kCode, &Node::code);
+        node_index_.Update(node);
         break;
     case TreeEnumFinance::kDescription:
         TreeModelUtils::UpdateField(sql_, node, info_.node, value.toString(), kDescription, &Node::description);
+        node_index_.Update(node);
         break;
     case TreeEnumFinance::kNote:
         TreeModelUtils::UpdateField(sql_, node, info_.node, value.toString(), kNote, &Node::note);
+        node_index_.Update(node);
         break;
     case TreeEnumFinance::kRule:
         UpdateRuleFPTO(node, value.toBool());
@@ -267,37 +358,16 @@ bool TreeModelFinance::setData(const QModelIndex& index, const QVariant& value,
 
 void TreeModelFinance::sort(int column, Qt::SortOrder order)
 {
+    const TraceSpan span { "TreeSort", std::to_underlying(info_.section) };
+
     if (column <= -1 || column >= info_.tree_header.size())
         return;
 
-    auto Compare = [column, order](const Node* lhs, const Node* rhs) -> bool {
-        const TreeEnumFinance kColumn { column };
-        switch (kColumn) {
-        case TreeEnumFinance::kName:
-            return (order == Qt::AscendingOrder) ? (lhs->name < rhs->name) : (lhs->name > rhs->name);
-        case TreeEnumFinance::kCode:
-            return (order == Qt::AscendingOrder) ? (lhs->code < rhs->code) : (lhs->code > rhs->code);
-        case TreeEnumFinance::kDescription:
-            return (order == Qt::AscendingOrder) ? (lhs->description < rhs->description) : (lhs->description > rhs->description);
-        case TreeEnumFinance::kNote:
-            return (order == Qt::AscendingOrder) ? (lhs->note < rhs->note) : (lhs->note > rhs->note);
-        case TreeEnumFinance::kRule:
-            return (order == Qt::AscendingOrder) ? (lhs->rule < rhs->rule) : (lhs->rule > rhs->rule);
-        case TreeEnumFinance::kType:
-            return (order == Qt::AscendingOrder) ? (lhs->type < rhs->type) : (lhs->type > rhs->type);
-        case TreeEnumFinance::kUnit:
-            return (order == Qt::AscendingOrder) ? (lhs->unit < rhs->unit) : (lhs->unit > rhs->unit);
-        case TreeEnumFinance::kInitialTotal:
-            return (order == Qt::AscendingOrder) ? (lhs->initial_total < rhs->initial_total) : (lhs->initial_total > rhs->initial_total);
-        case TreeEnumFinance::kFinalTotal:
-            return (order == Qt::AscendingOrder) ? (lhs->final_total < rhs->final_total) : (lhs->final_total > rhs->final_total);
-        default:
-            return false;
-        }
-    };
+    if (!ColumnUtils::Sortable(kTreeFinance, column))
+        return;
 
     emit layoutAboutToBeChanged();
-    TreeModelUtils::SortIterative(root_, Compare);
+    ColumnUtils::Sort(kTreeFinance, column, order, [this](auto Compare) { TreeModelUtils::SortIterative(root_, Compare); });
     emit layoutChanged();
 }
 
@@ -370,6 +440,8 @@ bool TreeModelFinance::dropMimeData(const QMimeData* data, Qt::DropAction action
 
 void TreeModelFinance::ConstructTree()
 {
+    const TraceSpan span { "ConstructTree", std::to_underlying(info_.section) };
+
     sql_->ReadNode(node_hash_);
     const auto& const_node_hash { std::as_const(node_hash_) };
 
@@ -383,6 +455,7 @@ void TreeModelFinance::ConstructTree()
     QString path {};
     for (auto* node : const_node_hash) {
         path = TreeModelUtils::ConstructPathFPTS(root_, node, separator_);
+        node_index_.Insert(node);
 
         switch (node->type) {
         case kTypeBranch:
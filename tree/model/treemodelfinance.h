@@ -20,6 +20,7 @@
 #ifndef TREEMODELFINANCE_H
 #define TREEMODELFINANCE_H
 
+#include "database/sqlite/sqlitefinance.h"
 #include "tree/model/treemodel.h"
 
 class TreeModelFinance final : public TreeModel {
@@ -39,6 +40,10 @@ public:
     bool InsertNode(int row, const QModelIndex& parent, Node* node) override;
     void UpdateNodeFPTS(const Node* tmp_node) override;
     void UpdateDefaultUnit(int default_unit) override;
+    // one post-order pass, rows in tree order with each branch summing its children, the root total comes last with node_id -1
+    void TrialBalance(QList<TrialRow>& row_list, const TrialHash& leaf_hash) const;
+    // applies the total changes SqliteFinance::Revalue wrote, node_id -> (initial_total, final_total) change, and moves the ancestors once
+    void Revalue(const QHash<int, std::pair<double, double>>& diff_hash);
 
     QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
     bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
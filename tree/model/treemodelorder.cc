@@ -1,6 +1,8 @@
 #include "treemodelorder.h"
 
 #include "global/resourcepool.h"
+#include "global/tracer.h"
+#include "treecolumn.h"
 
 TreeModelOrder::TreeModelOrder(Sqlite* sql, CInfo& info, int default_unit, CTableHash& table_hash, CString& separator, QObject* parent)
     : TreeModel(sql, info, default_unit, table_hash, separator, parent)
@@ -50,8 +52,10 @@ void TreeModelOrder::RUpdateLeafValue(int node_id, double first_diff, double sec
     auto index { GetIndex(node->id) };
     emit dataChanged(index.siblingAtColumn(std::to_underlying(TreeEnumOrder::kFirst)), index.siblingAtColumn(std::to_underlying(TreeEnumOrder::kSettled)));
 
-    if (node->finished)
+    if (node->finished) {
         UpdateAncestorValueOrder(node, first_diff, second_diff, amount_diff, discount_diff, settled);
+        sql_->UpdateAging(node, amount_diff - discount_diff - settled);
+    }
 }
 
 void TreeModelOrder::RUpdateStakeholder(int old_node_id, int new_node_id)
@@ -78,6 +82,10 @@ void TreeModelOrder::RUpdateFinished(int node_id, bool checked)
     int coefficient = checked ? 1 : -1;
     UpdateAncestorValueOrder(node, coefficient * node->first, coefficient * node->second, coefficient * node->initial_total, coefficient * node->discount,
         coefficient * node->final_total);
+
+    sql_->UpdateReport(node, checked);
+    sql_->UpdateAging(node, coefficient * (node->initial_total - node->discount - node->final_total));
+    emit SUpdateStock(info_.section, node_id, checked);
 }
 
 void TreeModelOrder::UpdateAncestorValueOrder(Node* node, double first_diff, double second_diff, double amount_diff, double discount_diff, double settled_diff)
@@ -235,6 +243,9 @@ bool TreeModelOrder::UpdateFinished(Node* node, bool value)
     node->finished = value;
     emit SUpdateData(node->id, TreeEnumOrder::kFinished, value);
     sql_->UpdateField(info_.node, value, kFinished, node->id);
+    sql_->UpdateReport(node, value);
+    sql_->UpdateAging(node, coefficient * (node->initial_total - node->discount - node->final_total));
+    emit SUpdateStock(info_.section, node->id, value);
     return true;
 }
 
@@ -250,6 +261,8 @@ bool TreeModelOrder::UpdateName(Node* node, CString& value)
 
 void TreeModelOrder::ConstructTree()
 {
+    const TraceSpan span { "ConstructTree", std::to_underlying(info_.section) };
+
     sql_->ReadNode(node_hash_, QDate::currentDate(), QDate::currentDate());
 
     const auto& const_node_hash { std::as_const(node_hash_) };
@@ -268,51 +281,16 @@ void TreeModelOrder::ConstructTree()
 
 void TreeModelOrder::sort(int column, Qt::SortOrder order)
 {
+    const TraceSpan span { "TreeSort", std::to_underlying(info_.section) };
+
     if (column <= -1 || column >= info_.tree_header.size())
         return;
 
-    auto Compare = [column, order](const Node* lhs, const Node* rhs) -> bool {
-        const TreeEnumOrder kColumn { column };
-        switch (kColumn) {
-        case TreeEnumOrder::kName:
-            return (order == Qt::AscendingOrder) ? (lhs->name < rhs->name) : (lhs->name > rhs->name);
-        case TreeEnumOrder::kCode:
-            return (order == Qt::AscendingOrder) ? (lhs->code < rhs->code) : (lhs->code > rhs->code);
-        case TreeEnumOrder::kDescription:
-            return (order == Qt::AscendingOrder) ? (lhs->description < rhs->description) : (lhs->description > rhs->description);
-        case TreeEnumOrder::kNote:
-            return (order == Qt::AscendingOrder) ? (lhs->note < rhs->note) : (lhs->note > rhs->note);
-        case TreeEnumOrder::kRule:
-            return (order == Qt::AscendingOrder) ? (lhs->rule < rhs->rule) : (lhs->rule > rhs->rule);
-        case TreeEnumOrder::kType:
-            return (order == Qt::AscendingOrder) ? (lhs->type < rhs->type) : (lhs->type > rhs->type);
-        case TreeEnumOrder::kUnit:
-            return (order == Qt::AscendingOrder) ? (lhs->unit < rhs->unit) : (lhs->unit > rhs->unit);
-        case TreeEnumOrder::kParty:
-            return (order == Qt::AscendingOrder) ? (lhs->party < rhs->party) : (lhs->party > rhs->party);
-        case TreeEnumOrder::kEmployee:
-            return (order == Qt::AscendingOrder) ? (lhs->employee < rhs->employee) : (lhs->employee > rhs->employee);
-        case TreeEnumOrder::kDateTime:
-            return (order == Qt::AscendingOrder) ? (lhs->date_time < rhs->date_time) : (lhs->date_time > rhs->date_time);
-        case TreeEnumOrder::kFirst:
-            return (order == Qt::AscendingOrder) ? (lhs->first < rhs->first) : (lhs->first > rhs->first);
-        case TreeEnumOrder::kSecond:
-            return (order == Qt::AscendingOrder) ? (lhs->second < rhs->second) : (lhs->second > rhs->second);
-        case TreeEnumOrder::kDiscount:
-            return (order == Qt::AscendingOrder) ? (lhs->discount < rhs->discount) : (lhs->discount > rhs->discount);
-        case TreeEnumOrder::kFinished:
-            return (order == Qt::AscendingOrder) ? (lhs->finished < rhs->finished) : (lhs->finished > rhs->finished);
-        case TreeEnumOrder::kAmount:
-            return (order == Qt::AscendingOrder) ? (lhs->initial_total < rhs->initial_total) : (lhs->initial_total > rhs->initial_total);
-        case TreeEnumOrder::kSettled:
-            return (order == Qt::AscendingOrder) ? (lhs->final_total < rhs->final_total) : (lhs->final_total > rhs->final_total);
-        default:
-            return false;
-        }
-    };
+    if (!ColumnUtils::Sortable(kTreeOrder, column))
+        return;
 
     emit layoutAboutToBeChanged();
-    TreeModelUtils::SortIterative(root_, Compare);
+    ColumnUtils::Sort(kTreeOrder, column, order, [this](auto Compare) { TreeModelUtils::SortIterative(root_, Compare); });
     emit layoutChanged();
 }
 
@@ -359,6 +337,9 @@ bool TreeModelOrder::RemoveNode(int row, const QModelIndex& parent)
     case kTypeLeaf:
         if (node->finished) {
             UpdateAncestorValueOrder(node, -node->first, -node->second, -node->initial_total, -node->discount, -node->final_total);
+            sql_->UpdateReport(node, false);
+            sql_->UpdateAging(node, node->final_total + node->discount - node->initial_total);
+            emit SUpdateStock(info_.section, node->id, false);
         }
         break;
     default:
@@ -536,16 +517,29 @@ bool TreeModelOrder::dropMimeData(const QMimeData* data, Qt::DropAction action,
         } else {
             if (node->finished) {
                 UpdateAncestorValueOrder(node, -node->first, -node->second, -node->initial_total, -node->discount, -node->final_total);
+                sql_->UpdateReport(node, false);
             }
         }
 
+        const int old_unit { node->unit };
+        const double old_final_total { node->final_total };
+
         destination_parent->children.insert(begin_row, node);
         node->unit = destination_parent->unit;
         node->parent = destination_parent;
         node->final_total = node->unit == kUnitIM ? node->initial_total - node->discount : 0.0;
 
-        if (node->finished)
+        // the new unit settles the order again, the stored row, the report and the aging follow it like UpdateUnit and UpdateFinished
+        if (node->type == kTypeLeaf && node->unit != old_unit) {
+            sql_->UpdateField(info_.node, node->unit, kUnit, node->id);
+            sql_->UpdateField(info_.node, node->final_total, kSettled, node->id);
+        }
+
+        if (node->finished) {
             UpdateAncestorValueOrder(node, node->first, node->second, node->initial_total, node->discount, node->final_total);
+            sql_->UpdateReport(node, true);
+            sql_->UpdateAging(node, old_final_total - node->final_total);
+        }
 
         endMoveRows();
     }
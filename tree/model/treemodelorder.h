@@ -34,6 +34,8 @@ public:
 
 signals:
     void SUpdateData(int node_id, TreeEnumOrder column, const QVariant& value);
+    // send to SqliteProduct
+    void SUpdateStock(Section section, int node_id, bool finished);
 
 public slots:
     void RUpdateLeafValueOne(int node_id, double diff, CString& node_field) override; // first
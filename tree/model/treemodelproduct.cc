@@ -1,6 +1,8 @@
 #include "treemodelproduct.h"
 
 #include "global/resourcepool.h"
+#include "global/tracer.h"
+#include "treecolumn.h"
 
 TreeModelProduct::TreeModelProduct(Sqlite* sql, CInfo& info, int default_unit, CTableHash& table_hash, CString& separator, QObject* parent)
     : TreeModel(sql, info, default_unit, table_hash, separator, parent)
@@ -86,6 +88,7 @@ void TreeModelProduct::UpdateNodeFPTS(const Node* tmp_node)
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->description, kDescription, &Node::description);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->code, kCode, &Node::code);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->note, kNote, &Node::note);
+    node_index_.Update(node);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->first, kUnitPrice, &Node::first);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->second, kCommission, &Node::second);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->color, kColor, &Node::color);
@@ -141,6 +144,7 @@ bool TreeModelProduct::RemoveNode(int row, const QModelIndex& parent)
 
     ResourcePool<Node>::Instance().Recycle(node);
     node_hash_.remove(node_id);
+    node_index_.Remove(node_id);
 
     return true;
 }
@@ -158,6 +162,7 @@ bool TreeModelProduct::InsertNode(int row, const QModelIndex& parent, Node* node
 
     sql_->WriteNode(parent_node->id, node);
     node_hash_.insert(node->id, node);
+    node_index_.Insert(node);
 
     QString path { TreeModelUtils::ConstructPathFPTS(root_, node, separator_) };
 
@@ -199,6 +204,12 @@ void TreeModelProduct::UpdateSeparatorFPTS(CString& old_separator, CString& new_
     TreeModelUtils::UpdateModelSeparatorFPTS(product_model_, leaf_path_);
 }
 
+void TreeModelProduct::AppendMemoryStat(QList<MemoryStat>& stat_list) const
+{
+    TreeModel::AppendMemoryStat(stat_list);
+    stat_list.emplaceBack(MemoryStat { tr("Unit Combo Models"), product_model_->rowCount(), TreeModelUtils::ModelBytes(product_model_) });
+}
+
 bool TreeModelProduct::UpdateUnit(Node* node, int value)
 {
     if (node->unit == value)
@@ -232,6 +243,8 @@ bool TreeModelProduct::UpdateUnit(Node* node, int value)
 
 void TreeModelProduct::ConstructTree()
 {
+    const TraceSpan span { "ConstructTree", std::to_underlying(info_.section) };
+
     sql_->ReadNode(node_hash_);
     if (node_hash_.isEmpty())
         return;
@@ -252,6 +265,7 @@ void TreeModelProduct::ConstructTree()
     QString path {};
     for (auto* node : const_node_hash) {
         path = TreeModelUtils::ConstructPathFPTS(root_, node, separator_);
+        node_index_.Insert(node);
 
         switch (node->type) {
         case kTypeBranch:
@@ -282,6 +296,7 @@ bool TreeModelProduct::UpdateName(Node* node, CString& value)
     TreeModelUtils::UpdatePathFPTS(leaf_path_, branch_path_, support_path_, root_, node, separator_);
     TreeModelUtils::UpdateModel(leaf_path_, leaf_model_, support_path_, support_model_, node);
     TreeModelUtils::UpdateUnitModel(leaf_path_, product_model_, node, kUnitPos, Filter::kExcludeSpecific);
+    node_index_.Update(node);
 
     emit SResizeColumnToContents(std::to_underlying(TreeEnum::kName));
     emit SSearch();
@@ -290,43 +305,16 @@ bool TreeModelProduct::UpdateName(Node* node, CString& value)
 
 void TreeModelProduct::sort(int column, Qt::SortOrder order)
 {
+    const TraceSpan span { "TreeSort", std::to_underlying(info_.section) };
+
     if (column <= -1 || column >= info_.tree_header.size())
         return;
 
-    auto Compare = [column, order](const Node* lhs, const Node* rhs) -> bool {
-        const TreeEnumProduct kColumn { column };
-        switch (kColumn) {
-        case TreeEnumProduct::kName:
-            return (order == Qt::AscendingOrder) ? (lhs->name < rhs->name) : (lhs->name > rhs->name);
-        case TreeEnumProduct::kCode:
-            return (order == Qt::AscendingOrder) ? (lhs->code < rhs->code) : (lhs->code > rhs->code);
-        case TreeEnumProduct::kDescription:
-            return (order == Qt::AscendingOrder) ? (lhs->description < rhs->description) : (lhs->description > rhs->description);
-        case TreeEnumProduct::kNote:
-            return (order == Qt::AscendingOrder) ? (lhs->note < rhs->note) : (lhs->note > rhs->note);
-        case TreeEnumProduct::kRule:
-            return (order == Qt::AscendingOrder) ? (lhs->rule < rhs->rule) : (lhs->rule > rhs->rule);
-        case TreeEnumProduct::kType:
-            return (order == Qt::AscendingOrder) ? (lhs->type < rhs->type) : (lhs->type > rhs->type);
-        case TreeEnumProduct::kUnit:
-            return (order == Qt::AscendingOrder) ? (lhs->unit < rhs->unit) : (lhs->unit > rhs->unit);
-        case TreeEnumProduct::kColor:
-            return (order == Qt::AscendingOrder) ? (lhs->color < rhs->color) : (lhs->color > rhs->color);
-        case TreeEnumProduct::kCommission:
-            return (order == Qt::AscendingOrder) ? (lhs->second < rhs->second) : (lhs->second > rhs->second);
-        case TreeEnumProduct::kUnitPrice:
-            return (order == Qt::AscendingOrder) ? (lhs->first < rhs->first) : (lhs->first > rhs->first);
-        case TreeEnumProduct::kQuantity:
-            return (order == Qt::AscendingOrder) ? (lhs->initial_total < rhs->initial_total) : (lhs->initial_total > rhs->initial_total);
-        case TreeEnumProduct::kAmount:
-            return (order == Qt::AscendingOrder) ? (lhs->final_total < rhs->final_total) : (lhs->final_total > rhs->final_total);
-        default:
-            return false;
-        }
-    };
+    if (!ColumnUtils::Sortable(kTreeProduct, column))
+        return;
 
     emit layoutAboutToBeChanged();
-    TreeModelUtils::SortIterative(root_, Compare);
+    ColumnUtils::Sort(kTreeProduct, column, order, [this](auto Compare) { TreeModelUtils::SortIterative(root_, Compare); });
     emit layoutChanged();
 }
 
@@ -387,12 +375,15 @@ bool TreeModelProduct::setData(const QModelIndex& index, const QVariant& value,
     switch (kColumn) {
     case TreeEnumProduct::kCode:
         TreeModelUtils::UpdateField(sql_, node, info_.node, value.toString(), kCode, &Node::code);
+        node_index_.Update(node);
         break;
     case TreeEnumProduct::kDescription:
         TreeModelUtils::UpdateField(sql_, node, info_.node, value.toString(), kDescription, &Node::description);
+        node_index_.Update(node);
         break;
     case TreeEnumProduct::kNote:
         TreeModelUtils::UpdateField(sql_, node, info_.node, value.toString(), kNote, &Node::note);
+        node_index_.Update(node);
         break;
     case TreeEnumProduct::kRule:
         UpdateRuleFPTO(node, value.toBool());
@@ -54,6 +54,7 @@ public:
         Q_UNUSED(unit);
         return product_model_;
     }
+    void AppendMemoryStat(QList<MemoryStat>& stat_list) const override;
 
 protected:
     void ConstructTree() override;
@@ -1,6 +1,8 @@
 #include "treemodelstakeholder.h"
 
 #include "global/resourcepool.h"
+#include "global/tracer.h"
+#include "treecolumn.h"
 
 TreeModelStakeholder::TreeModelStakeholder(Sqlite* sql, CInfo& info, int default_unit, CTableHash& table_hash, CString& separator, QObject* parent)
     : TreeModel(sql, info, default_unit, table_hash, separator, parent)
@@ -43,6 +45,7 @@ void TreeModelStakeholder::UpdateNodeFPTS(const Node* tmp_node)
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->description, kDescription, &Node::description);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->code, kCode, &Node::code);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->note, kNote, &Node::note);
+    node_index_.Update(node);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->first, kPaymentTerm, &Node::first);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->second, kTaxRate, &Node::second);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->date_time, kDeadline, &Node::date_time);
@@ -64,6 +67,7 @@ bool TreeModelStakeholder::InsertNode(int row, const QModelIndex& parent, Node*
 
     sql_->WriteNode(parent_node->id, node);
     node_hash_.insert(node->id, node);
+    node_index_.Insert(node);
 
     QString path { TreeModelUtils::ConstructPathFPTS(root_, node, separator_) };
 
@@ -140,6 +144,15 @@ void TreeModelStakeholder::UpdateSeparatorFPTS(CString& old_separator, CString&
     TreeModelUtils::UpdateModelSeparatorFPTS(emodel_, leaf_path_);
 }
 
+void TreeModelStakeholder::AppendMemoryStat(QList<MemoryStat>& stat_list) const
+{
+    TreeModel::AppendMemoryStat(stat_list);
+
+    const qsizetype count { cmodel_->rowCount() + vmodel_->rowCount() + emodel_->rowCount() };
+    const qsizetype bytes { TreeModelUtils::ModelBytes(cmodel_) + TreeModelUtils::ModelBytes(vmodel_) + TreeModelUtils::ModelBytes(emodel_) };
+    stat_list.emplaceBack(MemoryStat { tr("Unit Combo Models"), count, bytes });
+}
+
 bool TreeModelStakeholder::UpdateUnit(Node* node, int value)
 {
     if (node->unit == value)
@@ -183,6 +196,7 @@ bool TreeModelStakeholder::UpdateName(Node* node, CString& value)
     TreeModelUtils::UpdateUnitModel(leaf_path_, cmodel_, node, kUnitCust, Filter::kIncludeSpecific);
     TreeModelUtils::UpdateUnitModel(leaf_path_, vmodel_, node, kUnitVend, Filter::kIncludeSpecific);
     TreeModelUtils::UpdateUnitModel(leaf_path_, emodel_, node, kUnitEmp, Filter::kIncludeSpecific);
+    node_index_.Update(node);
 
     emit SResizeColumnToContents(std::to_underlying(TreeEnum::kName));
     emit SSearch();
@@ -225,6 +239,8 @@ void TreeModelStakeholder::AddItem(int node_id, CString& path, int unit)
 
 void TreeModelStakeholder::ConstructTree()
 {
+    const TraceSpan span { "ConstructTree", std::to_underlying(info_.section) };
+
     sql_->ReadNode(node_hash_);
     const auto& const_node_hash { std::as_const(node_hash_) };
     QSet<int> crange {};
@@ -255,6 +271,7 @@ void TreeModelStakeholder::ConstructTree()
     QString path {};
     for (auto* node : const_node_hash) {
         path = TreeModelUtils::ConstructPathFPTS(root_, node, separator_);
+        node_index_.Insert(node);
 
         switch (node->type) {
         case kTypeBranch:
@@ -335,41 +352,16 @@ bool TreeModelStakeholder::UpdateTypeFPTS(Node* node, int value)
 
 void TreeModelStakeholder::sort(int column, Qt::SortOrder order)
 {
+    const TraceSpan span { "TreeSort", std::to_underlying(info_.section) };
+
     if (column <= -1 || column >= info_.tree_header.size())
         return;
 
-    auto Compare = [column, order](const Node* lhs, const Node* rhs) -> bool {
-        const TreeEnumStakeholder kColumn { column };
-        switch (kColumn) {
-        case TreeEnumStakeholder::kName:
-            return (order == Qt::AscendingOrder) ? (lhs->name < rhs->name) : (lhs->name > rhs->name);
-        case TreeEnumStakeholder::kCode:
-            return (order == Qt::AscendingOrder) ? (lhs->code < rhs->code) : (lhs->code > rhs->code);
-        case TreeEnumStakeholder::kDescription:
-            return (order == Qt::AscendingOrder) ? (lhs->description < rhs->description) : (lhs->description > rhs->description);
-        case TreeEnumStakeholder::kNote:
-            return (order == Qt::AscendingOrder) ? (lhs->note < rhs->note) : (lhs->note > rhs->note);
-        case TreeEnumStakeholder::kRule:
-            return (order == Qt::AscendingOrder) ? (lhs->rule < rhs->rule) : (lhs->rule > rhs->rule);
-        case TreeEnumStakeholder::kType:
-            return (order == Qt::AscendingOrder) ? (lhs->type < rhs->type) : (lhs->type > rhs->type);
-        case TreeEnumStakeholder::kUnit:
-            return (order == Qt::AscendingOrder) ? (lhs->unit < rhs->unit) : (lhs->unit > rhs->unit);
-        case TreeEnumStakeholder::kDeadline:
-            return (order == Qt::AscendingOrder) ? (lhs->date_time < rhs->date_time) : (lhs->date_time > rhs->date_time);
-        case TreeEnumStakeholder::kEmployee:
-            return (order == Qt::AscendingOrder) ? (lhs->employee < rhs->employee) : (lhs->employee > rhs->employee);
-        case TreeEnumStakeholder::kPaymentTerm:
-            return (order == Qt::AscendingOrder) ? (lhs->first < rhs->first) : (lhs->first > rhs->first);
-        case TreeEnumStakeholder::kTaxRate:
-            return (order == Qt::AscendingOrder) ? (lhs->second < rhs->second) : (lhs->second > rhs->second);
-        default:
-            return false;
-        }
-    };
+    if (!ColumnUtils::Sortable(kTreeStakeholder, column))
+        return;
 
     emit layoutAboutToBeChanged();
-    TreeModelUtils::SortIterative(root_, Compare);
+    ColumnUtils::Sort(kTreeStakeholder, column, order, [this](auto Compare) { TreeModelUtils::SortIterative(root_, Compare); });
     emit layoutChanged();
 }
 
@@ -418,6 +410,7 @@ bool TreeModelStakeholder::RemoveNode(int row, const QModelIndex& parent)
 
     ResourcePool<Node>::Instance().Recycle(node);
     node_hash_.remove(node_id);
+    node_index_.Remove(node_id);
 
     return true;
 }
@@ -478,12 +471,15 @@ bool TreeModelStakeholder::setData(const QModelIndex& index, const QVariant& val
     switch (kColumn) {
     case TreeEnumStakeholder::kCode:
         TreeModelUtils::UpdateField(sql_, node, info_.node, value.toString(), kCode, &Node::code);
+        node_index_.Update(node);
         break;
     case TreeEnumStakeholder::kDescription:
         TreeModelUtils::UpdateField(sql_, node, info_.node, value.toString(), kDescription, &Node::description);
+        node_index_.Update(node);
         break;
     case TreeEnumStakeholder::kNote:
         TreeModelUtils::UpdateField(sql_, node, info_.node, value.toString(), kNote, &Node::note);
+        node_index_.Update(node);
         break;
     case TreeEnumStakeholder::kRule:
         TreeModelUtils::UpdateField(sql_, node, info_.node, value.toBool(), kRule, &Node::rule);
@@ -47,6 +47,7 @@ public:
     QList<int> PartyList(CString& text, int unit) const;
     QStandardItemModel* UnitModelPS(int unit) const override;
     void UpdateSeparatorFPTS(CString& old_separator, CString& new_separator) override;
+    void AppendMemoryStat(QList<MemoryStat>& stat_list) const override;
 
 protected:
     void ConstructTree() override;
@@ -1,6 +1,8 @@
 #include "treemodeltask.h"
 
 #include "global/resourcepool.h"
+#include "global/tracer.h"
+#include "treecolumn.h"
 
 TreeModelTask::TreeModelTask(Sqlite* sql, CInfo& info, int default_unit, CTableHash& table_hash, CString& separator, QObject* parent)
     : TreeModel(sql, info, default_unit, table_hash, separator, parent)
@@ -114,7 +116,7 @@ QVariant TreeModelTask::data(const QModelIndex& index, int role) const
     case TreeEnumTask::kQuantity:
         return node->initial_total == 0 ? QVariant() : node->initial_total;
     case TreeEnumTask::kDocument:
-        return node->document.isEmpty() ? QVariant() : node->document.size();
+        return node->document == 0 ? QVariant() : node->document;
     case TreeEnumTask::kAmount:
         return node->final_total;
     default:
@@ -136,12 +138,15 @@ bool TreeModelTask::setData(const QModelIndex& index, const QVariant& value, int
     switch (kColumn) {
     case TreeEnumTask::kCode:
         TreeModelUtils::UpdateField(sql_, node, info_.node, value.toString(), kCode, &Node::code);
+        node_index_.Update(node);
         break;
     case TreeEnumTask::kDescription:
         TreeModelUtils::UpdateField(sql_, node, info_.node, value.toString(), kDescription, &Node::description);
+        node_index_.Update(node);
         break;
     case TreeEnumTask::kNote:
         TreeModelUtils::UpdateField(sql_, node, info_.node, value.toString(), kNote, &Node::note);
+        node_index_.Update(node);
         break;
     case TreeEnumTask::kRule:
         UpdateRuleFPTO(node, value.toBool());
@@ -176,47 +181,16 @@ bool TreeModelTask::setData(const QModelIndex& index, const QVariant& value, int
 
 void TreeModelTask::sort(int column, Qt::SortOrder order)
 {
+    const TraceSpan span { "TreeSort", std::to_underlying(info_.section) };
+
     if (column <= -1 || column >= info_.tree_header.size())
         return;
 
-    auto Compare = [column, order](const Node* lhs, const Node* rhs) -> bool {
-        const TreeEnumTask kColumn { column };
-        switch (kColumn) {
-        case TreeEnumTask::kName:
-            return (order == Qt::AscendingOrder) ? (lhs->name < rhs->name) : (lhs->name > rhs->name);
-        case TreeEnumTask::kCode:
-            return (order == Qt::AscendingOrder) ? (lhs->code < rhs->code) : (lhs->code > rhs->code);
-        case TreeEnumTask::kDescription:
-            return (order == Qt::AscendingOrder) ? (lhs->description < rhs->description) : (lhs->description > rhs->description);
-        case TreeEnumTask::kNote:
-            return (order == Qt::AscendingOrder) ? (lhs->note < rhs->note) : (lhs->note > rhs->note);
-        case TreeEnumTask::kRule:
-            return (order == Qt::AscendingOrder) ? (lhs->rule < rhs->rule) : (lhs->rule > rhs->rule);
-        case TreeEnumTask::kType:
-            return (order == Qt::AscendingOrder) ? (lhs->type < rhs->type) : (lhs->type > rhs->type);
-        case TreeEnumTask::kFinished:
-            return (order == Qt::AscendingOrder) ? (lhs->finished < rhs->finished) : (lhs->finished > rhs->finished);
-        case TreeEnumTask::kUnit:
-            return (order == Qt::AscendingOrder) ? (lhs->unit < rhs->unit) : (lhs->unit > rhs->unit);
-        case TreeEnumTask::kColor:
-            return (order == Qt::AscendingOrder) ? (lhs->color < rhs->color) : (lhs->color > rhs->color);
-        case TreeEnumTask::kDocument:
-            return (order == Qt::AscendingOrder) ? (lhs->document.size() < rhs->document.size()) : (lhs->document.size() > rhs->document.size());
-        case TreeEnumTask::kDateTime:
-            return (order == Qt::AscendingOrder) ? (lhs->date_time < rhs->date_time) : (lhs->date_time > rhs->date_time);
-        case TreeEnumTask::kUnitCost:
-            return (order == Qt::AscendingOrder) ? (lhs->first < rhs->first) : (lhs->first > rhs->first);
-        case TreeEnumTask::kQuantity:
-            return (order == Qt::AscendingOrder) ? (lhs->initial_total < rhs->initial_total) : (lhs->initial_total > rhs->initial_total);
-        case TreeEnumTask::kAmount:
-            return (order == Qt::AscendingOrder) ? (lhs->final_total < rhs->final_total) : (lhs->final_total > rhs->final_total);
-        default:
-            return false;
-        }
-    };
+    if (!ColumnUtils::Sortable(kTreeTask, column))
+        return;
 
     emit layoutAboutToBeChanged();
-    TreeModelUtils::SortIterative(root_, Compare);
+    ColumnUtils::Sort(kTreeTask, column, order, [this](auto Compare) { TreeModelUtils::SortIterative(root_, Compare); });
     emit layoutChanged();
 }
 
@@ -316,6 +290,7 @@ void TreeModelTask::UpdateNodeFPTS(const Node* tmp_node)
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->description, kDescription, &Node::description);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->code, kCode, &Node::code);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->note, kNote, &Node::note);
+    node_index_.Update(node);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->color, kColor, &Node::color);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->date_time, kDateTime, &Node::date_time);
     TreeModelUtils::UpdateField(sql_, node, info_.node, tmp_node->finished, kFinished, &Node::finished);
@@ -367,6 +342,7 @@ bool TreeModelTask::RemoveNode(int row, const QModelIndex& parent)
 
     ResourcePool<Node>::Instance().Recycle(node);
     node_hash_.remove(node_id);
+    node_index_.Remove(node_id);
 
     return true;
 }
@@ -384,6 +360,7 @@ bool TreeModelTask::InsertNode(int row, const QModelIndex& parent, Node* node)
 
     sql_->WriteNode(parent_node->id, node);
     node_hash_.insert(node->id, node);
+    node_index_.Insert(node);
 
     QString path { TreeModelUtils::ConstructPathFPTS(root_, node, separator_) };
 
@@ -432,6 +409,8 @@ bool TreeModelTask::UpdateUnit(Node* node, int value)
 
 void TreeModelTask::ConstructTree()
 {
+    const TraceSpan span { "ConstructTree", std::to_underlying(info_.section) };
+
     sql_->ReadNode(node_hash_);
     const auto& const_node_hash { std::as_const(node_hash_) };
 
@@ -445,6 +424,7 @@ void TreeModelTask::ConstructTree()
     QString path {};
     for (auto* node : const_node_hash) {
         path = TreeModelUtils::ConstructPathFPTS(root_, node, separator_);
+        node_index_.Insert(node);
 
         switch (node->type) {
         case kTypeBranch:
@@ -105,29 +105,6 @@ bool TreeModelUtils::IsDescendant(Node* lhs, Node* rhs)
     return lhs == rhs;
 }
 
-void TreeModelUtils::SortIterative(Node* node, std::function<bool(const Node*, const Node*)> Compare)
-{
-    if (!node)
-        return;
-
-    QQueue<Node*> queue {};
-    queue.enqueue(node);
-
-    Node* current {};
-
-    while (!queue.isEmpty()) {
-        current = queue.dequeue();
-
-        if (current->children.isEmpty())
-            continue;
-
-        std::sort(current->children.begin(), current->children.end(), Compare);
-        for (auto* child : current->children) {
-            queue.enqueue(child);
-        }
-    }
-}
-
 QString TreeModelUtils::ConstructPathFPTS(const Node* root, const Node* node, CString& separator)
 {
     if (!node || node == root)
@@ -589,3 +566,28 @@ void TreeModelUtils::UpdateAncestorValueFPT(const Node* root, Node* node, double
         }
     }
 }
+
+qsizetype TreeModelUtils::PathBytes(CStringHash& path)
+{
+    qsizetype bytes { path.size() * qsizetype(sizeof(int) + sizeof(QString)) };
+    for (const auto& string : path)
+        bytes += string.capacity() * qsizetype(sizeof(QChar));
+
+    return bytes;
+}
+
+qsizetype TreeModelUtils::ModelBytes(const QStandardItemModel* model)
+{
+    if (!model)
+        return 0;
+
+    // every item carries its path as DisplayRole and the node id as UserRole
+    constexpr qsizetype item_bytes { sizeof(QStandardItem) + 2 * (sizeof(int) + sizeof(QVariant)) };
+    qsizetype bytes { model->rowCount() * item_bytes };
+
+    for (int row = 0; row != model->rowCount(); ++row)
+        if (const auto* item { model->item(row) })
+            bytes += item->text().size() * qsizetype(sizeof(QChar));
+
+    return bytes;
+}
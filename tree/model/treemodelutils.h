@@ -20,6 +20,7 @@
 #ifndef TREEMODELUTILS_H
 #define TREEMODELUTILS_H
 
+#include <QQueue>
 #include <QStandardItemModel>
 
 #include "component/using.h"
@@ -49,6 +50,30 @@ public:
         return true;
     }
 
+    // Compare stays a template so a column comparator inlines into std::sort
+    template <typename Compare> static void SortIterative(Node* node, Compare compare)
+    {
+        if (!node)
+            return;
+
+        QQueue<Node*> queue {};
+        queue.enqueue(node);
+
+        Node* current {};
+
+        while (!queue.isEmpty()) {
+            current = queue.dequeue();
+
+            if (current->children.isEmpty())
+                continue;
+
+            std::sort(current->children.begin(), current->children.end(), compare);
+            for (auto* child : current->children) {
+                queue.enqueue(child);
+            }
+        }
+    }
+
     template <typename T> static const T& GetValue(CNodeHash& hash, int node_id, T Node::* member)
     {
         if (auto it = hash.constFind(node_id); it != hash.constEnd())
@@ -69,7 +94,6 @@ public:
     static Node* GetNodeByID(CNodeHash& hash, int node_id);
     static bool IsDescendant(Node* lhs, Node* rhs);
 
-    static void SortIterative(Node* node, std::function<bool(const Node*, const Node*)> Compare);
     static void UpdateComboModel(QStandardItemModel* model, const QVector<std::pair<QString, int>>& items);
 
     static QString ConstructPathFPTS(const Node* root, const Node* node, CString& separator);
@@ -91,6 +115,10 @@ public:
     static void UpdatePathSeparatorFPTS(CString& old_separator, CString& new_separator, StringHash& source_path);
     static void UpdateModelSeparatorFPTS(QStandardItemModel* model, CStringHash& source_path);
 
+    // memory diagnostics, estimated from sizes and string capacities
+    static qsizetype PathBytes(CStringHash& path);
+    static qsizetype ModelBytes(const QStandardItemModel* model);
+
     static bool HasChildrenFPTS(Node* node, CString& message);
     static bool IsOpenedFPTS(CTableHash& hash, int node_id, CString& message);
 
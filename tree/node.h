@@ -37,6 +37,8 @@ struct Node {
     bool operator==(const Node& other) const noexcept;
     bool operator!=(const Node& other) const noexcept { return !(*this == other); }
     void Reset();
+    // estimated heap footprint, the struct plus the strings and child list it owns
+    qsizetype Bytes() const noexcept;
 
     Node(Node&&) noexcept = delete;
     Node& operator=(Node&&) noexcept = delete;
@@ -48,7 +50,7 @@ struct Node {
     QString note {};
     QString date_time {};
     QString color {};
-    QStringList document {};
+    int document {}; // rows in the document table, the paths are read only when edited
     bool rule { false };
     int type {};
     int unit {};
@@ -153,7 +155,7 @@ inline void Node::Reset()
     description.clear();
     note.clear();
     color.clear();
-    document.clear();
+    document = 0;
     rule = false;
     type = 0;
     unit = 0;
@@ -163,6 +165,12 @@ inline void Node::Reset()
     children.clear();
 }
 
+inline qsizetype Node::Bytes() const noexcept
+{
+    const qsizetype chars { name.capacity() + code.capacity() + description.capacity() + note.capacity() + date_time.capacity() + color.capacity() };
+    return qsizetype(sizeof(Node)) + chars * qsizetype(sizeof(QChar)) + children.capacity() * qsizetype(sizeof(Node*));
+}
+
 struct NodeShadow {
     void Reset();
     void Set(Node* node);
@@ -183,7 +191,7 @@ struct NodeShadow {
 
     QString* date_time {};
     QString* color {};
-    QStringList* document {};
+    int* document {};
     int* employee {};
     int* party {};
 
@@ -0,0 +1,123 @@
+#include "nodeindex.h"
+
+void NodeIndex::Insert(const Node* node)
+{
+    if (!node)
+        return;
+
+    QSet<Gram> gram_set {};
+    AppendGram(gram_set, node->name);
+    AppendGram(gram_set, node->code);
+    AppendGram(gram_set, node->description);
+    AppendGram(gram_set, node->note);
+
+    const int node_id { node->id };
+
+    for (Gram gram : std::as_const(gram_set))
+        posting_hash_[gram].insert(node_id);
+
+    node_gram_hash_.insert(node_id, gram_set.values());
+}
+
+void NodeIndex::Remove(int node_id)
+{
+    auto it { node_gram_hash_.constFind(node_id) };
+    if (it == node_gram_hash_.constEnd())
+        return;
+
+    for (Gram gram : it.value()) {
+        auto posting { posting_hash_.find(gram) };
+        if (posting == posting_hash_.end())
+            continue;
+
+        posting->remove(node_id);
+        if (posting->isEmpty())
+            posting_hash_.erase(posting);
+    }
+
+    node_gram_hash_.erase(it);
+}
+
+void NodeIndex::Update(const Node* node)
+{
+    if (!node)
+        return;
+
+    Remove(node->id);
+    Insert(node);
+}
+
+void NodeIndex::Clear()
+{
+    posting_hash_.clear();
+    node_gram_hash_.clear();
+}
+
+QList<int> NodeIndex::Search(CString& text, const NodeHash& node_hash) const
+{
+    QList<int> node_id_list {};
+
+    if (text.isEmpty()) {
+        node_id_list = node_hash.keys();
+    } else if (text.size() < kGramSize) {
+        for (auto* node : node_hash)
+            if (Contains(node, text))
+                node_id_list.emplaceBack(node->id);
+    } else {
+        QSet<Gram> gram_set {};
+        AppendGram(gram_set, text);
+
+        // every gram of text must be indexed, the shortest posting holds the candidates
+        const QSet<int>* candidate {};
+
+        for (Gram gram : std::as_const(gram_set)) {
+            auto it { posting_hash_.constFind(gram) };
+            if (it == posting_hash_.constEnd())
+                return {};
+
+            if (!candidate || it->size() < candidate->size())
+                candidate = &it.value();
+        }
+
+        // grams can match out of order, so each candidate is confirmed against its fields
+        for (int node_id : *candidate) {
+            auto* node { node_hash.value(node_id) };
+            if (node && Contains(node, text))
+                node_id_list.emplaceBack(node_id);
+        }
+    }
+
+    std::sort(node_id_list.begin(), node_id_list.end());
+    return node_id_list;
+}
+
+qsizetype NodeIndex::Bytes() const
+{
+    qsizetype bytes { posting_hash_.size() * qsizetype(sizeof(Gram) + sizeof(QSet<int>)) };
+    for (const auto& posting : posting_hash_)
+        bytes += posting.size() * qsizetype(sizeof(int));
+
+    bytes += node_gram_hash_.size() * qsizetype(sizeof(int) + sizeof(QList<Gram>));
+    for (const auto& gram_list : node_gram_hash_)
+        bytes += gram_list.capacity() * qsizetype(sizeof(Gram));
+
+    return bytes;
+}
+
+void NodeIndex::AppendGram(QSet<Gram>& gram_set, CString& text) const
+{
+    if (text.size() < kGramSize)
+        return;
+
+    CString folded { text.toCaseFolded() };
+    const auto* data { folded.utf16() };
+
+    for (qsizetype index = 0; index + kGramSize <= folded.size(); ++index)
+        gram_set.insert(Gram(data[index]) << 32 | Gram(data[index + 1]) << 16 | Gram(data[index + 2]));
+}
+
+bool NodeIndex::Contains(const Node* node, CString& text) const
+{
+    return node->name.contains(text, Qt::CaseInsensitive) || node->code.contains(text, Qt::CaseInsensitive)
+        || node->description.contains(text, Qt::CaseInsensitive) || node->note.contains(text, Qt::CaseInsensitive);
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2023 YtxErp
+ *
+ * This file is part of YTX.
+ *
+ * YTX is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * YTX is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with YTX. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef NODEINDEX_H
+#define NODEINDEX_H
+
+#include <QHash>
+#include <QSet>
+
+#include "component/using.h"
+#include "tree/node.h"
+
+// Trigram index over node name, code, description and note, case folded, lets node search stay off the database
+class NodeIndex {
+public:
+    void Insert(const Node* node);
+    void Remove(int node_id);
+    void Update(const Node* node);
+    void Clear();
+
+    // ids of nodes containing text in any indexed field ignoring case, empty text matches every node,
+    // text shorter than a trigram is checked against each node
+    QList<int> Search(CString& text, const NodeHash& node_hash) const;
+
+    qsizetype GramCount() const { return posting_hash_.size(); }
+    // estimated, the posting sets plus each node's gram list
+    qsizetype Bytes() const;
+
+private:
+    using Gram = quint64;
+
+    void AppendGram(QSet<Gram>& gram_set, CString& text) const;
+    bool Contains(const Node* node, CString& text) const;
+
+private:
+    static constexpr qsizetype kGramSize = 3;
+
+    QHash<Gram, QSet<int>> posting_hash_ {};
+    QHash<int, QList<Gram>> node_gram_hash_ {};
+};
+
+#endif // NODEINDEX_H
@@ -1,5 +1,7 @@
 #include "tablewidgetfpts.h"
 
+#include <QHeaderView>
+
 #include "ui_tablewidgetfpts.h"
 
 TableWidgetFPTS::TableWidgetFPTS(TableModel* model, QWidget* parent)
@@ -14,3 +16,68 @@ TableWidgetFPTS::TableWidgetFPTS(TableModel* model, QWidget* parent)
 TableWidgetFPTS::~TableWidgetFPTS() { delete ui; }
 
 QPointer<QTableView> TableWidgetFPTS::View() const { return ui->tableView; }
+
+DateWindow TableWidgetFPTS::CurrentQuarterFPT()
+{
+    const QDate kToday { QDate::currentDate() };
+    const QDate kQuarterStart { kToday.year(), (kToday.month() - 1) / 3 * 3 + 1, 1 };
+
+    return DateWindow { kQuarterStart, kQuarterStart.addMonths(3).addDays(-1) };
+}
+
+void TableWidgetFPTS::ShowDateWindowFPT()
+{
+    // the model has already read its window, the bar only mirrors it
+    const DateWindow& window { model_->Window() };
+    const bool kWindow { window.start_date.isValid() };
+    const DateWindow kShown { kWindow ? window : CurrentQuarterFPT() };
+
+    ui->dateEditStart->setDate(kShown.start_date);
+    ui->dateEditEnd->setDate(kShown.end_date);
+    ui->dateEditStart->setEnabled(kWindow);
+    ui->dateEditEnd->setEnabled(kWindow);
+
+    {
+        const QSignalBlocker blocker(ui->chkBoxWindow);
+        ui->chkBoxWindow->setChecked(kWindow);
+    }
+
+    ROpeningBalance(model_->OpeningBalance());
+
+    connect(ui->dateEditStart, &QDateEdit::editingFinished, this, &TableWidgetFPTS::RDateWindowChanged);
+    connect(ui->dateEditEnd, &QDateEdit::editingFinished, this, &TableWidgetFPTS::RDateWindowChanged);
+    connect(model_, &TableModel::SOpeningBalance, this, &TableWidgetFPTS::ROpeningBalance);
+
+    ui->widgetWindow->setVisible(true);
+}
+
+void TableWidgetFPTS::on_chkBoxWindow_toggled(bool checked)
+{
+    ui->dateEditStart->setEnabled(checked);
+    ui->dateEditEnd->setEnabled(checked);
+    UpdateDateWindow();
+}
+
+void TableWidgetFPTS::RDateWindowChanged()
+{
+    if (ui->chkBoxWindow->isChecked())
+        UpdateDateWindow();
+}
+
+void TableWidgetFPTS::ROpeningBalance(double opening_balance)
+{
+    ui->labelOpening->setText(
+        ui->chkBoxWindow->isChecked() ? tr("Opening Balance: %1").arg(QLocale().toString(opening_balance, 'f', 2)) : QString());
+}
+
+void TableWidgetFPTS::UpdateDateWindow()
+{
+    if (ui->chkBoxWindow->isChecked())
+        model_->SetDateWindowFPT(DateWindow { ui->dateEditStart->date(), ui->dateEditEnd->date() });
+    else
+        model_->SetDateWindowFPT(DateWindow {});
+
+    // rows come back in query order, the header's sort also runs AccumulateSubtotal again
+    auto* header { ui->tableView->horizontalHeader() };
+    ui->tableView->sortByColumn(header->sortIndicatorSection(), header->sortIndicatorOrder());
+}
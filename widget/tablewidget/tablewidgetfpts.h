@@ -39,6 +39,19 @@ public:
     QPointer<TableModel> Model() const override { return model_; }
     QPointer<QTableView> View() const override;
 
+    // Finance Product Task, the window a new ledger opens with
+    static DateWindow CurrentQuarterFPT();
+    // Finance Product Task, shows the date window bar on the window the model was built with
+    void ShowDateWindowFPT();
+
+private slots:
+    void on_chkBoxWindow_toggled(bool checked);
+    void RDateWindowChanged();
+    void ROpeningBalance(double opening_balance);
+
+private:
+    void UpdateDateWindow();
+
 private:
     Ui::TableWidgetFPTS* ui;
     TableModel* model_ {};